@@ -0,0 +1,100 @@
+#ifndef GROMER_BENCH_H
+#define GROMER_BENCH_H
+
+/**
+ * @file   bench.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 12:20:31 2026
+ *
+ * @brief  Benchmark helpers.
+ *
+ * Each benchmark program runs its cases once per configuration and
+ * prints wall clock time with time per item:
+ *
+ *     t0 = bench_now_ns();
+ *     ...
+ *     bench_report( "case", bench_now_ns() - t0, count );
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "gromer.h"
+
+
+/** Result sink, which keeps computed values alive. */
+static volatile uint64_t bench_sink;
+
+
+/**
+ * Monotonic time.
+ *
+ * @return Time in nanoseconds.
+ */
+static inline uint64_t bench_now_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * Print case result.
+ *
+ * @param name  Case name.
+ * @param ns    Elapsed time (ns).
+ * @param count Item count (for time per item).
+ */
+static inline void bench_report( const char* name, uint64_t ns, gr_size_t count )
+{
+    printf( "%-36s %10.3f ms %10.2f ns/item\n",
+            name,
+            ns / 1e6,
+            count ? (double)ns / count : 0.0 );
+}
+
+
+/**
+ * Item count from first program argument.
+ *
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @param def  Default count.
+ *
+ * @return Item count.
+ */
+static inline gr_size_t bench_count( int argc, char** argv, gr_size_t def )
+{
+    if ( argc > 1 )
+        return strtoull( argv[ 1 ], NULL, 0 );
+    else
+        return def;
+}
+
+
+/**
+ * Pseudo random number (xorshift).
+ *
+ * @param state Generator state (non-zero).
+ *
+ * @return Next number.
+ */
+static inline uint64_t bench_rand( uint64_t* state )
+{
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+
+    return x;
+}
+
+
+#endif
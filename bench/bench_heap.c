@@ -0,0 +1,77 @@
+/**
+ * @file   bench_heap.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 12:34:07 2026
+ *
+ * @brief  Heap operations by heap arity.
+ *
+ * The program is built once per GR_HEAP_ARITY (see Makefile), since
+ * arity is a compile time setting of the library.
+ *
+ */
+
+#include "bench.h"
+
+
+static int heap_compare( const gr_d a, const gr_d b )
+{
+    return ( (uintptr_t)a > (uintptr_t)b ) - ( (uintptr_t)a < (uintptr_t)b );
+}
+
+
+static gr_size_t heap_key( const gr_d item )
+{
+    return (uintptr_t)item;
+}
+
+
+int main( int argc, char** argv )
+{
+    gr_size_t count = bench_count( argc, argv, 1024 * 1024 );
+    uint64_t  seed = 88172645463325252ULL;
+    gr_t      keys = gr_new_sized( count );
+    gr_t      gr = gr_new_sized( count );
+    uint64_t  sum;
+    uint64_t  t0;
+
+    for ( gr_size_t i = 0; i < count; i++ )
+        gr_push( &keys, (gr_d)( bench_rand( &seed ) >> 1 ) );
+
+    printf( "items: %llu, arity: %d\n", (unsigned long long)count, GR_HEAP_ARITY );
+
+    t0 = bench_now_ns();
+    for ( gr_size_t i = 0; i < count; i++ )
+        gr_heap_push( &gr, gr_nth( keys, i ), heap_compare );
+    bench_report( "gr_heap_push", bench_now_ns() - t0, count );
+
+    sum = 0;
+    t0 = bench_now_ns();
+    while ( !gr_is_empty( gr ) )
+        sum += (uintptr_t)gr_heap_pop( &gr, heap_compare );
+    bench_report( "gr_heap_pop", bench_now_ns() - t0, count );
+    bench_sink = sum;
+
+    gr_destroy( &gr );
+    gr = gr_duplicate( keys );
+    t0 = bench_now_ns();
+    gr_heapify( &gr, heap_compare );
+    bench_report( "gr_heapify", bench_now_ns() - t0, count );
+
+    gr_destroy( &gr );
+    gr = gr_duplicate( keys );
+    t0 = bench_now_ns();
+    gr_heapify_by( &gr, heap_key );
+    bench_report( "gr_heapify_by", bench_now_ns() - t0, count );
+
+    sum = 0;
+    t0 = bench_now_ns();
+    while ( !gr_is_empty( gr ) )
+        sum += (uintptr_t)gr_heap_pop_by( &gr, heap_key );
+    bench_report( "gr_heap_pop_by", bench_now_ns() - t0, count );
+    bench_sink = sum;
+
+    gr_destroy( &gr );
+    gr_destroy( &keys );
+
+    return 0;
+}
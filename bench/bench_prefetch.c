@@ -0,0 +1,93 @@
+/**
+ * @file   bench_prefetch.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 12:20:31 2026
+ *
+ * @brief  Pointer chasing with and without prefetch, and field gather.
+ *
+ * Items reference objects in random order, so each dereference is a
+ * likely cache miss when the object count exceeds the caches.
+ *
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "bench.h"
+
+
+/** Referenced object (one cache line). */
+typedef struct
+{
+    uint64_t key;
+    uint64_t pad[ 7 ];
+} obj_t;
+
+
+int main( int argc, char** argv )
+{
+    gr_size_t count = bench_count( argc, argv, 4 * 1024 * 1024 );
+    obj_t*    objs = malloc( count * sizeof( obj_t ) );
+    uint64_t* keys = malloc( count * sizeof( uint64_t ) );
+    uint64_t  seed = 88172645463325252ULL;
+    gr_t      gr = gr_new_sized( count );
+    gr_d*     data;
+    obj_t*    obj;
+    uint64_t  sum;
+    uint64_t  t0;
+    char      name[ 64 ];
+
+    for ( gr_size_t i = 0; i < count; i++ ) {
+        objs[ i ].key = i;
+        gr_push( &gr, &objs[ i ] );
+    }
+
+    /* Shuffle references. */
+    data = gr_data( gr );
+    for ( gr_size_t i = count - 1; i > 0; i-- ) {
+        gr_size_t j = bench_rand( &seed ) % ( i + 1 );
+        gr_d      t = data[ i ];
+        data[ i ] = data[ j ];
+        data[ j ] = t;
+    }
+
+    /* Fault destination pages before timing. */
+    memset( keys, 0, count * sizeof( uint64_t ) );
+
+    printf( "items: %llu\n", (unsigned long long)count );
+
+    sum = 0;
+    t0 = bench_now_ns();
+    gr_each( gr, obj, obj_t* )
+    {
+        sum += obj->key;
+    }
+    bench_report( "gr_each", bench_now_ns() - t0, count );
+    bench_sink = sum;
+
+    for ( gr_size_t dist = 4; dist <= 32; dist *= 2 ) {
+        sum = 0;
+        t0 = bench_now_ns();
+        gr_each_prefetch( gr, obj, obj_t*, dist )
+        {
+            sum += obj->key;
+        }
+        snprintf( name, sizeof( name ), "gr_each_prefetch (dist %llu)", (unsigned long long)dist );
+        bench_report( name, bench_now_ns() - t0, count );
+        bench_sink = sum;
+    }
+
+    sum = 0;
+    t0 = bench_now_ns();
+    gr_gather( gr, 0, count, offsetof( obj_t, key ), sizeof( uint64_t ), keys );
+    for ( gr_size_t i = 0; i < count; i++ )
+        sum += keys[ i ];
+    bench_report( "gr_gather", bench_now_ns() - t0, count );
+    bench_sink = sum;
+
+    gr_destroy( &gr );
+    free( keys );
+    free( objs );
+
+    return 0;
+}
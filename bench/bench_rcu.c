@@ -0,0 +1,127 @@
+/**
+ * @file   bench_rcu.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 12:52:16 2026
+ *
+ * @brief  RCU Gromer read scaling vs reader-writer lock.
+ *
+ * Each reader thread does "count" short read sections (enter, read
+ * one item, leave). Time per item is per read section over all
+ * threads, i.e. it drops when reads scale.
+ *
+ */
+
+#include <pthread.h>
+
+#include "bench.h"
+#include "gromer_rcu.h"
+
+
+/** Items in read Gromer. */
+#define RCU_ITEMS 1024
+
+
+/** Reader context. */
+typedef struct
+{
+    gc_t              gc;
+    pthread_rwlock_t* lock;
+    gr_t              gr;
+    gr_pos_t          id;
+    gr_size_t         count;
+    uint64_t          sum;
+} reader_t;
+
+
+static void* rcu_reader( void* arg )
+{
+    reader_t* rd = (reader_t*)arg;
+    uint64_t  sum = 0;
+
+    for ( gr_size_t i = 0; i < rd->count; i++ ) {
+        gr_t gr = gc_enter( rd->gc, rd->id );
+        sum += (uintptr_t)gc_nth( gr, i % RCU_ITEMS );
+        gc_leave( rd->gc, rd->id );
+    }
+    rd->sum = sum;
+
+    return NULL;
+}
+
+
+static void* lock_reader( void* arg )
+{
+    reader_t* rd = (reader_t*)arg;
+    uint64_t  sum = 0;
+
+    for ( gr_size_t i = 0; i < rd->count; i++ ) {
+        pthread_rwlock_rdlock( rd->lock );
+        sum += (uintptr_t)gr_nth( rd->gr, i % RCU_ITEMS );
+        pthread_rwlock_unlock( rd->lock );
+    }
+    rd->sum = sum;
+
+    return NULL;
+}
+
+
+static void run( const char* name, void* ( *fn )( void* ), reader_t* proto, int threads )
+{
+    pthread_t th[ 16 ];
+    reader_t  rd[ 16 ];
+    uint64_t  t0;
+    char      label[ 64 ];
+
+    for ( int i = 0; i < threads; i++ ) {
+        rd[ i ] = *proto;
+        if ( proto->gc )
+            rd[ i ].id = gc_register( proto->gc );
+    }
+
+    t0 = bench_now_ns();
+    for ( int i = 0; i < threads; i++ )
+        pthread_create( &th[ i ], NULL, fn, &rd[ i ] );
+    for ( int i = 0; i < threads; i++ ) {
+        pthread_join( th[ i ], NULL );
+        bench_sink += rd[ i ].sum;
+    }
+    snprintf( label, sizeof( label ), "%s (%d threads)", name, threads );
+    bench_report( label, bench_now_ns() - t0, proto->count * threads );
+
+    if ( proto->gc ) {
+        for ( int i = 0; i < threads; i++ )
+            gc_unregister( proto->gc, rd[ i ].id );
+    }
+}
+
+
+int main( int argc, char** argv )
+{
+    gr_size_t        count = bench_count( argc, argv, 1024 * 1024 );
+    gc_t             gc = gc_new_sized( RCU_ITEMS );
+    gr_t             gr = gr_new_sized( RCU_ITEMS );
+    pthread_rwlock_t lock = PTHREAD_RWLOCK_INITIALIZER;
+    reader_t         proto = { 0 };
+
+    for ( uintptr_t i = 0; i < RCU_ITEMS; i++ ) {
+        gc_push( gc, (gr_d)i );
+        gr_push( &gr, (gr_d)i );
+    }
+
+    printf( "read sections per thread: %llu\n", (unsigned long long)count );
+
+    proto.count = count;
+    for ( int threads = 1; threads <= 8; threads *= 2 ) {
+        proto.gc = gc;
+        run( "gc_enter/gc_leave", rcu_reader, &proto, threads );
+        proto.gc = NULL;
+        proto.lock = &lock;
+        proto.gr = gr;
+        run( "pthread_rwlock", lock_reader, &proto, threads );
+    }
+
+    gr_destroy( &gr );
+    gc_destroy( &gc );
+
+    return 0;
+}
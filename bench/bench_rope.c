@@ -0,0 +1,56 @@
+/**
+ * @file   bench_rope.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 13:15:28 2026
+ *
+ * @brief  Rope Gromer vs flat Gromer random insert.
+ *
+ * Random inserts are done to containers of sizes from 16 to 1M items,
+ * in order to find the size where the rope becomes faster than the
+ * flat Gromer (memmove of the tail). Argument limits the insert count
+ * per size.
+ *
+ */
+
+#include "bench.h"
+#include "gromer_rope.h"
+
+
+int main( int argc, char** argv )
+{
+    gr_size_t limit = bench_count( argc, argv, 4 * 1024 );
+    uint64_t  seed = 88172645463325252ULL;
+    uint64_t  t0;
+    char      label[ 64 ];
+
+    printf( "inserts per size: at most %llu\n", (unsigned long long)limit );
+
+    for ( gr_size_t size = 16; size <= 1024 * 1024; size *= 4 ) {
+        /* Size grows at most by a quarter. */
+        gr_size_t inserts = size / 4 < limit ? size / 4 : limit;
+        gr_t      gr = gr_new_sized( size + inserts );
+        gk_t      gk = gk_new();
+
+        for ( uintptr_t i = 0; i < size; i++ ) {
+            gr_push( &gr, (gr_d)i );
+            gk_push( gk, (gr_d)i );
+        }
+
+        t0 = bench_now_ns();
+        for ( gr_size_t i = 0; i < inserts; i++ )
+            gr_insert_at( &gr, bench_rand( &seed ) % ( gr_used( gr ) + 1 ), (gr_d)i );
+        snprintf( label, sizeof( label ), "gr_insert_at (size %llu)", (unsigned long long)size );
+        bench_report( label, bench_now_ns() - t0, inserts );
+
+        t0 = bench_now_ns();
+        for ( gr_size_t i = 0; i < inserts; i++ )
+            gk_insert_at( gk, bench_rand( &seed ) % ( gk_used( gk ) + 1 ), (gr_d)i );
+        snprintf( label, sizeof( label ), "gk_insert_at (size %llu)", (unsigned long long)size );
+        bench_report( label, bench_now_ns() - t0, inserts );
+
+        gk_destroy( &gk );
+        gr_destroy( &gr );
+    }
+
+    return 0;
+}
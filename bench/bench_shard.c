@@ -0,0 +1,107 @@
+/**
+ * @file   bench_shard.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 13:03:44 2026
+ *
+ * @brief  Sharded Gromer push scaling vs Gromer behind mutex.
+ *
+ * Each thread pushes "count" items. Time per item is over all
+ * threads, i.e. it drops when pushes scale.
+ *
+ */
+
+#include <pthread.h>
+
+#include "bench.h"
+#include "gromer_shard.h"
+
+
+/** Pusher context. */
+typedef struct
+{
+    gs_t             gs;
+    pthread_mutex_t* lock;
+    gr_p             gp;
+    gr_size_t        idx;
+    gr_size_t        count;
+} pusher_t;
+
+
+static void* shard_pusher( void* arg )
+{
+    pusher_t* pu = (pusher_t*)arg;
+
+    for ( uintptr_t i = 1; i <= pu->count; i++ )
+        gs_push( pu->gs, pu->idx, (gr_d)i );
+
+    return NULL;
+}
+
+
+static void* lock_pusher( void* arg )
+{
+    pusher_t* pu = (pusher_t*)arg;
+
+    for ( uintptr_t i = 1; i <= pu->count; i++ ) {
+        pthread_mutex_lock( pu->lock );
+        gr_push( pu->gp, (gr_d)i );
+        pthread_mutex_unlock( pu->lock );
+    }
+
+    return NULL;
+}
+
+
+static void run( const char* name, void* ( *fn )( void* ), pusher_t* proto, int threads )
+{
+    pthread_t th[ 16 ];
+    pusher_t  pu[ 16 ];
+    uint64_t  t0;
+    char      label[ 64 ];
+
+    for ( int i = 0; i < threads; i++ ) {
+        pu[ i ] = *proto;
+        pu[ i ].idx = i;
+    }
+
+    t0 = bench_now_ns();
+    for ( int i = 0; i < threads; i++ )
+        pthread_create( &th[ i ], NULL, fn, &pu[ i ] );
+    for ( int i = 0; i < threads; i++ )
+        pthread_join( th[ i ], NULL );
+    snprintf( label, sizeof( label ), "%s (%d threads)", name, threads );
+    bench_report( label, bench_now_ns() - t0, proto->count * threads );
+}
+
+
+int main( int argc, char** argv )
+{
+    gr_size_t       count = bench_count( argc, argv, 1024 * 1024 );
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    pusher_t        proto = { 0 };
+    gr_t            gr;
+    gr_t            all;
+    uint64_t        t0;
+
+    printf( "pushes per thread: %llu\n", (unsigned long long)count );
+
+    proto.count = count;
+    for ( int threads = 1; threads <= 8; threads *= 2 ) {
+        proto.gs = gs_new( threads );
+        run( "gs_push", shard_pusher, &proto, threads );
+
+        t0 = bench_now_ns();
+        all = gs_merge( proto.gs );
+        bench_report( "gs_merge", bench_now_ns() - t0, gr_used( all ) );
+        gr_destroy( &all );
+        gs_destroy( &proto.gs );
+
+        gr = gr_new();
+        proto.lock = &lock;
+        proto.gp = &gr;
+        run( "gr_push with mutex", lock_pusher, &proto, threads );
+        gr_destroy( &gr );
+    }
+
+    return 0;
+}
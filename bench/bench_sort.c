@@ -0,0 +1,85 @@
+/**
+ * @file   bench_sort.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 12:41:52 2026
+ *
+ * @brief  Typed sort (GR_DEFINE_ALGOS) vs compare function sort.
+ *
+ */
+
+#include <string.h>
+
+#include "bench.h"
+#include "gromer_algo.h"
+
+
+GR_DEFINE_ALGOS( num, uintptr_t, a < b )
+GR_DEFINE_ALGOS( str, char*, strcmp( a, b ) < 0 )
+
+
+/* gr_sort() compares references to items. */
+
+static int num_compare( const gr_d a, const gr_d b )
+{
+    uintptr_t x = *(uintptr_t*)a;
+    uintptr_t y = *(uintptr_t*)b;
+
+    return ( x > y ) - ( x < y );
+}
+
+
+static int str_compare( const gr_d a, const gr_d b )
+{
+    return strcmp( *(char**)a, *(char**)b );
+}
+
+
+int main( int argc, char** argv )
+{
+    gr_size_t count = bench_count( argc, argv, 1024 * 1024 );
+    uint64_t  seed = 88172645463325252ULL;
+    char*     strs = malloc( count * 16 );
+    gr_t      nums = gr_new_sized( count );
+    gr_t      texts = gr_new_sized( count );
+    gr_t      gr;
+    uint64_t  t0;
+
+    for ( gr_size_t i = 0; i < count; i++ ) {
+        uint64_t r = bench_rand( &seed );
+        gr_push( &nums, (gr_d)( r >> 1 ) );
+        snprintf( &strs[ i * 16 ], 16, "%015llu", (unsigned long long)( r % 1000000000000000ULL ) );
+        gr_push( &texts, &strs[ i * 16 ] );
+    }
+
+    printf( "items: %llu\n", (unsigned long long)count );
+
+    gr = gr_duplicate( nums );
+    t0 = bench_now_ns();
+    gr_sort( &gr, num_compare );
+    bench_report( "integer gr_sort", bench_now_ns() - t0, count );
+    gr_destroy( &gr );
+
+    gr = gr_duplicate( nums );
+    t0 = bench_now_ns();
+    num_sort( &gr );
+    bench_report( "integer typed sort", bench_now_ns() - t0, count );
+    gr_destroy( &gr );
+
+    gr = gr_duplicate( texts );
+    t0 = bench_now_ns();
+    gr_sort( &gr, str_compare );
+    bench_report( "string gr_sort", bench_now_ns() - t0, count );
+    gr_destroy( &gr );
+
+    gr = gr_duplicate( texts );
+    t0 = bench_now_ns();
+    str_sort( &gr );
+    bench_report( "string typed sort", bench_now_ns() - t0, count );
+    gr_destroy( &gr );
+
+    gr_destroy( &texts );
+    gr_destroy( &nums );
+    free( strs );
+
+    return 0;
+}
@@ -8,9 +8,12 @@
  */
 
 #define _POSIX_C_SOURCE 200112L
+#define _DEFAULT_SOURCE
 
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <sys/mman.h>
 
 #include "gromer.h"
 
@@ -21,14 +24,49 @@
 #define gr_true  1
 #define gr_false 0
 
-#define gr_smsk            0xFFFFFFFFFFFFFFFEL
+#define gr_smsk            0x0000FFFFFFFFFFFEULL
+#define gr_lmsk            0x0000000000000001ULL
+#define gr_cmsk            0x0FFF000000000000ULL
+#define gr_cone            0x0001000000000000ULL
+#define gr_umsk            0x1000000000000000ULL
+#define gr_xmsk            0x2000000000000000ULL
+#define gr_fmsk            0x4000000000000000ULL
+#define gr_pmsk            0x8000000000000000ULL
 
 #define gr_unit_size       ( sizeof( gr_d ) )
 #define gr_byte_size( gr ) ( gr_unit_size * gm_size( gr) )
 #define gr_used_size( gr ) ( gr_unit_size * gr->used )
 
 #define gr_snor(size)      (((size) & 0x1L) ? (size) + 1 : (size))
-#define gr_local( gr )     ( (gr)->size & 0x1L )
+#define gr_local( gr )     ( (gr)->size & gr_lmsk )
+#define gr_shared( gr )    ( (gr)->size & gr_cmsk )
+#define gr_uninit( gr )    ( GR_UNINIT || ( (gr)->size & gr_umsk ) )
+#define gr_external( gr )  ( (gr)->size & gr_xmsk )
+#define gr_frozen( gr )    ( (gr)->size & gr_fmsk )
+#define gr_mapped( gr )    ( (gr)->size & gr_pmsk )
+#define gr_mutable( gr )   ( !( (gr)->size & ( gr_cmsk | gr_fmsk ) ) )
+#define gr_writable( gr )  ( gr_mutable( gr ) || ( gr_assert( gr_mutable( gr ) ), 0 ) )
+#define gr_ext( gr )       ( (gr_ext_s*)( gr ) - 1 )
+
+#define gr_page_bytes( bytes ) \
+    ( ( ( bytes ) + gr_alloc_pages( 0, NULL ) - 1 ) & ~( gr_alloc_pages( 0, NULL ) - 1 ) )
+
+#define gr_release_auto( gr ) \
+    ( GR_RELEASE_SIZE && gr_byte_size( gr ) >= GR_RELEASE_SIZE && !gr_local( gr ) && !gr_external( gr ) )
+#define gr_release_idle( gr, used ) \
+    ( gr_release_auto( gr ) && 4 * ( used ) <= gm_size( gr ) )
+
+#define gr_reserve( bytes, uninit ) \
+    ( ( uninit ) ? gr_malloc_uninit( bytes ) : gr_malloc( bytes ) )
+
+#define gr_observe_begin()                                              \
+    gr_observe_fn_p gr_obs = __atomic_load_n( &gr_observer, __ATOMIC_RELAXED ); \
+    uint64_t gr_obs_t0 = gr_obs ? gr_now_ns() : 0
+#define gr_observe_end( kind, bytes, moved )                            \
+    do {                                                                \
+        if ( gr_obs )                                                   \
+            gr_obs( kind, bytes, moved, gr_now_ns() - gr_obs_t0 );      \
+    } while ( 0 )
 
 #define gm_any( gr ) (     ( gr )->used > 0 )
 #define gm_empty( gr )     ( ( gr )->used == 0 )
@@ -48,15 +86,56 @@
 /* clang-format on */
 
 
+/**
+ * Item ordering, either by compare or by key function.
+ */
+typedef struct
+{
+    gr_compare_fn_p compare; /**< Compare function (or NULL). */
+    gr_key_fn_p     key;     /**< Key function (used if compare is NULL). */
+    int             rev;     /**< Reversed order. */
+} gr_order_t;
+
+
 static void gr_init( gr_t gr, gr_size_t size, int local );
 static gr_size_t gr_align_size( gr_size_t new_size );
 static gr_size_t gr_incr_size( gr_t gr );
 static gr_size_t gr_legal_size( gr_size_t size );
 static gr_size_t gr_norm_idx( gr_t gr, gr_pos_t idx );
-static void gr_resize_to( gr_p gp, gr_size_t new_size );
+static int gr_resize_to( gr_p gp, gr_size_t new_size );
+static gr_size_t gr_release_tail( gr_t gr, gr_size_t from, int zero );
+static int gr_prepare( gr_p gp, gr_size_t new_used );
+static int gr_unref( gr_t gr );
+static uint64_t gr_now_ns( void );
+static int gr_less( const gr_order_t* ord, gr_d a, gr_d b );
+static gr_size_t gr_sift_up( gr_t gr, gr_size_t idx, const gr_order_t* ord );
+static void gr_sift_down( gr_t gr, gr_size_t idx, gr_size_t used, const gr_order_t* ord );
+static gr_d gr_heap_take( gr_t gr, const gr_order_t* ord );
+static void gr_heapify_order( gr_t gr, const gr_order_t* ord );
+static void gr_range_heap_sort( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord );
+static void gr_insertion_sort( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord );
+static gr_size_t gr_partition( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord );
+static void gr_intro_sort( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord );
+static void gr_intro_select( gr_d* data, gr_size_t lo, gr_size_t hi, gr_size_t nth, const gr_order_t* ord );
+static gr_size_t gr_depth_limit( gr_size_t count );
+static void gr_partial_sort_order( gr_t gr, gr_size_t k, const gr_order_t* ord );
+static gr_d gr_topk_push_order( gr_p gp, gr_size_t k, gr_d item, const gr_order_t* ord );
+static void gr_topk_sort_order( gr_t gr, const gr_order_t* ord );
+static int gr_merge_less( gr_t*           grs,
+                          gr_size_t*      pos,
+                          const gr_size_t* hi,
+                          gr_compare_fn_p compare,
+                          gr_size_t       a,
+                          gr_size_t       b );
+static gr_size_t gv_norm_idx( gv_t gv, gr_pos_t idx );
+static void gv_resize_to( gv_p gp, gr_size_t new_size );
 void gr_void_assert( void );
 
 
+/** Allocation observer. */
+static gr_observe_fn_p gr_observer = NULL;
+
+
 
 /* ------------------------------------------------------------
  * Create and destroy:
@@ -74,8 +153,25 @@ gr_t gr_new_sized( gr_size_t size )
     gr_t gr;
 
     size = gr_legal_size( size );
-    gr = (gr_t)gr_malloc( gr_struct_size( size ) );
+    gr_observe_begin();
+    gr = (gr_t)gr_reserve( gr_struct_size( size ), GR_UNINIT );
+    gr_observe_end( GR_ALLOC_NEW, gr_struct_size( size ), 0 );
+    gr_init( gr, size, 0 );
+
+    return gr;
+}
+
+
+gr_t gr_new_uninit( gr_size_t size )
+{
+    gr_t gr;
+
+    size = gr_legal_size( size );
+    gr_observe_begin();
+    gr = (gr_t)gr_malloc_uninit( gr_struct_size( size ) );
+    gr_observe_end( GR_ALLOC_NEW, gr_struct_size( size ), 0 );
     gr_init( gr, size, 0 );
+    gr_set_uninit( gr, 1 );
 
     return gr;
 }
@@ -108,7 +204,8 @@ gr_t gr_use( gr_d mem, gr_size_t size )
     gr_t gr;
     gr = (gr_t)mem;
     gr_init( gr, gr_size, 1 );
-    memset( gr->data, 0, size - sizeof( gr_s ) );
+    if ( !GR_UNINIT )
+        memset( gr->data, 0, size - sizeof( gr_s ) );
 
     return gr;
 }
@@ -119,7 +216,11 @@ void gr_destroy( gr_p gp )
     if ( *gp == NULL )
         return;
 
-    if ( !gr_local( *gp ) )
+    if ( gr_external( *gp ) )
+        gr_ext( *gp )->resize( gp, 0, gr_ext( *gp )->state );
+    else if ( gr_mapped( *gp ) )
+        munmap( *gp, gr_page_bytes( gr_byte_size( *gp ) + sizeof( gr_s ) ) );
+    else if ( !gr_local( *gp ) && gr_unref( *gp ) )
         gr_free( *gp );
 
     *gp = NULL;
@@ -139,16 +240,21 @@ void gr_push( gr_p gp, gr_d item )
 {
     gr_size_t new_used = gm_used( *gp ) + 1;
 
-    if ( new_used > gm_size( *gp ) )
-        gr_resize_to( gp, gr_incr_size( *gp ) );
+    if ( !gr_prepare( gp, new_used ) )
+        return;
 
     gm_nth( *gp, gm_used( *gp ) ) = item;
     gm_used( *gp ) = new_used;
 }
 
 
-gr_d gr_pop( gr_t gr )
+gr_d gr_pop( gr_p gp )
 {
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return NULL;
+
     if ( gm_any( gr ) ) {
         gr_d ret = gm_last( gr );
         gm_used( gr )--;
@@ -161,19 +267,96 @@ gr_d gr_pop( gr_t gr )
 }
 
 
-gr_size_t gr_drop( gr_t gr, gr_size_t count )
+gr_size_t gr_drop( gr_p gp, gr_size_t count )
 {
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return 0;
+
     if ( gm_used( gr ) >= count ) {
         gm_used( gr ) -= count;
     } else {
         count = gm_used( gr );
-        gr_reset( gr );
+        gr_reset( gp );
     }
 
     return count;
 }
 
 
+gr_size_t gr_pop_n( gr_p gp, gr_d* buf, gr_size_t count )
+{
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return 0;
+
+    if ( count > gm_used( gr ) )
+        count = gm_used( gr );
+
+    gm_used( gr ) -= count;
+    memcpy( buf, &gm_end( gr ), count * gr_unit_size );
+    if ( gm_empty( gr ) )
+        gm_first( gr ) = NULL;
+
+    return count;
+}
+
+
+gr_size_t gr_pop_into( gr_p gp, gr_p dst, gr_size_t count )
+{
+    gr_t      gr = gr_unshare( gp );
+    gr_size_t need;
+
+    if ( !gr_writable( gr ) )
+        return 0;
+
+    if ( count > gm_used( gr ) )
+        count = gm_used( gr );
+
+    if ( *dst == NULL )
+        *dst = gr_new_sized( count );
+
+    need = gm_used( *dst ) + count;
+    if ( need > gm_size( *dst ) )
+        gr_resize( dst, need );
+    else
+        gr_unshare( dst );
+
+    if ( !gr_writable( *dst ) || need > gm_size( *dst ) )
+        return 0;
+
+    count = gr_pop_n( gp, &gm_end( *dst ), count );
+    gm_used( *dst ) += count;
+
+    return count;
+}
+
+
+gr_t gr_drain( gr_p gp )
+{
+    gr_t ret;
+
+    if ( gr_local( *gp ) ) {
+        ret = gr_duplicate( *gp );
+        gr_reset( gp );
+        return ret;
+    }
+
+    ret = *gp;
+
+    /* Storage content is not needed, hence skip zero-fill in
+     * uninitialized mode. */
+    if ( ret->size & gr_umsk )
+        *gp = gr_new_uninit( gm_size( ret ) );
+    else
+        *gp = gr_new_sized( gm_size( ret ) );
+
+    return ret;
+}
+
+
 void gr_add( gr_p gp, gr_d item )
 {
     if ( *gp == NULL )
@@ -187,7 +370,7 @@ gr_d gr_remove( gr_p gp )
     gr_d ret;
 
     if ( *gp ) {
-        ret = gr_pop( *gp );
+        ret = gr_pop( gp );
         if ( gm_empty( *gp ) )
             gr_destroy( gp );
         return ret;
@@ -197,16 +380,65 @@ gr_d gr_remove( gr_p gp )
 }
 
 
-void gr_reset( gr_t gr )
+void gr_reset( gr_p gp )
+{
+    gr_t      gr = gr_unshare( gp );
+    gr_size_t used;
+
+    if ( !gr_writable( gr ) )
+        return;
+    used = gm_used( gr );
+    gm_used( gr ) = 0;
+
+    /* Keep twice the last usage for refill. */
+    if ( gr_release_idle( gr, used ) )
+        gr_release_tail( gr, 2 * used, !gr_uninit( gr ) );
+}
+
+
+gr_size_t gr_reset_release( gr_p gp )
 {
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return 0;
     gm_used( gr ) = 0;
+
+    if ( gr_release_auto( gr ) )
+        return gr_release_tail( gr, 0, !gr_uninit( gr ) );
+    else
+        return 0;
 }
 
 
-void gr_clear( gr_t gr )
+void gr_clear( gr_p gp )
 {
+    gr_t      gr = gr_unshare( gp );
+    gr_size_t used;
+
+    if ( !gr_writable( gr ) )
+        return;
+    used = gm_used( gr );
+    memset( gr->data, 0, used * gr_unit_size );
     gm_used( gr ) = 0;
-    memset( gr->data, 0, ( gr->size * gr_unit_size ) );
+    gm_first( gr ) = NULL;
+
+    if ( gr_release_idle( gr, used ) )
+        gr_release_tail( gr, 2 * used, !gr_uninit( gr ) );
+}
+
+
+gr_size_t gr_release( gr_p gp )
+{
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return 0;
+
+    if ( gr_local( gr ) )
+        return 0;
+
+    return gr_release_tail( gr, gm_used( gr ), !gr_uninit( gr ) );
 }
 
 
@@ -214,20 +446,98 @@ gr_t gr_duplicate( gr_t gr )
 {
     gr_t dup;
 
-    dup = gr_new_sized( gm_size( gr ) );
-    *dup = *gr;
+    if ( gr_uninit( gr ) )
+        dup = gr_new_uninit( gm_size( gr ) );
+    else
+        dup = gr_new_sized( gm_size( gr ) );
+    gm_used( dup ) = gm_used( gr );
     memcpy( gm_data( dup ), gm_data( gr ), gr_used_size( gr ) );
 
     return dup;
 }
 
 
-gr_d gr_swap( gr_t gr, gr_pos_t pos, gr_d item )
+gr_t gr_duplicate_cow( gr_t gr )
 {
-    if ( gr == NULL )
+    if ( gr_local( gr ) || gr_frozen( gr ) )
+        return gr_duplicate( gr );
+
+    gr_size_t size = __atomic_load_n( &gr->size, __ATOMIC_RELAXED );
+
+    do {
+        /* Share count saturated, fallback to real copy. */
+        if ( ( size & gr_cmsk ) == gr_cmsk )
+            return gr_duplicate( gr );
+    } while ( !__atomic_compare_exchange_n(
+        &gr->size, &size, size + gr_cone, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED ) );
+
+    return gr;
+}
+
+
+gr_t gr_unshare( gr_p gp )
+{
+    if ( gr_shared( *gp ) )
+        gr_resize_to( gp, gm_size( *gp ) );
+
+    return *gp;
+}
+
+
+int gr_freeze( gr_p gp, int protect )
+{
+    gr_size_t size;
+    gr_size_t bytes;
+    gr_t      gr;
+
+    if ( gr_frozen( *gp ) )
+        return gr_mapped( *gp ) ? 1 : 0;
+
+    size = gm_used( *gp );
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+    size = gr_snor( size );
+
+    if ( protect && !gr_external( *gp ) ) {
+
+        /* Rebuild to private anonymous pages. Failure falls back to
+         * unprotected freeze. External storage is kept, since it is
+         * released only by its owner. */
+        bytes = gr_page_bytes( gr_struct_size( size ) );
+        gr = (gr_t)mmap( NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if ( gr != MAP_FAILED ) {
+            gm_used( gr ) = gm_used( *gp );
+            memcpy( gm_data( gr ), gm_data( *gp ), gr_unit_size * gm_used( gr ) );
+            gr->size = size | ( ( *gp )->size & gr_umsk ) | gr_fmsk | gr_pmsk;
+            if ( mprotect( gr, bytes, PROT_READ ) == 0 ) {
+                gr_destroy( gp );
+                *gp = gr;
+                return 1;
+            }
+            munmap( gr, bytes ); // GCOV_EXCL_LINE
+        }
+    }
+
+    if ( size != gm_size( *gp ) || gr_shared( *gp ) )
+        gr_resize_to( gp, size );
+    ( *gp )->size |= gr_fmsk;
+
+    return 0;
+}
+
+
+gr_d gr_swap( gr_p gp, gr_pos_t pos, gr_d item )
+{
+    gr_t gr;
+
+    if ( *gp == NULL )
         return NULL;
 
-    if ( gm_empty( gr ) )
+    if ( gm_empty( *gp ) )
+        return NULL;
+
+    gr = gr_unshare( gp );
+    if ( !gr_writable( gr ) )
         return NULL;
 
     gr_size_t norm;
@@ -245,8 +555,8 @@ void gr_insert_at( gr_p gp, gr_pos_t pos, gr_d item )
 {
     gr_size_t new_used = gm_used( *gp ) + 1;
 
-    if ( new_used > gm_size( *gp ) )
-        gr_resize_to( gp, gr_incr_size( *gp ) );
+    if ( !gr_prepare( gp, new_used ) )
+        return;
 
     gr_size_t norm;
     if ( pos == (gr_pos_t)gm_used( *gp ) )
@@ -267,8 +577,13 @@ void gr_insert_at( gr_p gp, gr_pos_t pos, gr_d item )
 }
 
 
-int gr_insert_if( gr_t gr, gr_pos_t pos, gr_d item )
+int gr_insert_if( gr_p gp, gr_pos_t pos, gr_d item )
 {
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return gr_false;
+
     gr_size_t new_used = gm_used( gr ) + 1;
 
     if ( new_used > gm_size( gr ) )
@@ -295,9 +610,15 @@ int gr_insert_if( gr_t gr, gr_pos_t pos, gr_d item )
 }
 
 
-gr_d gr_delete_at( gr_t gr, gr_pos_t pos )
+gr_d gr_delete_at( gr_p gp, gr_pos_t pos )
 {
-    if ( gm_empty( gr ) )
+    gr_t gr;
+
+    if ( gm_empty( *gp ) )
+        return NULL;
+
+    gr = gr_unshare( gp );
+    if ( !gr_writable( gr ) )
         return NULL;
 
     gr_d      ret;
@@ -323,21 +644,29 @@ gr_d gr_delete_at( gr_t gr, gr_pos_t pos )
 }
 
 
-void gr_sort( gr_t gr, gr_compare_fn_p compare )
+void gr_sort( gr_p gp, gr_compare_fn_p compare )
 {
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return;
     qsort( gr->data, gr->used, gr_unit_size, (int ( * )( const void*, const void* ))compare );
 }
 
 
-gr_d gr_alloc( gr_t gr, gr_size_t bytes )
+gr_d gr_alloc( gr_p gp, gr_size_t bytes )
 {
+    gr_t      gr = gr_unshare( gp );
     gr_d      ret;
     gr_size_t units;
 
+    if ( !gr_writable( gr ) )
+        return NULL;
+
     ret = NULL;
     units = ( bytes >> 3 ) + ( ( bytes & 0x07ULL ) != 0 );
 
-    if ( gr->size >= ( gr->used + units ) ) {
+    if ( gm_size( gr ) >= ( gr->used + units ) ) {
         ret = &gr->data[ gr->used ];
         gr->used += units;
     }
@@ -346,6 +675,41 @@ gr_d gr_alloc( gr_t gr, gr_size_t bytes )
 }
 
 
+gr_size_t gr_gather( gr_t     gr,
+                     gr_size_t pos,
+                     gr_size_t count,
+                     gr_size_t offset,
+                     gr_size_t width,
+                     gr_d      buf )
+{
+    char*     dst = (char*)buf;
+    gr_size_t end;
+
+    if ( pos >= gm_used( gr ) )
+        return 0;
+
+    if ( count > gm_used( gr ) - pos )
+        count = gm_used( gr ) - pos;
+
+    end = pos + count;
+
+    for ( gr_size_t i = pos; i < end; i++ ) {
+
+        if ( i + GR_PREFETCH_DISTANCE < end && gm_nth( gr, i + GR_PREFETCH_DISTANCE ) )
+            gr_prefetch( (char*)gm_nth( gr, i + GR_PREFETCH_DISTANCE ) + offset );
+
+        if ( gm_nth( gr, i ) )
+            memcpy( dst, (char*)gm_nth( gr, i ) + offset, width );
+        else
+            memset( dst, 0, width );
+
+        dst += width;
+    }
+
+    return count;
+}
+
+
 /* ------------------------------------------------------------
  * Queries:
  */
@@ -421,6 +785,24 @@ int gr_is_empty( gr_t gr )
 }
 
 
+int gr_is_shared( gr_t gr )
+{
+    if ( gr_shared( gr ) )
+        return gr_true;
+    else
+        return gr_false;
+}
+
+
+int gr_is_frozen( gr_t gr )
+{
+    if ( gr_frozen( gr ) )
+        return gr_true;
+    else
+        return gr_false;
+}
+
+
 int gr_is_full( gr_t gr )
 {
     if ( gr == NULL )
@@ -458,9 +840,9 @@ gr_pos_t gr_find_with( gr_t gr, gr_compare_fn_p compare, gr_d ref )
 void gr_set_local( gr_t gr, int val )
 {
     if ( val != 0 )
-        gr->size = gr->size | 0x1L;
+        gr->size = gr->size | gr_lmsk;
     else
-        gr->size = gr->size & gr_smsk;
+        gr->size = gr->size & ~gr_lmsk;
 }
 
 
@@ -470,180 +852,1326 @@ int gr_get_local( gr_t gr )
 }
 
 
+void gr_set_uninit( gr_t gr, int val )
+{
+    if ( val != 0 ) {
+        gr->size = gr->size | gr_umsk;
+    } else {
+        /* Slots beyond usage read as zero in default mode. */
+        if ( !GR_UNINIT && ( gr->size & gr_umsk ) && gr_mutable( gr ) )
+            memset( &gm_end( gr ), 0, ( gm_size( gr ) - gm_used( gr ) ) * gr_unit_size );
+        gr->size = gr->size & ~gr_umsk;
+    }
+}
+
 
-/* ------------------------------------------------------------
- * Utilities:
- */
+int gr_get_uninit( gr_t gr )
+{
+    return gr_uninit( gr ) != 0;
+}
 
 
-gr_size_t gr_alloc_pages( gr_size_t count, gr_d* mem )
+void gr_set_external( gr_t gr, gr_resize_fn_p resize, gr_d state )
 {
-    if ( count == 0 ) {
-        return sysconf( _SC_PAGESIZE );
-    }
+    gr_ext( gr )->resize = resize;
+    gr_ext( gr )->state = state;
+    gr->size = gr->size | gr_xmsk | gr_lmsk;
+}
 
-    gr_size_t page_size;
-    page_size = sysconf( _SC_PAGESIZE );
 
-    if ( !posix_memalign( mem, page_size, count * page_size ) ) {
-        memset( *mem, 0, count * page_size );
-        return count * page_size;
-    } else {
-        gr_assert( 0 ); // GCOV_EXCL_LINE
-    }
+gr_ext_s* gr_get_external( gr_t gr )
+{
+    if ( gr_external( gr ) )
+        return gr_ext( gr );
+    else
+        return NULL;
+}
 
-    return 0;
+
+gr_observe_fn_p gr_set_observer( gr_observe_fn_p fn )
+{
+    return __atomic_exchange_n( &gr_observer, fn, __ATOMIC_RELAXED );
+}
+
+
+gr_observe_fn_p gr_get_observer( void )
+{
+    return __atomic_load_n( &gr_observer, __ATOMIC_RELAXED );
 }
 
 
 
 /* ------------------------------------------------------------
- * Internal support:
+ * Heap (priority queue):
  */
 
 
-/**
- * Initialize Gromer struct to given size and local mode.
- *
- * @param gr    Gromer.
- * @param size  Size.
- * @param local Local mode.
- */
-static void gr_init( gr_t gr, gr_size_t size, int local )
+void gr_heapify( gr_p gp, gr_compare_fn_p compare )
 {
-    gr->size = size;
-    gr_set_local( gr, local );
-    gr->used = 0;
-    gr->data[ 0 ] = NULL;
+    gr_order_t ord = { compare, NULL, 0 };
+    gr_heapify_order( gr_unshare( gp ), &ord );
 }
 
 
-/**
- * Align reservation size for 4k and bigger.
- *
- * Small reservations are not effected.
- *
- * @param new_size Size to align, if needed.
- *
- * @return Valid size.
- */
-static gr_size_t gr_align_size( gr_size_t new_size )
+void gr_heap_push( gr_p gp, gr_d item, gr_compare_fn_p compare )
 {
-    if ( new_size >= 4096 ) {
-        if ( new_size == 4096 ) {
-            new_size = 4096 - sizeof( gr_s );
-        } else {
-            new_size = ( ( ( new_size >> 12 ) + 1 ) << 12 ) - sizeof( gr_s );
-        }
-    }
+    gr_order_t ord = { compare, NULL, 0 };
+    gr_push( gp, item );
+    gr_sift_up( *gp, gm_used( *gp ) - 1, &ord );
+}
 
-    return new_size;
+
+gr_d gr_heap_pop( gr_p gp, gr_compare_fn_p compare )
+{
+    gr_order_t ord = { compare, NULL, 0 };
+    return gr_heap_take( gr_unshare( gp ), &ord );
 }
 
 
-/**
- * Calculate incremented memory reservation size.
- *
- * Reservation size is doubled from the existing value.
- *
- * @param gr Gromer.
- *
- * @return New size.
- */
-static gr_size_t gr_incr_size( gr_t gr )
+gr_d gr_heap_peek( gr_t gr )
 {
-    return gr_align_size( gr->size * 2 );
+    if ( gm_any( gr ) )
+        return gm_first( gr );
+    else
+        return NULL;
 }
 
 
-/**
- * Convert size to a legal Gromer size.
+gr_size_t gr_heap_decrease( gr_p gp, gr_pos_t pos, gr_compare_fn_p compare )
+{
+    gr_order_t ord = { compare, NULL, 0 };
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return gr_norm_idx( gr, pos );
+    return gr_sift_up( gr, gr_norm_idx( gr, pos ), &ord );
+}
+
+
+void gr_heapify_by( gr_p gp, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 0 };
+    gr_heapify_order( gr_unshare( gp ), &ord );
+}
+
+
+void gr_heap_push_by( gr_p gp, gr_d item, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 0 };
+    gr_push( gp, item );
+    gr_sift_up( *gp, gm_used( *gp ) - 1, &ord );
+}
+
+
+gr_d gr_heap_pop_by( gr_p gp, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 0 };
+    return gr_heap_take( gr_unshare( gp ), &ord );
+}
+
+
+gr_size_t gr_heap_decrease_by( gr_p gp, gr_pos_t pos, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 0 };
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return gr_norm_idx( gr, pos );
+    return gr_sift_up( gr, gr_norm_idx( gr, pos ), &ord );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Selection:
+ */
+
+
+void gr_select( gr_p gp, gr_size_t nth, gr_compare_fn_p compare )
+{
+    gr_order_t ord = { compare, NULL, 0 };
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return;
+    if ( nth < gm_used( gr ) )
+        gr_intro_select( gm_data( gr ), 0, gm_used( gr ), nth, &ord );
+}
+
+
+void gr_select_by( gr_p gp, gr_size_t nth, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 0 };
+    gr_t gr = gr_unshare( gp );
+
+    if ( !gr_writable( gr ) )
+        return;
+    if ( nth < gm_used( gr ) )
+        gr_intro_select( gm_data( gr ), 0, gm_used( gr ), nth, &ord );
+}
+
+
+void gr_partial_sort( gr_p gp, gr_size_t k, gr_compare_fn_p compare )
+{
+    gr_order_t ord = { compare, NULL, 0 };
+    gr_partial_sort_order( gr_unshare( gp ), k, &ord );
+}
+
+
+void gr_partial_sort_by( gr_p gp, gr_size_t k, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 0 };
+    gr_partial_sort_order( gr_unshare( gp ), k, &ord );
+}
+
+
+gr_d gr_topk_push( gr_p gp, gr_size_t k, gr_d item, gr_compare_fn_p compare )
+{
+    gr_order_t ord = { compare, NULL, 1 };
+    return gr_topk_push_order( gp, k, item, &ord );
+}
+
+
+gr_d gr_topk_push_by( gr_p gp, gr_size_t k, gr_d item, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 1 };
+    return gr_topk_push_order( gp, k, item, &ord );
+}
+
+
+void gr_topk_sort( gr_p gp, gr_compare_fn_p compare )
+{
+    gr_order_t ord = { compare, NULL, 1 };
+    gr_topk_sort_order( gr_unshare( gp ), &ord );
+}
+
+
+void gr_topk_sort_by( gr_p gp, gr_key_fn_p key )
+{
+    gr_order_t ord = { NULL, key, 1 };
+    gr_topk_sort_order( gr_unshare( gp ), &ord );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Merge:
+ */
+
+
+gr_t gr_merge( gr_t* grs, gr_size_t count, gr_compare_fn_p compare, int dedup )
+{
+    gr_t       gr;
+    gr_size_t  total = 0;
+    gr_size_t* lo;
+    gr_size_t* hi;
+
+    for ( gr_size_t i = 0; i < count; i++ )
+        total += gm_used( grs[ i ] );
+
+    /* Result is written fully, hence zero-fill only the tail. */
+    gr = gr_new_uninit( total );
+
+    if ( count > 0 ) {
+        lo = (gr_size_t*)gr_malloc( 2 * count * sizeof( gr_size_t ) );
+        hi = lo + count;
+        for ( gr_size_t i = 0; i < count; i++ )
+            hi[ i ] = gm_used( grs[ i ] );
+
+        gm_used( gr ) = gr_merge_span( gm_data( gr ), grs, lo, hi, count, compare, dedup );
+
+        gr_free( lo );
+    }
+
+    gr_set_uninit( gr, 0 );
+
+    return gr;
+}
+
+
+gr_size_t gr_merge_span( gr_d*           dst,
+                         gr_t*           grs,
+                         const gr_size_t* lo,
+                         const gr_size_t* hi,
+                         gr_size_t       count,
+                         gr_compare_fn_p compare,
+                         int             dedup )
+{
+    gr_size_t* pos;
+    gr_size_t* tree;
+    gr_size_t* win;
+    gr_size_t  cnt = 0;
+    gr_size_t  w;
+
+    if ( count == 0 )
+        return 0;
+
+    /* Loser tree: leaves are at "count + i", internal nodes hold the
+     * loser and "tree[0]" holds the winner. */
+    pos = (gr_size_t*)gr_malloc( 3 * count * sizeof( gr_size_t ) );
+    tree = pos + count;
+    win = tree + count;
+
+    memcpy( pos, lo, count * sizeof( gr_size_t ) );
+
+    for ( gr_size_t n = count - 1; n >= 1; n-- ) {
+        gr_size_t a = ( 2 * n >= count ) ? 2 * n - count : win[ 2 * n ];
+        gr_size_t b = ( 2 * n + 1 >= count ) ? 2 * n + 1 - count : win[ 2 * n + 1 ];
+        if ( gr_merge_less( grs, pos, hi, compare, b, a ) ) {
+            win[ n ] = b;
+            tree[ n ] = a;
+        } else {
+            win[ n ] = a;
+            tree[ n ] = b;
+        }
+    }
+
+    w = ( count > 1 ) ? win[ 1 ] : 0;
+
+    while ( pos[ w ] < hi[ w ] ) {
+
+        gr_d item = gm_nth( grs[ w ], pos[ w ] );
+
+        if ( !dedup || cnt == 0 || compare( dst[ cnt - 1 ], item ) != 0 )
+            dst[ cnt++ ] = item;
+
+        pos[ w ]++;
+
+        /* Replay matches from leaf to root. */
+        for ( gr_size_t n = ( w + count ) / 2; n >= 1; n /= 2 ) {
+            if ( gr_merge_less( grs, pos, hi, compare, tree[ n ], w ) ) {
+                gr_size_t t = tree[ n ];
+                tree[ n ] = w;
+                w = t;
+            }
+        }
+    }
+
+    gr_free( pos );
+
+    return cnt;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Utilities:
+ */
+
+
+gr_size_t gr_alloc_pages( gr_size_t count, gr_d* mem )
+{
+    if ( count == 0 ) {
+        return sysconf( _SC_PAGESIZE );
+    }
+
+    gr_size_t page_size;
+    page_size = sysconf( _SC_PAGESIZE );
+
+    gr_observe_begin();
+    if ( !posix_memalign( mem, page_size, count * page_size ) ) {
+        if ( !GR_UNINIT )
+            memset( *mem, 0, count * page_size );
+        gr_observe_end( GR_ALLOC_PAGES, count * page_size, 0 );
+        return count * page_size;
+    } else {
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+    }
+
+    return 0;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Value Gromer:
+ */
+
+
+/** @cond gromer_none */
+#define gv_addr( gv, pos ) ( &( gv )->data[ ( pos ) * ( gv )->unit ] )
+/** @endcond gromer_none */
+
+
+gv_t gv_new( gr_size_t unit )
+{
+    return gv_new_sized( unit, GR_DEFAULT_SIZE );
+}
+
+
+gv_t gv_new_sized( gr_size_t unit, gr_size_t size )
+{
+    gv_t gv;
+
+    gr_assert( unit > 0 );
+
+    size = gr_legal_size( size );
+    gv = (gv_t)gr_reserve( gv_struct_size( size, unit ), GR_UNINIT );
+    gv->size = size;
+    gv->used = 0;
+    gv->unit = unit;
+
+    return gv;
+}
+
+
+gv_t gv_use( gr_d mem, gr_size_t size, gr_size_t unit )
+{
+    gr_assert( unit > 0 );
+    gr_assert( size >= gv_struct_size( GR_MIN_SIZE, unit ) );
+    gr_assert( (uintptr_t)mem % GV_ALIGN == 0 );
+
+    gr_size_t gv_size;
+    gv_size = gr_snor( ( size - sizeof( gv_s ) ) / unit );
+    if ( gv_size * unit > size - sizeof( gv_s ) )
+        gv_size -= 2;
+
+    gv_t gv;
+    gv = (gv_t)mem;
+    gv->size = gv_size | gr_lmsk;
+    gv->used = 0;
+    gv->unit = unit;
+    if ( !GR_UNINIT )
+        memset( gv->data, 0, size - sizeof( gv_s ) );
+
+    return gv;
+}
+
+
+void gv_destroy( gv_p gp )
+{
+    if ( *gp == NULL )
+        return;
+
+    if ( !gr_local( *gp ) )
+        gr_free( *gp );
+
+    *gp = NULL;
+}
+
+
+void gv_resize( gv_p gp, gr_size_t new_size )
+{
+    new_size = gr_legal_size( new_size );
+
+    if ( new_size >= gm_used( *gp ) )
+        gv_resize_to( gp, new_size );
+}
+
+
+void gv_push( gv_p gp, const void* item )
+{
+    gr_size_t new_used = gm_used( *gp ) + 1;
+
+    if ( new_used > gm_size( *gp ) )
+        gv_resize_to( gp, gr_incr_size( (gr_t)*gp ) );
+
+    memcpy( gv_addr( *gp, gm_used( *gp ) ), item, ( *gp )->unit );
+    gm_used( *gp ) = new_used;
+}
+
+
+gr_d gv_pop( gv_t gv )
+{
+    if ( gm_any( gv ) ) {
+        gm_used( gv )--;
+        return gv_addr( gv, gm_used( gv ) );
+    } else {
+        return NULL;
+    }
+}
+
+
+void gv_reset( gv_t gv )
+{
+    gm_used( gv ) = 0;
+}
+
+
+void gv_insert_at( gv_p gp, gr_pos_t pos, const void* item )
+{
+    gr_size_t new_used = gm_used( *gp ) + 1;
+
+    if ( new_used > gm_size( *gp ) )
+        gv_resize_to( gp, gr_incr_size( (gr_t)*gp ) );
+
+    gr_size_t norm;
+    if ( pos == (gr_pos_t)gm_used( *gp ) )
+        norm = pos;
+    else
+        norm = gv_norm_idx( *gp, pos );
+
+    if ( norm < gm_used( *gp ) ) {
+        memmove( gv_addr( *gp, norm + 1 ),
+                 gv_addr( *gp, norm ),
+                 ( gm_used( *gp ) - norm ) * ( *gp )->unit );
+    }
+
+    memcpy( gv_addr( *gp, norm ), item, ( *gp )->unit );
+    gm_used( *gp ) = new_used;
+}
+
+
+int gv_delete_at( gv_t gv, gr_pos_t pos, gr_d item )
+{
+    if ( gm_empty( gv ) )
+        return gr_false;
+
+    gr_size_t norm = gv_norm_idx( gv, pos );
+
+    if ( item )
+        memcpy( item, gv_addr( gv, norm ), gv->unit );
+
+    memmove( gv_addr( gv, norm ),
+             gv_addr( gv, norm + 1 ),
+             ( gm_used( gv ) - ( norm + 1 ) ) * gv->unit );
+
+    gm_used( gv )--;
+
+    return gr_true;
+}
+
+
+void gv_sort( gv_t gv, gr_compare_fn_p compare )
+{
+    qsort( gv->data, gv->used, gv->unit, (int ( * )( const void*, const void* ))compare );
+}
+
+
+gr_size_t gv_used( gv_t gv )
+{
+    return gm_used( gv );
+}
+
+
+gr_size_t gv_size( gv_t gv )
+{
+    return gm_size( gv );
+}
+
+
+gr_size_t gv_unit( gv_t gv )
+{
+    return gv->unit;
+}
+
+
+gr_d gv_nth( gv_t gv, gr_pos_t pos )
+{
+    if ( gm_any( gv ) )
+        return gv_addr( gv, gv_norm_idx( gv, pos ) );
+    else
+        return NULL;
+}
+
+
+int gv_get_local( gv_t gv )
+{
+    return gr_local( gv );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Initialize Gromer struct to given size and local mode.
+ *
+ * @param gr    Gromer.
+ * @param size  Size.
+ * @param local Local mode.
+ */
+static void gr_init( gr_t gr, gr_size_t size, int local )
+{
+    gr->size = size;
+    gr_set_local( gr, local );
+    gr->used = 0;
+    gr->data[ 0 ] = NULL;
+}
+
+
+/**
+ * Align reservation size for 4k and bigger.
+ *
+ * Small reservations are not effected.
+ *
+ * @param new_size Size to align, if needed.
+ *
+ * @return Valid size.
+ */
+static gr_size_t gr_align_size( gr_size_t new_size )
+{
+    if ( new_size >= 4096 ) {
+        if ( new_size == 4096 ) {
+            new_size = 4096 - sizeof( gr_s );
+        } else {
+            new_size = ( ( ( new_size >> 12 ) + 1 ) << 12 ) - sizeof( gr_s );
+        }
+    }
+
+    return new_size;
+}
+
+
+/**
+ * Calculate incremented memory reservation size.
+ *
+ * Reservation size is doubled from the existing value.
+ *
+ * @param gr Gromer.
+ *
+ * @return New size.
+ */
+static gr_size_t gr_incr_size( gr_t gr )
+{
+    return gr_align_size( gm_size( gr ) * 2 );
+}
+
+
+/**
+ * Convert size to a legal Gromer size.
+ *
+ * @param size Requested size.
+ *
+ * @return Legal size.
+ */
+static gr_size_t gr_legal_size( gr_size_t size )
+{
+    size = gr_snor( size );
+
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+
+    return gr_align_size( size );
+}
+
+
+/**
+ * Normalize (possibly negative) Gromer index. Positive index is
+ * saturated to Gromer length, and negative index is normalized.
+ *
+ * -1 means last char in Gromer, -2 second to last, etc. Index after
+ * last char can only be expressed by positive indeces. E.g. for
+ * Gromer with length of 4 the indeces are:
+ *
+ * Chars:     a  b  c  d  \0
+ * Positive:  0  1  2  3  4
+ * Negative: -4 -3 -2 -1
+ *
+ * @param gr  Gromer.
+ * @param idx Index to Gromer.
+ *
+ * @return Unsigned (positive) index to Gromer.
+ */
+static gr_size_t gr_norm_idx( gr_t gr, gr_pos_t idx )
+{
+    gr_size_t pidx;
+
+    if ( idx < 0 ) {
+        pidx = gm_used( gr ) + idx;
+        idx  = gm_used( gr ) + idx;
+    } else {
+        pidx = idx;
+    }
+
+    if ( pidx >= gm_used( gr ) ) {
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+        return gm_used( gr ) - 1; // GCOV_EXCL_LINE
+    } else if ( idx < 0 ) {
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+        return 0;
+    } else {
+        return pidx;
+    }
+}
+
+
+/**
+ * Resize Gromer to requested size.
+ *
+ * Frozen Gromer is not resized.
+ *
+ * @param gp       Gromer reference.
+ * @param new_size Requested size.
+ *
+ * @return 0 on success.
+ */
+static int gr_resize_to( gr_p gp, gr_size_t new_size )
+{
+    gr_size_t mode = ( *gp )->size & gr_umsk;
+
+    gr_assert( !gr_frozen( *gp ) );
+    if ( gr_frozen( *gp ) )
+        return -1;
+
+    gr_t old = *gp;
+    gr_observe_begin();
+
+    if ( gr_external( *gp ) ) {
+        int ret = gr_ext( *gp )->resize( gp, new_size, gr_ext( *gp )->state );
+        gr_assert( ret == 0 );
+        if ( ret != 0 ) {
+            /* Storage is kept on failure. */
+            *gp = old;
+            return ret;
+        }
+        gr_observe_end( GR_ALLOC_RESIZE, gr_struct_size( new_size ), *gp != old );
+        return 0;
+    }
+
+    if ( gr_get_local( *gp ) || gr_shared( *gp ) ) {
+
+        /* Storage is not owned exclusively, hence relocate to a
+         * private copy. */
+        *gp = (gr_t)gr_reserve( gr_struct_size( new_size ), gr_uninit( old ) );
+        gm_used( *gp ) = gm_used( old );
+        memcpy( gm_data( *gp ), gm_data( old ), gr_used_size( old ) );
+
+        if ( !gr_local( old ) && gr_unref( old ) )
+            gr_free( old );
+
+    } else {
+
+        gr_size_t old_size = gm_size( *gp );
+        *gp = (gr_t)gr_realloc( *gp, gr_struct_size( new_size ) );
+
+        if ( new_size > old_size && !gr_uninit( *gp ) ) {
+            /* Clear newly allocated memory. */
+            memset( &( ( *gp )->data[ old_size ] ),
+                    0,
+                    ( new_size - old_size ) * sizeof( gr_d ) );
+        }
+    }
+
+    gr_observe_end( GR_ALLOC_RESIZE, gr_struct_size( new_size ), *gp != old );
+
+    ( *gp )->size = new_size | mode;
+
+    /* NOTE: Setting to non-local is not needed, since size is already
+     * an even value. It is here only for clarity. */
+    gr_set_local( *gp, 0 );
+
+    return 0;
+}
+
+
+/**
+ * Release pages beyond usage with madvise().
+ *
+ * Only pages that are fully within unused storage are released.
+ *
+ * @param gr   Gromer.
+ * @param from First slot to release (at least usage).
+ * @param zero Released pages must read as zero (MADV_DONTNEED).
+ *
+ * @return Released byte count.
+ */
+static gr_size_t gr_release_tail( gr_t gr, gr_size_t from, int zero )
+{
+    uintptr_t page = sysconf( _SC_PAGESIZE );
+    uintptr_t lo = ( (uintptr_t)&gm_nth( gr, from ) + page - 1 ) & ~( page - 1 );
+    uintptr_t hi = (uintptr_t)&gm_nth( gr, gm_size( gr ) ) & ~( page - 1 );
+    int       advice = MADV_DONTNEED;
+
+    if ( lo >= hi )
+        return 0;
+
+#ifdef MADV_FREE
+    if ( !zero )
+        advice = MADV_FREE;
+#else
+    (void)zero;
+#endif
+
+    if ( madvise( (void*)lo, hi - lo, advice ) != 0 )
+        return 0; // GCOV_EXCL_LINE
+
+    return hi - lo;
+}
+
+
+/**
+ * Order test.
+ *
+ * @param ord Ordering.
+ * @param a   Item.
+ * @param b   Item.
+ *
+ * @return 1 if "a" is before "b".
+ */
+static int gr_less( const gr_order_t* ord, gr_d a, gr_d b )
+{
+    if ( ord->rev ) {
+        gr_d t = a;
+        a = b;
+        b = t;
+    }
+
+    if ( ord->compare )
+        return ord->compare( a, b ) < 0;
+    else
+        return ord->key( a ) < ord->key( b );
+}
+
+
+/**
+ * Move item towards heap root until heap order is restored.
  *
- * @param size Requested size.
+ * @param gr  Gromer.
+ * @param idx Item index.
+ * @param ord Ordering.
  *
- * @return Legal size.
+ * @return Final index of item.
  */
-static gr_size_t gr_legal_size( gr_size_t size )
+static gr_size_t gr_sift_up( gr_t gr, gr_size_t idx, const gr_order_t* ord )
 {
-    size = gr_snor( size );
+    gr_d item = gm_nth( gr, idx );
+
+    while ( idx > 0 ) {
+        gr_size_t parent = ( idx - 1 ) / GR_HEAP_ARITY;
+        if ( !gr_less( ord, item, gm_nth( gr, parent ) ) )
+            break;
+        gm_nth( gr, idx ) = gm_nth( gr, parent );
+        idx = parent;
+    }
 
-    if ( size < GR_MIN_SIZE )
-        size = GR_MIN_SIZE;
+    gm_nth( gr, idx ) = item;
 
-    return gr_align_size( size );
+    return idx;
 }
 
 
 /**
- * Normalize (possibly negative) Gromer index. Positive index is
- * saturated to Gromer length, and negative index is normalized.
+ * Move item towards heap leaves until heap order is restored.
  *
- * -1 means last char in Gromer, -2 second to last, etc. Index after
- * last char can only be expressed by positive indeces. E.g. for
- * Gromer with length of 4 the indeces are:
+ * Children of a node are contiguous in memory, i.e. the smallest
+ * child is found from one or two cache lines.
  *
- * Chars:     a  b  c  d  \0
- * Positive:  0  1  2  3  4
- * Negative: -4 -3 -2 -1
+ * @param gr   Gromer.
+ * @param idx  Item index.
+ * @param used Heap size.
+ * @param ord  Ordering.
+ */
+static void gr_sift_down( gr_t gr, gr_size_t idx, gr_size_t used, const gr_order_t* ord )
+{
+    gr_d item;
+
+    if ( idx >= used )
+        return;
+
+    item = gm_nth( gr, idx );
+
+    for ( ;; ) {
+        gr_size_t first = idx * GR_HEAP_ARITY + 1;
+        gr_size_t last;
+        gr_size_t min;
+
+        if ( first >= used )
+            break;
+
+        last = first + GR_HEAP_ARITY;
+        if ( last > used )
+            last = used;
+
+        min = first;
+        for ( gr_size_t i = first + 1; i < last; i++ ) {
+            if ( gr_less( ord, gm_nth( gr, i ), gm_nth( gr, min ) ) )
+                min = i;
+        }
+
+        if ( !gr_less( ord, gm_nth( gr, min ), item ) )
+            break;
+
+        gm_nth( gr, idx ) = gm_nth( gr, min );
+        idx = min;
+    }
+
+    gm_nth( gr, idx ) = item;
+}
+
+
+/**
+ * Remove heap root.
  *
  * @param gr  Gromer.
- * @param idx Index to Gromer.
+ * @param ord Ordering.
  *
- * @return Unsigned (positive) index to Gromer.
+ * @return Root item (or NULL).
  */
-static gr_size_t gr_norm_idx( gr_t gr, gr_pos_t idx )
+static gr_d gr_heap_take( gr_t gr, const gr_order_t* ord )
 {
-    gr_size_t pidx;
+    gr_d ret;
 
-    if ( idx < 0 ) {
-        pidx = gm_used( gr ) + idx;
-        idx  = gm_used( gr ) + idx;
-    } else {
-        pidx = idx;
+    if ( gm_empty( gr ) )
+        return NULL;
+
+    if ( !gr_writable( gr ) )
+        return NULL;
+
+    ret = gm_first( gr );
+    gm_first( gr ) = gm_last( gr );
+    gm_used( gr )--;
+    gr_sift_down( gr, 0, gm_used( gr ), ord );
+
+    return ret;
+}
+
+
+/**
+ * Arrange items to heap order.
+ *
+ * @param gr  Gromer.
+ * @param ord Ordering.
+ */
+static void gr_heapify_order( gr_t gr, const gr_order_t* ord )
+{
+    if ( !gr_writable( gr ) )
+        return;
+
+    for ( gr_size_t i = gm_used( gr ) / GR_HEAP_ARITY + 1; i-- > 0; )
+        gr_sift_down( gr, i, gm_used( gr ), ord );
+}
+
+
+/**
+ * Sort range with (binary) heap sort.
+ *
+ * @param data Item array.
+ * @param lo   Range start.
+ * @param hi   Range end (exclusive).
+ * @param ord  Ordering.
+ */
+static void gr_range_heap_sort( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord )
+{
+    gr_d*     base = &data[ lo ];
+    gr_size_t cnt = hi - lo;
+
+    /* Max-heap construction followed by extraction. */
+    for ( gr_size_t end = cnt, start = cnt / 2;; ) {
+
+        gr_size_t root;
+        gr_d      item;
+
+        if ( start > 0 ) {
+            root = --start;
+        } else {
+            if ( end <= 1 )
+                break;
+            end--;
+            item = base[ end ];
+            base[ end ] = base[ 0 ];
+            base[ 0 ] = item;
+            root = 0;
+        }
+
+        item = base[ root ];
+        for ( ;; ) {
+            gr_size_t child = 2 * root + 1;
+            if ( child >= end )
+                break;
+            if ( child + 1 < end && gr_less( ord, base[ child ], base[ child + 1 ] ) )
+                child++;
+            if ( !gr_less( ord, item, base[ child ] ) )
+                break;
+            base[ root ] = base[ child ];
+            root = child;
+        }
+        base[ root ] = item;
     }
+}
 
-    if ( pidx >= gm_used( gr ) ) {
-        gr_assert( 0 ); // GCOV_EXCL_LINE
-        return gm_used( gr ) - 1; // GCOV_EXCL_LINE
-    } else if ( idx < 0 ) {
-        gr_assert( 0 ); // GCOV_EXCL_LINE
-        return 0;
-    } else {
-        return pidx;
+
+/**
+ * Sort (small) range with insertion sort.
+ *
+ * @param data Item array.
+ * @param lo   Range start.
+ * @param hi   Range end (exclusive).
+ * @param ord  Ordering.
+ */
+static void gr_insertion_sort( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord )
+{
+    for ( gr_size_t i = lo + 1; i < hi; i++ ) {
+        gr_d      item = data[ i ];
+        gr_size_t j = i;
+        while ( j > lo && gr_less( ord, item, data[ j - 1 ] ) ) {
+            data[ j ] = data[ j - 1 ];
+            j--;
+        }
+        data[ j ] = item;
     }
 }
 
 
 /**
- * Resize Gromer to requested size.
+ * Partition range around median-of-three pivot (Hoare).
  *
- * @param gp       Gromer reference.
+ * @param data Item array.
+ * @param lo   Range start.
+ * @param hi   Range end (exclusive, at least 3 items).
+ * @param ord  Ordering.
+ *
+ * @return Split point "s", where [lo,s) items are not after [s,hi)
+ *         items and both are non-empty.
+ */
+static gr_size_t gr_partition( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord )
+{
+    gr_size_t mid = lo + ( hi - lo ) / 2;
+    gr_size_t a = lo + 1;
+    gr_size_t c = hi - 1;
+    gr_size_t med;
+    gr_d      pivot;
+    gr_d      t;
+
+    /* Median of three to "lo". */
+    if ( gr_less( ord, data[ mid ], data[ a ] ) ) {
+        med = a;
+        a = mid;
+        mid = med;
+    }
+    if ( gr_less( ord, data[ c ], data[ mid ] ) )
+        med = gr_less( ord, data[ c ], data[ a ] ) ? a : c;
+    else
+        med = mid;
+
+    t = data[ lo ];
+    data[ lo ] = data[ med ];
+    data[ med ] = t;
+
+    pivot = data[ lo ];
+    gr_size_t i = lo;
+    gr_size_t j = hi - 1;
+
+    for ( ;; ) {
+        while ( gr_less( ord, data[ i ], pivot ) )
+            i++;
+        while ( gr_less( ord, pivot, data[ j ] ) )
+            j--;
+        if ( i >= j )
+            return j + 1;
+        t = data[ i ];
+        data[ i ] = data[ j ];
+        data[ j ] = t;
+        i++;
+        j--;
+    }
+}
+
+
+/**
+ * Return introsort/introselect recursion depth limit.
+ *
+ * @param count Item count.
+ *
+ * @return Depth limit.
+ */
+static gr_size_t gr_depth_limit( gr_size_t count )
+{
+    gr_size_t depth = 0;
+
+    while ( count > 1 ) {
+        count >>= 1;
+        depth += 2;
+    }
+
+    return depth;
+}
+
+
+/**
+ * Sort range with introsort.
+ *
+ * @param data Item array.
+ * @param lo   Range start.
+ * @param hi   Range end (exclusive).
+ * @param ord  Ordering.
+ */
+static void gr_intro_sort( gr_d* data, gr_size_t lo, gr_size_t hi, const gr_order_t* ord )
+{
+    gr_size_t depth = gr_depth_limit( hi - lo );
+
+    while ( hi - lo > 16 ) {
+
+        if ( depth-- == 0 ) {
+            gr_range_heap_sort( data, lo, hi, ord );
+            return;
+        }
+
+        gr_size_t s = gr_partition( data, lo, hi, ord );
+
+        /* Recurse to smaller side. */
+        if ( s - lo < hi - s ) {
+            gr_intro_sort( data, lo, s, ord );
+            lo = s;
+        } else {
+            gr_intro_sort( data, s, hi, ord );
+            hi = s;
+        }
+    }
+
+    gr_insertion_sort( data, lo, hi, ord );
+}
+
+
+/**
+ * Place nth item to its sorted position with introselect.
+ *
+ * Items before nth are not after it, and items after nth are not
+ * before it.
+ *
+ * @param data Item array.
+ * @param lo   Range start.
+ * @param hi   Range end (exclusive).
+ * @param nth  Selected position.
+ * @param ord  Ordering.
+ */
+static void gr_intro_select( gr_d* data, gr_size_t lo, gr_size_t hi, gr_size_t nth, const gr_order_t* ord )
+{
+    gr_size_t depth = gr_depth_limit( hi - lo );
+
+    while ( hi - lo > 16 ) {
+
+        if ( depth-- == 0 ) {
+            gr_range_heap_sort( data, lo, hi, ord );
+            return;
+        }
+
+        gr_size_t s = gr_partition( data, lo, hi, ord );
+
+        if ( nth < s )
+            hi = s;
+        else
+            lo = s;
+    }
+
+    gr_insertion_sort( data, lo, hi, ord );
+}
+
+
+/**
+ * Sort first k items.
+ *
+ * @param gr  Gromer.
+ * @param k   Item count.
+ * @param ord Ordering.
+ */
+static void gr_partial_sort_order( gr_t gr, gr_size_t k, const gr_order_t* ord )
+{
+    if ( !gr_writable( gr ) )
+        return;
+
+    if ( k == 0 )
+        return;
+
+    if ( k < gm_used( gr ) )
+        gr_intro_select( gm_data( gr ), 0, gm_used( gr ), k - 1, ord );
+    else
+        k = gm_used( gr );
+
+    gr_intro_sort( gm_data( gr ), 0, k, ord );
+}
+
+
+/**
+ * Push item to bounded (reverse) heap.
+ *
+ * @param gp   Gromer reference.
+ * @param k    Heap bound.
+ * @param item Item to push.
+ * @param ord  Reversed ordering.
+ *
+ * @return Item dropped out (or NULL).
+ */
+static gr_d gr_topk_push_order( gr_p gp, gr_size_t k, gr_d item, const gr_order_t* ord )
+{
+    gr_d ret;
+
+    if ( *gp == NULL )
+        *gp = gr_new();
+
+    if ( gm_used( *gp ) < k ) {
+        gr_push( gp, item );
+        gr_sift_up( *gp, gm_used( *gp ) - 1, ord );
+        return NULL;
+    }
+
+    /* Root is the biggest of top-k, replace it if item is smaller. */
+    if ( k == 0 || !gr_less( ord, gm_first( *gp ), item ) )
+        return item;
+
+    if ( !gr_writable( gr_unshare( gp ) ) )
+        return item;
+
+    ret = gm_first( *gp );
+    gm_first( *gp ) = item;
+    gr_sift_down( *gp, 0, gm_used( *gp ), ord );
+
+    return ret;
+}
+
+
+/**
+ * Sort top-k heap to ascending order.
+ *
+ * @param gr  Gromer.
+ * @param ord Reversed ordering.
+ */
+static void gr_topk_sort_order( gr_t gr, const gr_order_t* ord )
+{
+    if ( !gr_writable( gr ) )
+        return;
+
+    for ( gr_size_t end = gm_used( gr ); end > 1; end-- ) {
+        gr_d t = gm_first( gr );
+        gm_first( gr ) = gm_nth( gr, end - 1 );
+        gm_nth( gr, end - 1 ) = t;
+        gr_sift_down( gr, 0, end - 1, ord );
+    }
+}
+
+
+/**
+ * Merge order test for the current items of two inputs.
+ *
+ * Exhausted input is bigger than any item, and equal items are
+ * ordered by input index (stable merge).
+ *
+ * @param grs     Gromers.
+ * @param pos     Current positions.
+ * @param hi      End positions.
+ * @param compare Compare function.
+ * @param a       Input index.
+ * @param b       Input index.
+ *
+ * @return 1 if current of "a" is before current of "b".
+ */
+static int gr_merge_less( gr_t*           grs,
+                          gr_size_t*      pos,
+                          const gr_size_t* hi,
+                          gr_compare_fn_p compare,
+                          gr_size_t       a,
+                          gr_size_t       b )
+{
+    int ret;
+
+    if ( pos[ a ] >= hi[ a ] )
+        return gr_false;
+
+    if ( pos[ b ] >= hi[ b ] )
+        return gr_true;
+
+    ret = compare( gm_nth( grs[ a ], pos[ a ] ), gm_nth( grs[ b ], pos[ b ] ) );
+
+    if ( ret == 0 )
+        return a < b;
+    else
+        return ret < 0;
+}
+
+
+/**
+ * Normalize (possibly negative) Value Gromer index.
+ *
+ * @param gv  Value Gromer.
+ * @param idx Index to Value Gromer.
+ *
+ * @return Unsigned (positive) index to Value Gromer.
+ */
+static gr_size_t gv_norm_idx( gv_t gv, gr_pos_t idx )
+{
+    /* Header layout for size and used is shared with Gromer. */
+    return gr_norm_idx( (gr_t)gv, idx );
+}
+
+
+/**
+ * Resize Value Gromer to requested size.
+ *
+ * @param gp       Value Gromer reference.
  * @param new_size Requested size.
  */
-static void gr_resize_to( gr_p gp, gr_size_t new_size )
+static void gv_resize_to( gv_p gp, gr_size_t new_size )
 {
-    if ( gr_get_local( *gp ) ) {
+    gr_size_t unit = ( *gp )->unit;
 
-        *gp = (gr_t)gr_malloc( gr_struct_size( new_size ) );
+    if ( gr_local( *gp ) ) {
+
+        gv_t old = *gp;
+        *gp = (gv_t)gr_reserve( gv_struct_size( new_size, unit ), GR_UNINIT );
+        ( *gp )->used = old->used;
+        ( *gp )->unit = unit;
+        memcpy( ( *gp )->data, old->data, old->used * unit );
 
     } else {
 
-        gr_size_t old_size = ( *gp )->size;
-        *gp = (gr_t)gr_realloc( *gp, gr_struct_size( new_size ) );
+        gr_size_t old_size = gm_size( *gp );
+        *gp = (gv_t)gr_realloc( *gp, gv_struct_size( new_size, unit ) );
 
-        if ( new_size > old_size ) {
+        if ( new_size > old_size && !GR_UNINIT ) {
             /* Clear newly allocated memory. */
-            memset( &( ( *gp )->data[ old_size ] ),
-                    0,
-                    ( new_size - old_size ) * sizeof( gr_d ) );
+            memset( gv_addr( *gp, old_size ), 0, ( new_size - old_size ) * unit );
         }
     }
 
     ( *gp )->size = new_size;
+}
 
-    /* NOTE: Setting to non-local is not needed, since size is already
-     * an even value. It is here only for clarity. */
-    gr_set_local( *gp, 0 );
+
+/**
+ * Make room for new_used items and ensure that storage is not shared.
+ *
+ * @param gp       Gromer reference.
+ * @param new_used Usage count after update.
+ *
+ * @return 1 if storage is ready for update (0 if frozen or resize failed).
+ */
+static int gr_prepare( gr_p gp, gr_size_t new_used )
+{
+    if ( new_used > gm_size( *gp ) )
+        return gr_resize_to( gp, gr_incr_size( *gp ) ) == 0 && new_used <= gm_size( *gp );
+    else if ( gr_shared( *gp ) )
+        return gr_resize_to( gp, gm_size( *gp ) ) == 0;
+    else
+        return gr_writable( *gp );
+}
+
+
+/**
+ * Release one reference to shared storage.
+ *
+ * @param gr Gromer.
+ *
+ * @return 1 if caller was the last owner (i.e. storage should be freed).
+ */
+static int gr_unref( gr_t gr )
+{
+    gr_size_t size = __atomic_load_n( &gr->size, __ATOMIC_ACQUIRE );
+
+    while ( size & gr_cmsk ) {
+        if ( __atomic_compare_exchange_n(
+                 &gr->size, &size, size - gr_cone, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+            return gr_false;
+    }
+
+    return gr_true;
+}
+
+
+/**
+ * Return monotonic time in nanoseconds.
+ *
+ * @return Time.
+ */
+static uint64_t gr_now_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
 }
 
 
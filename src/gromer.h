@@ -11,10 +11,15 @@
  */
 
 #ifndef SIXTEN_STD_INCLUDE
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdint.h>
 #endif
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 
 #ifndef GROMER_NO_ASSERT
 #include <assert.h>
@@ -22,7 +27,7 @@
 #define gr_assert assert
 #else
 /** Disabled assertion. */
-#define gr_assert( cond ) (void)( ( cond ) || gr_void_assert() )
+#define gr_assert( cond ) (void)( ( cond ) || ( gr_void_assert(), 0 ) )
 #endif
 
 
@@ -34,6 +39,32 @@
 /** Minimum size for pointer array. */
 #define GR_MIN_SIZE 2
 
+#ifndef GR_PREFETCH_DISTANCE
+/** Default prefetch distance (in items) for pointer-chasing loops. */
+#define GR_PREFETCH_DISTANCE 8
+#endif
+
+#ifndef GR_HEAP_ARITY
+/** Heap arity, i.e. children per node (siblings are contiguous). */
+#define GR_HEAP_ARITY 4
+#endif
+
+#ifndef GR_RELEASE_SIZE
+/** Storage size (bytes) from which reset and clear release pages (0 for never). */
+#define GR_RELEASE_SIZE ( 1 << 20 )
+#endif
+
+#ifndef GR_UNINIT
+/** Skip zero-fill of unused slots for all Gromers, if 1. */
+#define GR_UNINIT 0
+#endif
+
+/** Cache line size in bytes. */
+#define GR_CACHE_LINE 64
+
+/** Value Gromer data alignment (heap allocator must provide it, as malloc does). */
+#define GV_ALIGN __alignof__( max_align_t )
+
 /** Outsize Gromer index. */
 #define GR_NOT_INDEX -1
 
@@ -52,7 +83,9 @@ typedef void* gr_d;
  * Gromer struct.
  *
  * NOTE: "size" is strictly forbidden to be used directly. Use
- * gr_size() instead.
+ * gr_size() instead. Lowest bit of "size" is the local mode and the
+ * highest 16 bits are reserved for Gromer meta information (e.g. share
+ * count and uninitialized mode).
  */
 struct gr_struct_s
 {
@@ -65,12 +98,70 @@ typedef gr_s*              gr_t; /**< Gromer. */
 typedef gr_t*              gr_p; /**< Gromer reference. */
 
 
-/** Resize function type. */
+/**
+ * Value Gromer struct.
+ *
+ * Value Gromer stores fixed size elements inline. Layout of "size"
+ * (including local bit) and "used" is the same as for Gromer, but
+ * counts are in elements of "unit" bytes. Data is aligned to
+ * GV_ALIGN, i.e. elements of any type (e.g. long double or vector
+ * types) are stored aligned.
+ */
+struct gv_struct_s
+{
+    gr_size_t size; /**< Reservation size for data (N mod 2==0). */
+    gr_size_t used; /**< Used count for data. */
+    gr_size_t unit; /**< Element size in bytes. */
+    /** Element array (header is padded to GV_ALIGN). */
+    uint8_t data[ 0 ] __attribute__( ( aligned( GV_ALIGN ) ) );
+};
+typedef struct gv_struct_s gv_s; /**< Value Gromer struct. */
+typedef gv_s*              gv_t; /**< Value Gromer. */
+typedef gv_t*              gv_p; /**< Value Gromer reference. */
+
+
+/**
+ * Resize function type. Function updates "*gp" to storage of
+ * "new_size" and returns 0 on success. On failure, the old storage
+ * must be left intact. Size 0 means release.
+ */
 typedef int ( *gr_resize_fn_p )( gr_p gp, gr_size_t new_size, gr_d state );
 
+
+/**
+ * External storage hook.
+ *
+ * Hook is located just before the Gromer struct, and it is used
+ * instead of heap allocation for Gromer with external storage (see
+ * gr_set_external()).
+ */
+struct gr_ext_struct_s
+{
+    gr_resize_fn_p resize; /**< Resize (and release) function. */
+    gr_d           state;  /**< Resize function state. */
+};
+typedef struct gr_ext_struct_s gr_ext_s; /**< External storage hook. */
+
+/** Allocation kind: Gromer creation. */
+#define GR_ALLOC_NEW 0
+/** Allocation kind: storage resize. */
+#define GR_ALLOC_RESIZE 1
+/** Allocation kind: page allocation (gr_alloc_pages()). */
+#define GR_ALLOC_PAGES 2
+
+/**
+ * Allocation observer function type. Observer is called after
+ * allocation with the kind (GR_ALLOC_*), size in bytes, relocation
+ * flag (storage moved by resize), and duration in nanoseconds.
+ */
+typedef void ( *gr_observe_fn_p )( int kind, gr_size_t bytes, int moved, uint64_t ns );
+
 /** Compare function type. */
 typedef int ( *gr_compare_fn_p )( const gr_d a, const gr_d b );
 
+/** Key extraction function type. */
+typedef gr_size_t ( *gr_key_fn_p )( const gr_d item );
+
 
 /** Iterate over all items. */
 #define gr_each( gr, iter, cast )                                       \
@@ -78,6 +169,28 @@ typedef int ( *gr_compare_fn_p )( const gr_d a, const gr_d b );
           ( gr_idx < ( gr )->used ) && ( iter = ( cast )( gr )->data[ gr_idx ] ); \
           gr_idx++ )
 
+#ifdef __GNUC__
+/** Prefetch memory at address for reading. */
+#define gr_prefetch( addr ) __builtin_prefetch( ( addr ) )
+#else
+/** Prefetch memory at address for reading (unsupported). */
+#define gr_prefetch( addr ) ( (void)( addr ) )
+#endif
+
+/** Prefetch object referenced by item at "idx + dist", if it exists. */
+#define gr_prefetch_ahead( gr, idx, dist )                      \
+    ( ( ( idx ) + ( dist ) < ( gr )->used )                     \
+      ? gr_prefetch( ( gr )->data[ ( idx ) + ( dist ) ] )       \
+      : (void)0 )
+
+/** Iterate over all items and prefetch the object "dist" items ahead. */
+#define gr_each_prefetch( gr, iter, cast, dist )                        \
+    for ( gr_size_t gr_idx = 0;                                         \
+          ( gr_idx < ( gr )->used )                                     \
+          && ( gr_prefetch_ahead( gr, gr_idx, dist ),                   \
+               iter = ( cast )( gr )->data[ gr_idx ] );                 \
+          gr_idx++ )
+
 /** Item at index with casting to target type. */
 #define gr_item( gr, idx, cast ) ( ( cast )( gr )->data[ ( idx ) ] )
 
@@ -93,6 +206,27 @@ typedef int ( *gr_compare_fn_p )( const gr_d a, const gr_d b );
 /** Gromer struct size. */
 #define gr_struct_size( size ) ( ( sizeof( gr_s ) ) + ( ( size ) * sizeof( gr_d ) ) )
 
+/** Value Gromer struct size. */
+#define gv_struct_size( size, unit ) ( ( sizeof( gv_s ) ) + ( ( size ) * ( unit ) ) )
+
+/** Element at index as target type (lvalue). */
+#define gv_item( gv, idx, type ) ( ( (type*)( gv )->data )[ ( idx ) ] )
+
+/** Iterate over all elements, "iter" is pointer to element. */
+#define gv_each( gv, iter, type )                                       \
+    for ( gr_size_t gr_idx = 0;                                         \
+          ( gr_idx < ( gv )->used ) && ( iter = &( (type*)( gv )->data )[ gr_idx ] ); \
+          gr_idx++ )
+
+/** Create Value Gromer for elements of type. */
+#define gv_new_for( type ) gv_new( sizeof( type ) )
+
+/** Make allocation for local (stack) Value Gromer. */
+#define gv_local_use( gv, buf, size, unit )                             \
+    gr_d buf[ ( gv_struct_size( size, unit ) + sizeof( gr_d ) - 1 ) / sizeof( gr_d ) ] \
+        __attribute__( ( aligned( GV_ALIGN ) ) );                       \
+    gv = gv_use( buf, sizeof( buf ), unit )
+
 /** Make allocation for local (stack) Gromer. */
 #define gr_local_use( gr, buf, size )   \
     gr_d buf[ gr_struct_size( size ) ]; \
@@ -105,6 +239,7 @@ typedef int ( *gr_compare_fn_p )( const gr_d a, const gr_d b );
 /** @cond gromer_none */
 #define grnew gr_new
 #define grsiz gr_new_sized
+#define grnun gr_new_uninit
 #define grpag gr_new_page
 #define grdes gr_destroy
 #define grres gr_resize
@@ -118,10 +253,20 @@ typedef int ( *gr_compare_fn_p )( const gr_d a, const gr_d b );
 #define grfll gr_is_full
 #define grpsh gr_push
 #define grpop gr_pop
+#define grpon gr_pop_n
+#define grpin gr_pop_into
+#define grdrn gr_drain
 #define gradd gr_add
 #define grrem gr_remove
 #define grrst gr_reset
+#define grrsr gr_reset_release
+#define grrel gr_release
 #define grdup gr_duplicate
+#define grdcw gr_duplicate_cow
+#define grush gr_unshare
+#define grshd gr_is_shared
+#define grfrz gr_freeze
+#define grfzn gr_is_frozen
 #define grswp gr_swap
 #define grins gr_insert_at
 #define griif gr_insert_if
@@ -129,6 +274,7 @@ typedef int ( *gr_compare_fn_p )( const gr_d a, const gr_d b );
 #define grfnd gr_find
 #define grfnw gr_find_with
 #define gralc gr_alloc
+#define grgat gr_gather
 
 #define grfor gr_for_each
 /** @endcond gromer_none */
@@ -146,7 +292,8 @@ typedef int ( *gr_compare_fn_p )( const gr_d a, const gr_d b );
  * If GROMER_USE_MEM_API is used, the user must provide implementation for
  * the above functions and they must be compatible with malloc
  * etc. Also Gromer assumes that gr_malloc sets all new memory to
- * zero.
+ * zero. gr_malloc_uninit, which is used in uninitialized mode, defaults
+ * to gr_malloc, but it can be defined to a non-clearing allocator.
  *
  * Additionally user should compile the library by own means.
  */
@@ -155,6 +302,10 @@ extern void* gr_malloc( size_t size );
 extern void  gr_free( void* ptr );
 extern void* gr_realloc( void* ptr, size_t size );
 
+#    ifndef gr_malloc_uninit
+#        define gr_malloc_uninit gr_malloc
+#    endif
+
 #else /* GROMER_USE_MEM_API */
 
 
@@ -163,6 +314,7 @@ extern void* gr_realloc( void* ptr, size_t size );
 #        define gr_malloc  st_alloc
 #        define gr_free    st_del
 #        define gr_realloc st_realloc
+#        define gr_malloc_uninit st_alloc
 
 
 #    else /* SIXTEN_USE_MEM_API == 1 */
@@ -178,6 +330,9 @@ extern void* gr_realloc( void* ptr, size_t size );
 /** Re-reserve memory. */
 #        define gr_realloc realloc
 
+/** Reserve memory without clearing. */
+#        define gr_malloc_uninit malloc
+
 #    endif /* SIXTEN_USE_MEM_API == 1 */
 
 #endif /* GROMER_USE_MEM_API */
@@ -211,6 +366,20 @@ gr_t gr_new( void );
 gr_t gr_new_sized( gr_size_t size );
 
 
+/**
+ * Create Gromer with size in uninitialized mode.
+ *
+ * Slots beyond usage are not zero-filled at creation or growth, and
+ * gr_clear() clears only the used slots. Suitable for Gromers that
+ * are filled with push (or gr_alloc()) before the items are read.
+ *
+ * @param size Initial size.
+ *
+ * @return Gromer.
+ */
+gr_t gr_new_uninit( gr_size_t size );
+
+
 /**
  * Create Gromer with page (4k) aligned size.
  *
@@ -226,6 +395,8 @@ gr_t gr_new_page( gr_size_t count );
 /**
  * Use existing memory allocation for Gromer.
  *
+ * Allocation is zero-filled, unless GR_UNINIT is set.
+ *
  * @param mem  Allocation for Gromer.
  * @param size Allocation size (in bytes).
  *
@@ -271,11 +442,11 @@ void gr_push( gr_p gp, gr_d item );
  * gr_pop() can be used for efficient stack operations. No operation
  * is Gromer is empty or Gromer is NULL.
  *
- * @param gr Gromer.
+ * @param gp Gromer reference.
  *
  * @return Popped item (or NULL).
  */
-gr_d gr_pop( gr_t gr );
+gr_d gr_pop( gr_p gp );
 
 
 /**
@@ -284,12 +455,58 @@ gr_d gr_pop( gr_t gr );
  * If count is bigger than the number of items, then maximum number of
  * items are removed.
  *
- * @param gr    Gromer.
+ * @param gp    Gromer reference.
  * @param count Item count.
  *
  * @return Number of items removed.
  */
-gr_size_t gr_drop( gr_t gr, gr_size_t count );
+gr_size_t gr_drop( gr_p gp, gr_size_t count );
+
+
+/**
+ * Pop number of items from end to buffer.
+ *
+ * Items are copied in their original order, i.e. the last item of
+ * Gromer is the last item in buffer. If count is bigger than the
+ * number of items, then all items are popped.
+ *
+ * @param gp    Gromer reference.
+ * @param buf   Buffer for items.
+ * @param count Maximum item count.
+ *
+ * @return Number of items popped.
+ */
+gr_size_t gr_pop_n( gr_p gp, gr_d* buf, gr_size_t count );
+
+
+/**
+ * Pop number of items from end to end of another Gromer.
+ *
+ * Items are in original order (see gr_pop_n()). Target is resized
+ * (once) if needed, and created if "*dst" is NULL.
+ *
+ * @param gp    Gromer reference.
+ * @param dst   Target Gromer reference.
+ * @param count Maximum item count.
+ *
+ * @return Number of items popped.
+ */
+gr_size_t gr_pop_into( gr_p gp, gr_p dst, gr_size_t count );
+
+
+/**
+ * Drain Gromer, i.e. take all items with the storage.
+ *
+ * Storage is returned as is and "*gp" is replaced with an empty
+ * Gromer of the same size (without zero-fill of the storage). Hence
+ * the consumer gets the items in O(1) and the producer continues
+ * without reallocation. Local Gromer is copied instead.
+ *
+ * @param gp Gromer reference.
+ *
+ * @return Drained Gromer.
+ */
+gr_t gr_drain( gr_p gp );
 
 
 /**
@@ -319,17 +536,54 @@ gr_d gr_remove( gr_p gp );
 /**
  * Reset Gromer to empty.
  *
- * @param gr Gromer.
+ * Size is kept. If storage is at least GR_RELEASE_SIZE bytes and at
+ * most a quarter was used, pages beyond twice the usage are released
+ * (see gr_release()). A reset-and-refill loop thus keeps the pages it
+ * refills, and only idle storage is given back.
+ *
+ * @param gp Gromer reference.
  */
-void gr_reset( gr_t gr );
+void gr_reset( gr_p gp );
 
 
 /**
- * Clear Gromer, i.e. reset and clear data.
+ * Reset Gromer to empty and release unused pages.
  *
- * @param gr Gromer.
+ * All unused pages are released (see gr_release()), if storage is at
+ * least GR_RELEASE_SIZE bytes. Use for a large Gromer which stays idle
+ * after reset, since refill faults the pages back.
+ *
+ * @param gp Gromer reference.
+ *
+ * @return Released byte count.
+ */
+gr_size_t gr_reset_release( gr_p gp );
+
+
+/**
+ * Clear Gromer, i.e. clear used slots and reset.
+ *
+ * Pages are released as with gr_reset().
+ *
+ * @param gp Gromer reference.
+ */
+void gr_clear( gr_p gp );
+
+
+/**
+ * Release memory pages beyond usage to the OS.
+ *
+ * Pages which are fully beyond usage are given back with madvise(),
+ * but the size is kept, i.e. refill does not reallocate and the pages
+ * are faulted back on use. Released pages read as zero, except in
+ * uninitialized mode (MADV_FREE) where content is undefined. Local
+ * Gromers are not released.
+ *
+ * @param gp Gromer reference.
+ *
+ * @return Released byte count.
  */
-void gr_clear( gr_t gr );
+gr_size_t gr_release( gr_p gp );
 
 
 /**
@@ -342,16 +596,76 @@ void gr_clear( gr_t gr );
 gr_t gr_duplicate( gr_t gr );
 
 
+/**
+ * Duplicate Gromer as copy-on-write.
+ *
+ * Duplicate shares the storage with "gr", i.e. the returned Gromer is
+ * "gr" itself with an incremented share count. Shared storage is
+ * copied to private storage by the first mutating operation (e.g.
+ * gr_push(), gr_pop(), gr_insert_at(), gr_delete_at(), gr_swap(),
+ * gr_sort(), gr_clear()) or by gr_unshare(). Mutating operations
+ * take a Gromer reference, since the copy relocates the Gromer. Each
+ * holder releases its share with gr_destroy().
+ *
+ * Local and frozen Gromers are not shared, and they are duplicated
+ * with gr_duplicate().
+ *
+ * @param gr Gromer to duplicate.
+ *
+ * @return Duplicated gromer.
+ */
+gr_t gr_duplicate_cow( gr_t gr );
+
+
+/**
+ * Make Gromer storage private.
+ *
+ * If storage is shared, it is copied to a new allocation and "*gp" is
+ * updated. Otherwise no action is performed.
+ *
+ * @param gp Gromer reference.
+ *
+ * @return Private Gromer.
+ */
+gr_t gr_unshare( gr_p gp );
+
+
+/**
+ * Freeze Gromer, i.e. make it immutable.
+ *
+ * Storage is shrunk to usage (rounded to even), shared storage is made
+ * private, and the Gromer is marked frozen. Mutating operations
+ * assert for frozen Gromer, and leave it unchanged if assertions are
+ * disabled.
+ *
+ * With "protect", storage is rebuilt to page aligned anonymous memory
+ * which is protected with mprotect(PROT_READ). Hence writes fault, and
+ * forked processes share the pages without copy-on-write duplication.
+ *
+ * Frozen Gromer is shared by handle, e.g. between threads, and it is
+ * released once with gr_destroy().
+ *
+ * If mapping or protecting the pages fails, or the storage is external
+ * (see gr_set_external()), Gromer is frozen without protection.
+ *
+ * @param gp      Gromer reference.
+ * @param protect Read-protect storage, if non-zero.
+ *
+ * @return 1 if storage is protected (else 0).
+ */
+int gr_freeze( gr_p gp, int protect );
+
+
 /**
  * Swap item in Gromer with given "item".
  *
- * @param gr   Gromer.
+ * @param gp   Gromer reference.
  * @param pos  Addressed item position.
  * @param item Item to swap in.
  *
  * @return Item swapped out.
  */
-gr_d gr_swap( gr_t gr, gr_pos_t pos, gr_d item );
+gr_d gr_swap( gr_p gp, gr_pos_t pos, gr_d item );
 
 
 /**
@@ -371,13 +685,13 @@ void gr_insert_at( gr_p gp, gr_pos_t pos, gr_d item );
  *
  * Gromer is not resized. Item is not inserted if it does not fit.
  *
- * @param gr   Gromer.
+ * @param gp   Gromer reference.
  * @param pos  Position.
  * @param item Item to insert.
  *
  * @return 1 if item was inserted.
  */
-int gr_insert_if( gr_t gr, gr_pos_t pos, gr_d item );
+int gr_insert_if( gr_p gp, gr_pos_t pos, gr_d item );
 
 
 /**
@@ -385,21 +699,21 @@ int gr_insert_if( gr_t gr, gr_pos_t pos, gr_d item );
  *
  * Gromer is not destroyed if last item is deleted.
  *
- * @param gr  Gromer.
+ * @param gp  Gromer reference.
  * @param pos Position.
  *
  * @return Item from delete position.
  */
-gr_d gr_delete_at( gr_t gr, gr_pos_t pos );
+gr_d gr_delete_at( gr_p gp, gr_pos_t pos );
 
 
 /**
  * Sort Gromer items.
  *
- * @param gr      Gromer.
+ * @param gp      Gromer reference.
  * @param compare Compare function.
  */
-void gr_sort( gr_t gr, gr_compare_fn_p compare );
+void gr_sort( gr_p gp, gr_compare_fn_p compare );
 
 
 /**
@@ -409,12 +723,40 @@ void gr_sort( gr_t gr, gr_compare_fn_p compare );
  * allocation is Gromer unit. If Gromer is used, NULL is returned and
  * Gromer is not resized.
  *
- * @param gr    Gromer.
+ * @param gp    Gromer reference.
  * @param bytes Number of bytes to allocate.
  *
  * @return Pointer (or NULL).
  */
-gr_d gr_alloc( gr_t gr, gr_size_t bytes );
+gr_d gr_alloc( gr_p gp, gr_size_t bytes );
+
+
+
+/**
+ * Gather a field from objects referenced by items.
+ *
+ * For "count" items starting from "pos", "width" bytes at "offset"
+ * within the referenced object are copied to consecutive positions in
+ * "buf". Objects are prefetched GR_PREFETCH_DISTANCE items ahead. NULL
+ * item produces a zero field.
+ *
+ * Count is saturated to the number of items available.
+ *
+ * @param gr     Gromer.
+ * @param pos    Start position.
+ * @param count  Item count.
+ * @param offset Field offset (in bytes) within object.
+ * @param width  Field width (in bytes).
+ * @param buf    Destination buffer (count * width bytes).
+ *
+ * @return Number of fields gathered.
+ */
+gr_size_t gr_gather( gr_t     gr,
+                     gr_size_t pos,
+                     gr_size_t count,
+                     gr_size_t offset,
+                     gr_size_t width,
+                     gr_d      buf );
 
 
 
@@ -525,6 +867,26 @@ int gr_is_empty( gr_t gr );
 int gr_is_full( gr_t gr );
 
 
+/**
+ * Return shared status.
+ *
+ * @param gr Gromer.
+ *
+ * @return 1 if storage is shared (copy-on-write), 0 if not.
+ */
+int gr_is_shared( gr_t gr );
+
+
+/**
+ * Return frozen status.
+ *
+ * @param gr Gromer.
+ *
+ * @return 1 if frozen (immutable), 0 if not.
+ */
+int gr_is_frozen( gr_t gr );
+
+
 /**
  * Find item from Gromer.
  *
@@ -567,6 +929,343 @@ void gr_set_local( gr_t gr, int val );
 int gr_get_local( gr_t gr );
 
 
+/**
+ * Set Gromer uninitialized mode.
+ *
+ * In uninitialized mode slots beyond usage are not zero-filled when
+ * Gromer grows. Mode is preserved over resizes. Leaving uninitialized
+ * mode zero-fills slots beyond usage, hence a Gromer created with
+ * gr_new_uninit() can be filled first and then set to default mode.
+ *
+ * @param gr  Gromer.
+ * @param val Uninitialized (or not).
+ */
+void gr_set_uninit( gr_t gr, int val );
+
+
+/**
+ * Return Gromer uninitialized mode.
+ *
+ * @param gr Gromer.
+ *
+ * @return 1 if uninitialized (else 0).
+ */
+int gr_get_uninit( gr_t gr );
+
+
+/**
+ * Set Gromer storage as external.
+ *
+ * Storage is resized and released with the resize function, e.g. the
+ * storage is a memory mapped file. Hook is stored to gr_ext_s just
+ * before the Gromer struct, i.e. caller must reserve space for it.
+ *
+ * Gromer with external storage is also local, i.e. storage is not
+ * shared by copy-on-write or handed over by gr_drain().
+ *
+ * @param gr     Gromer.
+ * @param resize Resize function.
+ * @param state  Resize function state.
+ */
+void gr_set_external( gr_t gr, gr_resize_fn_p resize, gr_d state );
+
+
+/**
+ * Return external storage hook.
+ *
+ * @param gr Gromer.
+ *
+ * @return Hook (or NULL if storage is not external).
+ */
+gr_ext_s* gr_get_external( gr_t gr );
+
+
+/**
+ * Set allocation observer.
+ *
+ * Observer is global, and it is called for heap and page allocations
+ * of Gromer creation and resize (see gromer_prof.h). Resize of Gromer
+ * with external storage is reported as well, and its time includes the
+ * resize function. Observer must be thread safe.
+ *
+ * @param fn Observer (NULL for none).
+ *
+ * @return Previous observer.
+ */
+gr_observe_fn_p gr_set_observer( gr_observe_fn_p fn );
+
+
+/**
+ * Get allocation observer.
+ *
+ * For reporting allocations made outside Gromer core, e.g. by
+ * gr_new_numa().
+ *
+ * @return Observer (or NULL).
+ */
+gr_observe_fn_p gr_get_observer( void );
+
+
+
+/* ------------------------------------------------------------
+ * Heap (priority queue):
+ *
+ * Gromer items are kept in d-ary (GR_HEAP_ARITY) min-heap order. Heap
+ * functions take either a compare function, which gets items (not
+ * references to items) and returns negative if "a" is smaller, or a
+ * key function ("_by" variants), which extracts unsigned key from an
+ * item.
+ */
+
+
+/**
+ * Arrange Gromer items to heap order.
+ *
+ * @param gp      Gromer reference.
+ * @param compare Compare function.
+ */
+void gr_heapify( gr_p gp, gr_compare_fn_p compare );
+
+
+/**
+ * Push item to heap.
+ *
+ * @param gp      Gromer reference.
+ * @param item    Item to push.
+ * @param compare Compare function.
+ */
+void gr_heap_push( gr_p gp, gr_d item, gr_compare_fn_p compare );
+
+
+/**
+ * Pop smallest item from heap.
+ *
+ * @param gp      Gromer reference.
+ * @param compare Compare function.
+ *
+ * @return Smallest item (or NULL).
+ */
+gr_d gr_heap_pop( gr_p gp, gr_compare_fn_p compare );
+
+
+/**
+ * Return smallest item of heap.
+ *
+ * @param gr Gromer.
+ *
+ * @return Smallest item (or NULL).
+ */
+gr_d gr_heap_peek( gr_t gr );
+
+
+/**
+ * Restore heap order after the key of item at position was decreased.
+ *
+ * @param gp      Gromer reference.
+ * @param pos     Position of decreased item.
+ * @param compare Compare function.
+ *
+ * @return New position of item.
+ */
+gr_size_t gr_heap_decrease( gr_p gp, gr_pos_t pos, gr_compare_fn_p compare );
+
+
+/**
+ * Arrange Gromer items to heap order by key.
+ *
+ * @param gp  Gromer reference.
+ * @param key Key function.
+ */
+void gr_heapify_by( gr_p gp, gr_key_fn_p key );
+
+
+/**
+ * Push item to heap by key.
+ *
+ * @param gp   Gromer reference.
+ * @param item Item to push.
+ * @param key  Key function.
+ */
+void gr_heap_push_by( gr_p gp, gr_d item, gr_key_fn_p key );
+
+
+/**
+ * Pop item with smallest key from heap.
+ *
+ * @param gp  Gromer reference.
+ * @param key Key function.
+ *
+ * @return Smallest item (or NULL).
+ */
+gr_d gr_heap_pop_by( gr_p gp, gr_key_fn_p key );
+
+
+/**
+ * Restore heap order after the key of item at position was decreased.
+ *
+ * @param gp  Gromer reference.
+ * @param pos Position of decreased item.
+ * @param key Key function.
+ *
+ * @return New position of item.
+ */
+gr_size_t gr_heap_decrease_by( gr_p gp, gr_pos_t pos, gr_key_fn_p key );
+
+
+
+/* ------------------------------------------------------------
+ * Selection:
+ *
+ * Compare and key functions follow the heap functions.
+ */
+
+
+/**
+ * Place nth smallest item to position nth (nth_element).
+ *
+ * Introselect is used, i.e. expected time is O(n). Items before nth
+ * are not bigger and items after nth are not smaller than the nth
+ * item.
+ *
+ * @param gp      Gromer reference.
+ * @param nth     Position.
+ * @param compare Compare function.
+ */
+void gr_select( gr_p gp, gr_size_t nth, gr_compare_fn_p compare );
+
+
+/**
+ * Place nth smallest item to position nth by key.
+ *
+ * @param gp  Gromer reference.
+ * @param nth Position.
+ * @param key Key function.
+ */
+void gr_select_by( gr_p gp, gr_size_t nth, gr_key_fn_p key );
+
+
+/**
+ * Sort only the k smallest items to the first k positions.
+ *
+ * Order of the remaining items is unspecified.
+ *
+ * @param gp      Gromer reference.
+ * @param k       Item count.
+ * @param compare Compare function.
+ */
+void gr_partial_sort( gr_p gp, gr_size_t k, gr_compare_fn_p compare );
+
+
+/**
+ * Sort only the k smallest items to the first k positions by key.
+ *
+ * @param gp  Gromer reference.
+ * @param k   Item count.
+ * @param key Key function.
+ */
+void gr_partial_sort_by( gr_p gp, gr_size_t k, gr_key_fn_p key );
+
+
+/**
+ * Push item to streaming top-k Gromer.
+ *
+ * Gromer keeps the k smallest items pushed so far, in a bounded heap
+ * with the biggest kept item first. If "*gp" is NULL, Gromer is
+ * created.
+ *
+ * @param gp      Gromer reference.
+ * @param k       Number of items to keep.
+ * @param item    Item to push.
+ * @param compare Compare function.
+ *
+ * @return Item that dropped out of top-k (or NULL).
+ */
+gr_d gr_topk_push( gr_p gp, gr_size_t k, gr_d item, gr_compare_fn_p compare );
+
+
+/**
+ * Push item to streaming top-k Gromer by key.
+ *
+ * @param gp   Gromer reference.
+ * @param k    Number of items to keep.
+ * @param item Item to push.
+ * @param key  Key function.
+ *
+ * @return Item that dropped out of top-k (or NULL).
+ */
+gr_d gr_topk_push_by( gr_p gp, gr_size_t k, gr_d item, gr_key_fn_p key );
+
+
+/**
+ * Sort top-k Gromer to ascending order.
+ *
+ * Gromer is not a top-k heap after sorting.
+ *
+ * @param gp      Gromer reference.
+ * @param compare Compare function.
+ */
+void gr_topk_sort( gr_p gp, gr_compare_fn_p compare );
+
+
+/**
+ * Sort top-k Gromer to ascending order by key.
+ *
+ * @param gp  Gromer reference.
+ * @param key Key function.
+ */
+void gr_topk_sort_by( gr_p gp, gr_key_fn_p key );
+
+
+
+/* ------------------------------------------------------------
+ * Merge:
+ */
+
+
+/**
+ * Merge sorted Gromers to new sorted Gromer.
+ *
+ * Inputs are merged with a loser tree in O(n log k) time. Output is
+ * reserved to the exact total size in advance. Order of equal items
+ * follows the input order. Compare function gets items and returns
+ * negative if "a" is smaller (as with heap functions).
+ *
+ * @param grs     Sorted Gromers.
+ * @param count   Gromer count.
+ * @param compare Compare function.
+ * @param dedup   Drop duplicates (equal to previous output), if non-zero.
+ *
+ * @return Merged Gromer.
+ */
+gr_t gr_merge( gr_t* grs, gr_size_t count, gr_compare_fn_p compare, int dedup );
+
+
+/**
+ * Merge spans of sorted Gromers to memory.
+ *
+ * Span "i" is the items from "lo[i]" to "hi[i]" (exclusive) of
+ * "grs[i]". This is the building block of gr_merge(), and it can be
+ * used to merge key ranges in parallel.
+ *
+ * @param dst     Destination array (with room for all span items).
+ * @param grs     Sorted Gromers.
+ * @param lo      Span start indeces.
+ * @param hi      Span end indeces.
+ * @param count   Gromer count.
+ * @param compare Compare function.
+ * @param dedup   Drop duplicates, if non-zero.
+ *
+ * @return Number of items written.
+ */
+gr_size_t gr_merge_span( gr_d*           dst,
+                         gr_t*           grs,
+                         const gr_size_t* lo,
+                         const gr_size_t* hi,
+                         gr_size_t       count,
+                         gr_compare_fn_p compare,
+                         int             dedup );
+
+
 
 /* ------------------------------------------------------------
  * Utilities:
@@ -576,8 +1275,8 @@ int gr_get_local( gr_t gr );
 /**
  * Allocate number of pages of memory.
  *
- * Returned memory is cleared. If count is 0, return size of memory
- * page.
+ * Returned memory is cleared, unless GR_UNINIT is set. If count is
+ * 0, return size of memory page.
  *
  * @param count[in] Page count.
  * @param mem[out]  Reference to memory.
@@ -590,4 +1289,183 @@ gr_size_t gr_alloc_pages( gr_size_t count, gr_d* mem );
 void gr_void_assert( void );
 
 
+
+/* ------------------------------------------------------------
+ * Value Gromer:
+ */
+
+
+/**
+ * Create Value Gromer with default size (GR_DEFAULT_SIZE).
+ *
+ * @param unit Element size in bytes.
+ *
+ * @return Value Gromer.
+ */
+gv_t gv_new( gr_size_t unit );
+
+
+/**
+ * Create Value Gromer with size.
+ *
+ * @param unit Element size in bytes.
+ * @param size Initial size (elements).
+ *
+ * @return Value Gromer.
+ */
+gv_t gv_new_sized( gr_size_t unit, gr_size_t size );
+
+
+/**
+ * Use existing memory allocation for Value Gromer.
+ *
+ * Value Gromer is marked local, i.e. it is not freed by
+ * gv_destroy(), and it is relocated to heap when more space is
+ * needed. Allocation must be aligned to GV_ALIGN.
+ *
+ * @param mem  Allocation for Value Gromer.
+ * @param size Allocation size (in bytes).
+ * @param unit Element size in bytes.
+ *
+ * @return Value Gromer.
+ */
+gv_t gv_use( gr_d mem, gr_size_t size, gr_size_t unit );
+
+
+/**
+ * Destroy Value Gromer.
+ *
+ * @param gp Value Gromer reference.
+ */
+void gv_destroy( gv_p gp );
+
+
+/**
+ * Resize Value Gromer to new_size.
+ *
+ * If new_size is smaller than usage, no action is performed.
+ *
+ * @param gp       Value Gromer reference.
+ * @param new_size Requested size.
+ */
+void gv_resize( gv_p gp, gr_size_t new_size );
+
+
+/**
+ * Push element (copy) to end of container.
+ *
+ * @param gp   Value Gromer reference.
+ * @param item Element to copy.
+ */
+void gv_push( gv_p gp, const void* item );
+
+
+/**
+ * Pop element from end of container.
+ *
+ * Returned element is valid until container is modified.
+ *
+ * @param gv Value Gromer.
+ *
+ * @return Popped element (or NULL).
+ */
+gr_d gv_pop( gv_t gv );
+
+
+/**
+ * Reset Value Gromer to empty.
+ *
+ * @param gv Value Gromer.
+ */
+void gv_reset( gv_t gv );
+
+
+/**
+ * Insert element (copy) to given position.
+ *
+ * @param gp   Value Gromer reference.
+ * @param pos  Position.
+ * @param item Element to copy.
+ */
+void gv_insert_at( gv_p gp, gr_pos_t pos, const void* item );
+
+
+/**
+ * Delete element from position.
+ *
+ * @param gv   Value Gromer.
+ * @param pos  Position.
+ * @param item Copy of deleted element (or NULL).
+ *
+ * @return 1 if element was deleted.
+ */
+int gv_delete_at( gv_t gv, gr_pos_t pos, gr_d item );
+
+
+/**
+ * Sort Value Gromer elements.
+ *
+ * Compare function gets pointers to elements.
+ *
+ * @param gv      Value Gromer.
+ * @param compare Compare function.
+ */
+void gv_sort( gv_t gv, gr_compare_fn_p compare );
+
+
+/**
+ * Return count of container usage.
+ *
+ * @param gv Value Gromer.
+ *
+ * @return Usage count.
+ */
+gr_size_t gv_used( gv_t gv );
+
+
+/**
+ * Return Value Gromer reservation size.
+ *
+ * @param gv Value Gromer.
+ *
+ * @return Reservation size.
+ */
+gr_size_t gv_size( gv_t gv );
+
+
+/**
+ * Return element size.
+ *
+ * @param gv Value Gromer.
+ *
+ * @return Element size in bytes.
+ */
+gr_size_t gv_unit( gv_t gv );
+
+
+/**
+ * Return nth element.
+ *
+ * @param gv  Value Gromer.
+ * @param pos Element position.
+ *
+ * @return Pointer to element (or NULL).
+ */
+gr_d gv_nth( gv_t gv, gr_pos_t pos );
+
+
+/**
+ * Return Value Gromer local mode.
+ *
+ * @param gv Value Gromer.
+ *
+ * @return 1 if local (else 0).
+ */
+int gv_get_local( gv_t gv );
+
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,222 @@
+#ifndef GROMER_ALGO_H
+#define GROMER_ALGO_H
+
+/**
+ * @file   gromer_algo.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 13:26:50 2026
+ *
+ * @brief  Gromer algorithms specialized for item type.
+ *
+ * GR_DEFINE_ALGOS generates typed algorithms where the comparison is
+ * an inline expression instead of a compare function call. Item type
+ * must be a pointer or an integer type that fits to gr_d.
+ *
+ * Comparison expression is a "less-than" expression of items "a" and
+ * "b", e.g.:
+ *
+ *     GR_DEFINE_ALGOS( str, char*, strcmp( a, b ) < 0 )
+ *
+ * generates:
+ *
+ *     void      str_sort( gr_p gp );
+ *     gr_pos_t  str_search( gr_t gr, char* ref );
+ *     gr_pos_t  str_find_with( gr_t gr, char* ref );
+ *     gr_size_t str_remove_if( gr_p gp, int ( *pred )( char* a, gr_d arg ), gr_d arg );
+ *
+ * Sort is introsort (median-of-three quicksort, insertion sort for
+ * small ranges, and heap sort at depth limit). Search is binary
+ * search of sorted Gromer, and find_with is linear search for item
+ * equivalent to "ref". remove_if removes items for which predicate
+ * is true, preserving the order of the rest. sort and remove_if make
+ * shared storage private first (see gr_unshare()), and they assert
+ * for frozen Gromer.
+ *
+ * See gromer_algo.hpp for C++ templates.
+ *
+ */
+
+#include "gromer.h"
+
+
+/** Small range size for insertion sort. */
+#define GR_ALGO_SMALL 16
+
+
+/** Define typed algorithms for item type. */
+#define GR_DEFINE_ALGOS( name, type, cmp_expr )                         \
+                                                                        \
+    static inline int name##_less_( gr_d x, gr_d y )                    \
+    {                                                                   \
+        type a = (type)( x );                                           \
+        type b = (type)( y );                                           \
+        (void)a;                                                        \
+        (void)b;                                                        \
+        return ( cmp_expr );                                            \
+    }                                                                   \
+                                                                        \
+    static inline gr_t name##_writable_( gr_p gp )                      \
+    {                                                                   \
+        gr_t gr = gr_unshare( gp );                                     \
+        gr_assert( !gr_is_frozen( gr ) );                               \
+        return gr_is_frozen( gr ) ? NULL : gr;                          \
+    }                                                                   \
+                                                                        \
+    static inline void name##_insertion_( gr_d* d, gr_size_t lo, gr_size_t hi ) \
+    {                                                                   \
+        for ( gr_size_t i = lo + 1; i < hi; i++ ) {                     \
+            gr_d      t = d[ i ];                                       \
+            gr_size_t j = i;                                            \
+            while ( j > lo && name##_less_( t, d[ j - 1 ] ) ) {         \
+                d[ j ] = d[ j - 1 ];                                    \
+                j--;                                                    \
+            }                                                           \
+            d[ j ] = t;                                                 \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    static inline void name##_heap_sort_( gr_d* d, gr_size_t lo, gr_size_t hi ) \
+    {                                                                   \
+        gr_d*     b = &d[ lo ];                                         \
+        gr_size_t n = hi - lo;                                          \
+        for ( gr_size_t end = n, start = n / 2;; ) {                    \
+            gr_size_t r;                                                \
+            gr_d      t;                                                \
+            if ( start > 0 ) {                                          \
+                r = --start;                                            \
+            } else {                                                    \
+                if ( end <= 1 )                                         \
+                    break;                                              \
+                end--;                                                  \
+                t = b[ end ];                                           \
+                b[ end ] = b[ 0 ];                                      \
+                b[ 0 ] = t;                                             \
+                r = 0;                                                  \
+            }                                                           \
+            t = b[ r ];                                                 \
+            for ( ;; ) {                                                \
+                gr_size_t c = 2 * r + 1;                                \
+                if ( c >= end )                                         \
+                    break;                                              \
+                if ( c + 1 < end && name##_less_( b[ c ], b[ c + 1 ] ) ) \
+                    c++;                                                \
+                if ( !name##_less_( t, b[ c ] ) )                       \
+                    break;                                              \
+                b[ r ] = b[ c ];                                        \
+                r = c;                                                  \
+            }                                                           \
+            b[ r ] = t;                                                 \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    static inline gr_size_t name##_partition_( gr_d* d, gr_size_t lo, gr_size_t hi ) \
+    {                                                                   \
+        gr_size_t m = lo + ( hi - lo ) / 2;                             \
+        gr_size_t x = lo + 1;                                           \
+        gr_size_t z = hi - 1;                                           \
+        gr_size_t med;                                                  \
+        gr_d      t;                                                    \
+        if ( name##_less_( d[ m ], d[ x ] ) ) {                         \
+            med = x;                                                    \
+            x = m;                                                      \
+            m = med;                                                    \
+        }                                                               \
+        if ( name##_less_( d[ z ], d[ m ] ) )                           \
+            med = name##_less_( d[ z ], d[ x ] ) ? x : z;               \
+        else                                                            \
+            med = m;                                                    \
+        t = d[ lo ];                                                    \
+        d[ lo ] = d[ med ];                                             \
+        d[ med ] = t;                                                   \
+        gr_d      p = d[ lo ];                                          \
+        gr_size_t i = lo;                                               \
+        gr_size_t j = hi - 1;                                           \
+        for ( ;; ) {                                                    \
+            while ( name##_less_( d[ i ], p ) )                         \
+                i++;                                                    \
+            while ( name##_less_( p, d[ j ] ) )                         \
+                j--;                                                    \
+            if ( i >= j )                                               \
+                return j + 1;                                           \
+            t = d[ i ];                                                 \
+            d[ i ] = d[ j ];                                            \
+            d[ j ] = t;                                                 \
+            i++;                                                        \
+            j--;                                                        \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    static inline void name##_intro_( gr_d* d, gr_size_t lo, gr_size_t hi, gr_size_t depth ) \
+    {                                                                   \
+        while ( hi - lo > GR_ALGO_SMALL ) {                             \
+            if ( depth-- == 0 ) {                                       \
+                name##_heap_sort_( d, lo, hi );                         \
+                return;                                                 \
+            }                                                           \
+            gr_size_t s = name##_partition_( d, lo, hi );               \
+            if ( s - lo < hi - s ) {                                    \
+                name##_intro_( d, lo, s, depth );                       \
+                lo = s;                                                 \
+            } else {                                                    \
+                name##_intro_( d, s, hi, depth );                       \
+                hi = s;                                                 \
+            }                                                           \
+        }                                                               \
+        name##_insertion_( d, lo, hi );                                 \
+    }                                                                   \
+                                                                        \
+    static inline void name##_sort( gr_p gp )                           \
+    {                                                                   \
+        gr_t      gr = name##_writable_( gp );                          \
+        gr_size_t depth = 0;                                            \
+        if ( gr == NULL )                                               \
+            return;                                                     \
+        for ( gr_size_t n = gr->used; n > 1; n >>= 1 )                  \
+            depth += 2;                                                 \
+        name##_intro_( gr->data, 0, gr->used, depth );                  \
+    }                                                                   \
+                                                                        \
+    static inline gr_pos_t name##_search( gr_t gr, type ref )           \
+    {                                                                   \
+        gr_size_t lo = 0;                                               \
+        gr_size_t hi = gr->used;                                        \
+        while ( lo < hi ) {                                             \
+            gr_size_t mid = lo + ( hi - lo ) / 2;                       \
+            if ( name##_less_( gr->data[ mid ], (gr_d)ref ) )           \
+                lo = mid + 1;                                           \
+            else                                                        \
+                hi = mid;                                               \
+        }                                                               \
+        if ( lo < gr->used && !name##_less_( (gr_d)ref, gr->data[ lo ] ) ) \
+            return lo;                                                  \
+        else                                                            \
+            return GR_NOT_INDEX;                                        \
+    }                                                                   \
+                                                                        \
+    static inline gr_pos_t name##_find_with( gr_t gr, type ref )        \
+    {                                                                   \
+        for ( gr_size_t i = 0; i < gr->used; i++ ) {                    \
+            if ( !name##_less_( gr->data[ i ], (gr_d)ref )              \
+                 && !name##_less_( (gr_d)ref, gr->data[ i ] ) )         \
+                return i;                                               \
+        }                                                               \
+        return GR_NOT_INDEX;                                            \
+    }                                                                   \
+                                                                        \
+    static inline gr_size_t name##_remove_if( gr_p gp,                  \
+                                              int ( *pred )( type a, gr_d arg ), \
+                                              gr_d arg )                \
+    {                                                                   \
+        gr_t      gr = name##_writable_( gp );                          \
+        gr_size_t wr = 0;                                               \
+        if ( gr == NULL )                                               \
+            return 0;                                                   \
+        for ( gr_size_t i = 0; i < gr->used; i++ ) {                    \
+            if ( !pred( (type)gr->data[ i ], arg ) )                    \
+                gr->data[ wr++ ] = gr->data[ i ];                       \
+        }                                                               \
+        return gr_drop( gp, gr->used - wr );                            \
+    }
+
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef GROMER_ALGO_HPP
+#define GROMER_ALGO_HPP
+
+/**
+ * @file   gromer_algo.hpp
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 13:26:50 2026
+ *
+ * @brief  Gromer algorithms specialized for item type (C++).
+ *
+ * C++ equivalent of GR_DEFINE_ALGOS (gromer_algo.h). Item type "T"
+ * must be a pointer or an integer type that fits to gr_d, and "less"
+ * is any callable "bool( T a, T b )", which is inlined.
+ *
+ *     gromer::sort<char*>( &gr, []( char* a, char* b ) { return strcmp( a, b ) < 0; } );
+ *
+ */
+
+#include <algorithm>
+
+#include "gromer.h"
+
+
+namespace gromer
+{
+
+/** Make storage private and return it (or NULL if frozen, asserts). */
+inline gr_t writable( gr_p gp )
+{
+    gr_t gr = gr_unshare( gp );
+    gr_assert( !gr_is_frozen( gr ) );
+    return gr_is_frozen( gr ) ? NULL : gr;
+}
+
+
+/** Convert item to type. */
+template <typename T>
+inline T item_as( gr_d item )
+{
+    return (T)( item );
+}
+
+
+/**
+ * Sort Gromer items (introsort).
+ *
+ * @param gp   Gromer reference.
+ * @param less Less-than function object.
+ */
+template <typename T, typename Less>
+inline void sort( gr_p gp, Less less )
+{
+    gr_t gr = writable( gp );
+    if ( gr == NULL )
+        return;
+    std::sort( gr->data, gr->data + gr->used, [&]( gr_d x, gr_d y ) {
+        return less( item_as<T>( x ), item_as<T>( y ) );
+    } );
+}
+
+
+/**
+ * Binary search of sorted Gromer.
+ *
+ * @param gr   Gromer.
+ * @param ref  Item to search.
+ * @param less Less-than function object.
+ *
+ * @return Item index (or GR_NOT_INDEX).
+ */
+template <typename T, typename Less>
+inline gr_pos_t search( gr_t gr, T ref, Less less )
+{
+    gr_d* end = gr->data + gr->used;
+    gr_d* pos = std::lower_bound( gr->data, end, (gr_d)ref, [&]( gr_d x, gr_d y ) {
+        return less( item_as<T>( x ), item_as<T>( y ) );
+    } );
+
+    if ( pos != end && !less( ref, item_as<T>( *pos ) ) )
+        return pos - gr->data;
+    else
+        return GR_NOT_INDEX;
+}
+
+
+/**
+ * Find item equivalent to "ref".
+ *
+ * @param gr   Gromer.
+ * @param ref  Item to find.
+ * @param less Less-than function object.
+ *
+ * @return Item index (or GR_NOT_INDEX).
+ */
+template <typename T, typename Less>
+inline gr_pos_t find_with( gr_t gr, T ref, Less less )
+{
+    for ( gr_size_t i = 0; i < gr->used; i++ ) {
+        T item = item_as<T>( gr->data[ i ] );
+        if ( !less( item, ref ) && !less( ref, item ) )
+            return i;
+    }
+
+    return GR_NOT_INDEX;
+}
+
+
+/**
+ * Remove items for which predicate is true.
+ *
+ * @param gp   Gromer reference.
+ * @param pred Predicate function object.
+ *
+ * @return Number of items removed.
+ */
+template <typename T, typename Pred>
+inline gr_size_t remove_if( gr_p gp, Pred pred )
+{
+    gr_t gr = writable( gp );
+    if ( gr == NULL )
+        return 0;
+
+    gr_d* end = std::remove_if( gr->data, gr->data + gr->used, [&]( gr_d x ) {
+        return pred( item_as<T>( x ) );
+    } );
+
+    return gr_drop( gp, ( gr->data + gr->used ) - end );
+}
+
+} // namespace gromer
+
+
+#endif
@@ -0,0 +1,293 @@
+/**
+ * @file   gromer_bloom.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 21:36:05 2026
+ *
+ * @brief  Bloom Gromer - Gromer with Bloom filter for find.
+ *
+ */
+
+#include <string.h>
+
+#include "gromer_bloom.h"
+
+
+/** @cond gromer_none */
+#define GF_BLOCK_WORDS 8
+#define GF_BLOCK_BITS  512
+/** @endcond gromer_none */
+
+
+static uint64_t gf_hash( gr_d item );
+static uint64_t* gf_block( gf_t gf, uint64_t hash );
+static void gf_add( gf_t gf, gr_d item );
+static void gf_prepare( gf_t gf );
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+gf_t gf_new( void )
+{
+    return gf_new_sized( GR_DEFAULT_SIZE, GF_DEFAULT_BITS );
+}
+
+
+gf_t gf_new_sized( gr_size_t size, gr_size_t bits )
+{
+    gf_t gf;
+
+    gr_assert( bits >= 1 && bits <= 64 );
+
+    gf = (gf_t)gr_malloc( sizeof( gf_s ) );
+    gf->gr = gr_new_sized( size );
+    gf->bits = NULL;
+    gf->per_item = bits;
+    gf->misses = 0;
+    gf->false_hits = 0;
+
+    /* Optimal hash count is bits * ln(2). */
+    gf->hashes = ( bits * 693 + 500 ) / 1000;
+    if ( gf->hashes == 0 )
+        gf->hashes = 1;
+
+    gf_rebuild( gf );
+
+    return gf;
+}
+
+
+void gf_destroy( gf_p gp )
+{
+    if ( *gp == NULL )
+        return;
+
+    gr_destroy( &( *gp )->gr );
+    gr_free( ( *gp )->bits );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Editing:
+ */
+
+
+void gf_push( gf_t gf, gr_d item )
+{
+    gr_push( &gf->gr, item );
+    gf_prepare( gf );
+    gf_add( gf, item );
+}
+
+
+gr_d gf_pop( gf_t gf )
+{
+    if ( gr_used( gf->gr ) == 0 )
+        return NULL;
+
+    gf->deleted++;
+    return gr_pop( &gf->gr );
+}
+
+
+void gf_insert_at( gf_t gf, gr_pos_t pos, gr_d item )
+{
+    gr_insert_at( &gf->gr, pos, item );
+    gf_prepare( gf );
+    gf_add( gf, item );
+}
+
+
+gr_d gf_delete_at( gf_t gf, gr_pos_t pos )
+{
+    gr_d item;
+
+    if ( gr_used( gf->gr ) == 0 )
+        return NULL;
+
+    item = gr_nth( gf->gr, pos );
+    gr_delete_at( &gf->gr, pos );
+    gf->deleted++;
+
+    return item;
+}
+
+
+void gf_rebuild( gf_t gf )
+{
+    gr_size_t blocks;
+
+    blocks = ( gr_size( gf->gr ) * gf->per_item + GF_BLOCK_BITS - 1 ) / GF_BLOCK_BITS;
+
+    if ( gf->bits == NULL || blocks != gf->blocks ) {
+        gr_free( gf->bits );
+        gf->bits = (uint64_t*)gr_malloc( blocks * GF_BLOCK_WORDS * sizeof( uint64_t ) );
+        gf->blocks = blocks;
+    }
+
+    memset( gf->bits, 0, gf->blocks * GF_BLOCK_WORDS * sizeof( uint64_t ) );
+    gf->deleted = 0;
+
+    for ( gr_size_t i = 0; i < gr_used( gf->gr ); i++ )
+        gf_add( gf, gf->gr->data[ i ] );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+gr_size_t gf_used( gf_t gf )
+{
+    return gr_used( gf->gr );
+}
+
+
+gr_d gf_nth( gf_t gf, gr_pos_t pos )
+{
+    return gr_nth( gf->gr, pos );
+}
+
+
+gr_pos_t gf_find( gf_t gf, gr_d item )
+{
+    gr_pos_t ret;
+
+    if ( gf->deleted * 100 > gr_used( gf->gr ) * GF_REBUILD_LIMIT )
+        gf_rebuild( gf );
+
+    if ( !gf_maybe( gf, item ) ) {
+        gf->misses++;
+        return GR_NOT_INDEX;
+    }
+
+    ret = gr_find( gf->gr, item );
+    if ( ret == GR_NOT_INDEX )
+        gf->false_hits++;
+
+    return ret;
+}
+
+
+int gf_maybe( gf_t gf, gr_d item )
+{
+    uint64_t  hash = gf_hash( item );
+    uint64_t* block = gf_block( gf, hash );
+    uint32_t  h1 = (uint32_t)hash;
+    uint32_t  h2 = (uint32_t)( hash >> 32 ) | 1;
+
+    for ( gr_size_t i = 0; i < gf->hashes; i++ ) {
+        uint32_t bit = ( h1 + i * h2 ) & ( GF_BLOCK_BITS - 1 );
+        if ( !( block[ bit >> 6 ] & ( 1ULL << ( bit & 0x3F ) ) ) )
+            return 0;
+    }
+
+    return 1;
+}
+
+
+double gf_fpr( gf_t gf )
+{
+    gr_size_t set = 0;
+    double    fill;
+    double    ret = 1.0;
+
+    for ( gr_size_t i = 0; i < gf->blocks * GF_BLOCK_WORDS; i++ )
+        set += __builtin_popcountll( gf->bits[ i ] );
+
+    fill = (double)set / ( gf->blocks * GF_BLOCK_BITS );
+    for ( gr_size_t i = 0; i < gf->hashes; i++ )
+        ret *= fill;
+
+    return ret;
+}
+
+
+gr_t gf_gromer( gf_t gf )
+{
+    return gf->gr;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Hash item (64-bit finalizer of MurmurHash3).
+ *
+ * @param item Item.
+ *
+ * @return Hash.
+ */
+static uint64_t gf_hash( gr_d item )
+{
+    uint64_t h = (uint64_t)(uintptr_t)item;
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+
+/**
+ * Return filter block for hash.
+ *
+ * @param gf   Bloom Gromer.
+ * @param hash Item hash.
+ *
+ * @return Block.
+ */
+static uint64_t* gf_block( gf_t gf, uint64_t hash )
+{
+    /* Multiply-shift range reduction with the high bits. */
+    gr_size_t idx = ( ( hash >> 40 ) * gf->blocks ) >> 24;
+
+    return &gf->bits[ idx * GF_BLOCK_WORDS ];
+}
+
+
+/**
+ * Add item to filter.
+ *
+ * @param gf   Bloom Gromer.
+ * @param item Item.
+ */
+static void gf_add( gf_t gf, gr_d item )
+{
+    uint64_t  hash = gf_hash( item );
+    uint64_t* block = gf_block( gf, hash );
+    uint32_t  h1 = (uint32_t)hash;
+    uint32_t  h2 = (uint32_t)( hash >> 32 ) | 1;
+
+    for ( gr_size_t i = 0; i < gf->hashes; i++ ) {
+        uint32_t bit = ( h1 + i * h2 ) & ( GF_BLOCK_BITS - 1 );
+        block[ bit >> 6 ] |= 1ULL << ( bit & 0x3F );
+    }
+}
+
+
+/**
+ * Resize filter, if Gromer has grown.
+ *
+ * @param gf Bloom Gromer.
+ */
+static void gf_prepare( gf_t gf )
+{
+    if ( gr_size( gf->gr ) * gf->per_item > gf->blocks * GF_BLOCK_BITS )
+        gf_rebuild( gf );
+}
@@ -0,0 +1,225 @@
+#ifndef GROMER_BLOOM_H
+#define GROMER_BLOOM_H
+
+/**
+ * @file   gromer_bloom.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 21:36:05 2026
+ *
+ * @brief  Bloom Gromer - Gromer with Bloom filter for find.
+ *
+ * Items are recorded to a blocked Bloom filter, where all bits of an
+ * item are within one cache line sized block. gf_find() checks the
+ * filter first, and definite misses return without scanning the
+ * items.
+ *
+ * Filter is updated on push and insert. Deleted items stay in the
+ * filter (as false positives), and the filter is rebuilt lazily by
+ * gf_find() when the deleted count reaches GF_REBUILD_LIMIT percent
+ * of the items. Filter is resized (rebuilt) with the Gromer.
+ *
+ * Memory overhead is given as filter bits per item (slot). More bits
+ * give fewer false positives, e.g. 8 bits gives about 2% and 16 bits
+ * about 0.1%.
+ *
+ */
+
+#include "gromer.h"
+
+
+#ifndef GF_DEFAULT_BITS
+/** Default filter bits per item. */
+#define GF_DEFAULT_BITS 8
+#endif
+
+#ifndef GF_REBUILD_LIMIT
+/** Deleted percentage for lazy rebuild. */
+#define GF_REBUILD_LIMIT 25
+#endif
+
+
+/**
+ * Bloom Gromer struct.
+ */
+struct gf_struct_s
+{
+    gr_t      gr;         /**< Items. */
+    uint64_t* bits;       /**< Filter blocks (8 words each). */
+    gr_size_t blocks;     /**< Filter block count. */
+    gr_size_t per_item;   /**< Filter bits per item. */
+    gr_size_t hashes;     /**< Bits set per item. */
+    gr_size_t deleted;    /**< Deleted items since rebuild. */
+    gr_size_t misses;     /**< Finds rejected by filter. */
+    gr_size_t false_hits; /**< Finds passed by filter, but not found. */
+};
+typedef struct gf_struct_s gf_s; /**< Bloom Gromer struct. */
+typedef gf_s*              gf_t; /**< Bloom Gromer. */
+typedef gf_t*              gf_p; /**< Bloom Gromer reference. */
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+/**
+ * Create Bloom Gromer with default size (GR_DEFAULT_SIZE) and
+ * GF_DEFAULT_BITS.
+ *
+ * @return Bloom Gromer.
+ */
+gf_t gf_new( void );
+
+
+/**
+ * Create Bloom Gromer with size and filter bits per item.
+ *
+ * @param size Initial size.
+ * @param bits Filter bits per item (1-64).
+ *
+ * @return Bloom Gromer.
+ */
+gf_t gf_new_sized( gr_size_t size, gr_size_t bits );
+
+
+/**
+ * Destroy Bloom Gromer.
+ *
+ * @param gp Bloom Gromer reference.
+ */
+void gf_destroy( gf_p gp );
+
+
+
+/* ------------------------------------------------------------
+ * Editing:
+ */
+
+
+/**
+ * Push item to end of container.
+ *
+ * @param gf   Bloom Gromer.
+ * @param item Item to push.
+ */
+void gf_push( gf_t gf, gr_d item );
+
+
+/**
+ * Pop item from end of container.
+ *
+ * @param gf Bloom Gromer.
+ *
+ * @return Popped item (or NULL).
+ */
+gr_d gf_pop( gf_t gf );
+
+
+/**
+ * Insert item to position.
+ *
+ * @param gf   Bloom Gromer.
+ * @param pos  Position (negative from end).
+ * @param item Item to insert.
+ */
+void gf_insert_at( gf_t gf, gr_pos_t pos, gr_d item );
+
+
+/**
+ * Delete item at position.
+ *
+ * @param gf  Bloom Gromer.
+ * @param pos Position (negative from end).
+ *
+ * @return Deleted item (or NULL).
+ */
+gr_d gf_delete_at( gf_t gf, gr_pos_t pos );
+
+
+/**
+ * Rebuild filter from items.
+ *
+ * Rebuild is needed only if Gromer is modified directly (see
+ * gf_gromer()).
+ *
+ * @param gf Bloom Gromer.
+ */
+void gf_rebuild( gf_t gf );
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+/**
+ * Return item count.
+ *
+ * @param gf Bloom Gromer.
+ *
+ * @return Item count.
+ */
+gr_size_t gf_used( gf_t gf );
+
+
+/**
+ * Return item at position.
+ *
+ * @param gf  Bloom Gromer.
+ * @param pos Position (negative from end).
+ *
+ * @return Item.
+ */
+gr_d gf_nth( gf_t gf, gr_pos_t pos );
+
+
+/**
+ * Find item.
+ *
+ * @param gf   Bloom Gromer.
+ * @param item Item to find.
+ *
+ * @return Item index (or GR_NOT_INDEX).
+ */
+gr_pos_t gf_find( gf_t gf, gr_d item );
+
+
+/**
+ * Return true if filter may contain the item.
+ *
+ * @param gf   Bloom Gromer.
+ * @param item Item.
+ *
+ * @return 1 if item may exist, 0 if item does not exist.
+ */
+int gf_maybe( gf_t gf, gr_d item );
+
+
+/**
+ * Return estimated false positive rate of filter.
+ *
+ * Estimate is based on the fill ratio of the filter bits.
+ *
+ * @param gf Bloom Gromer.
+ *
+ * @return False positive rate (0.0-1.0).
+ */
+double gf_fpr( gf_t gf );
+
+
+/**
+ * Return Gromer.
+ *
+ * Gromer is owned by Bloom Gromer. If Gromer is modified directly,
+ * filter must be rebuilt with gf_rebuild().
+ *
+ * @param gf Bloom Gromer.
+ *
+ * @return Gromer.
+ */
+gr_t gf_gromer( gf_t gf );
+
+
+#endif
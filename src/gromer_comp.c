@@ -0,0 +1,229 @@
+/**
+ * @file   gromer_comp.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 19:14:48 2026
+ *
+ * @brief  Compressed Gromer - pointers as 32-bit arena offsets.
+ *
+ */
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "gromer_comp.h"
+
+
+static gr_size_t gz_norm_idx( gz_t gz, gr_pos_t idx );
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+gz_t gz_new( gr_d base, int shift )
+{
+    return gz_new_sized( base, shift, GR_DEFAULT_SIZE );
+}
+
+
+gz_t gz_new_sized( gr_d base, int shift, gr_size_t size )
+{
+    gz_t gz;
+
+    gr_assert( shift >= 0 && shift <= 3 );
+
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+    size = ( size + 1 ) & ~1ULL;
+
+    gz = (gz_t)gr_malloc( gz_struct_size( size ) );
+    gz->size = size;
+    gz->used = 0;
+    gz->base = (uint8_t*)base;
+    gz->shift = shift;
+
+    return gz;
+}
+
+
+void gz_destroy( gz_p gp )
+{
+    if ( *gp == NULL )
+        return;
+
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+void gz_resize( gz_p gp, gr_size_t new_size )
+{
+    new_size = ( new_size + 1 ) & ~1ULL;
+
+    if ( new_size < GR_MIN_SIZE || new_size < ( *gp )->used )
+        return;
+
+    *gp = (gz_t)gr_realloc( *gp, gz_struct_size( new_size ) );
+    ( *gp )->size = new_size;
+}
+
+
+void gz_push( gz_p gp, gr_d item )
+{
+    uint32_t off = gz_encode( *gp, item );
+
+    if ( ( *gp )->used >= ( *gp )->size )
+        gz_resize( gp, 2 * ( *gp )->size );
+
+    ( *gp )->data[ ( *gp )->used++ ] = off;
+}
+
+
+gr_d gz_pop( gz_t gz )
+{
+    if ( gz->used == 0 )
+        return NULL;
+
+    gz->used--;
+
+    return gz_decode( gz, gz->data[ gz->used ] );
+}
+
+
+void gz_sort( gz_t gz )
+{
+    uint32_t* tmp;
+    uint32_t* src = gz->data;
+    uint32_t* dst;
+    gr_size_t cnt[ 4 ][ 256 ];
+
+    if ( gz->used < 2 )
+        return;
+
+    tmp = (uint32_t*)gr_malloc( gz->used * sizeof( uint32_t ) );
+    dst = tmp;
+
+    /* LSD radix sort, four 8-bit digits. GZ_NULL sorts last. */
+    memset( cnt, 0, sizeof( cnt ) );
+    for ( gr_size_t i = 0; i < gz->used; i++ ) {
+        for ( int d = 0; d < 4; d++ )
+            cnt[ d ][ ( src[ i ] >> ( 8 * d ) ) & 0xFF ]++;
+    }
+
+    for ( int d = 0; d < 4; d++ ) {
+        gr_size_t sum = 0;
+        for ( gr_size_t b = 0; b < 256; b++ ) {
+            gr_size_t c = cnt[ d ][ b ];
+            cnt[ d ][ b ] = sum;
+            sum += c;
+        }
+        for ( gr_size_t i = 0; i < gz->used; i++ ) {
+            uint32_t v = src[ i ];
+            dst[ cnt[ d ][ ( v >> ( 8 * d ) ) & 0xFF ]++ ] = v;
+        }
+        uint32_t* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    /* Even pass count, hence result is back in data. */
+    gr_free( tmp );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+gr_size_t gz_used( gz_t gz )
+{
+    return gz->used;
+}
+
+
+gr_size_t gz_size( gz_t gz )
+{
+    return gz->size;
+}
+
+
+gr_d gz_nth( gz_t gz, gr_pos_t pos )
+{
+    if ( gz->used == 0 )
+        return NULL;
+
+    return gz_decode( gz, gz->data[ gz_norm_idx( gz, pos ) ] );
+}
+
+
+gr_pos_t gz_find( gz_t gz, gr_d item )
+{
+    uint32_t  off = gz_encode( gz, item );
+    gr_size_t i = 0;
+
+#ifdef __SSE2__
+    __m128i ref = _mm_set1_epi32( (int)off );
+    for ( ; i + 4 <= gz->used; i += 4 ) {
+        __m128i v = _mm_loadu_si128( (const __m128i*)&gz->data[ i ] );
+        int     m = _mm_movemask_epi8( _mm_cmpeq_epi32( v, ref ) );
+        if ( m )
+            return i + ( __builtin_ctz( m ) >> 2 );
+    }
+#endif
+
+    for ( ; i < gz->used; i++ ) {
+        if ( gz->data[ i ] == off )
+            return i;
+    }
+
+    return GR_NOT_INDEX;
+}
+
+
+uint32_t gz_encode( gz_t gz, gr_d item )
+{
+    gr_size_t off;
+
+    if ( item == NULL )
+        return GZ_NULL;
+
+    off = (uint8_t*)item - gz->base;
+    gr_assert( (uint8_t*)item >= gz->base );
+    gr_assert( ( off & ( ( 1ULL << gz->shift ) - 1 ) ) == 0 );
+    off >>= gz->shift;
+    gr_assert( off < GZ_NULL );
+
+    return (uint32_t)off;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Normalize (possibly negative) index.
+ *
+ * @param gz  Compressed Gromer.
+ * @param idx Index.
+ *
+ * @return Normalized index.
+ */
+static gr_size_t gz_norm_idx( gz_t gz, gr_pos_t idx )
+{
+    if ( idx < 0 )
+        idx += gz->used;
+
+    gr_assert( idx >= 0 && (gr_size_t)idx < gz->used );
+
+    return idx;
+}
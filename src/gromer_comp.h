@@ -0,0 +1,200 @@
+#ifndef GROMER_COMP_H
+#define GROMER_COMP_H
+
+/**
+ * @file   gromer_comp.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 19:14:48 2026
+ *
+ * @brief  Compressed Gromer - pointers as 32-bit arena offsets.
+ *
+ * Compressed Gromer stores pointers that point to one arena (e.g. a
+ * paged Gromer used with gr_alloc()). Item is stored as 32-bit offset
+ * from the arena base, scaled down by "1 << shift". Hence arena size
+ * is limited to 4G (shift 0) ... 32G (shift 3) bytes, and pointers
+ * must be aligned to the scale.
+ *
+ * Pointers are encoded on insertion and decoded on access, i.e. the
+ * API is in pointers. NULL is stored as GZ_NULL.
+ *
+ */
+
+#include "gromer.h"
+
+
+/** Encoded NULL. */
+#define GZ_NULL 0xFFFFFFFFU
+
+
+/**
+ * Compressed Gromer struct.
+ */
+struct gz_struct_s
+{
+    gr_size_t size;      /**< Reservation size for data (N mod 2==0). */
+    gr_size_t used;      /**< Used count for data. */
+    uint8_t*  base;      /**< Arena base. */
+    uint32_t  shift;     /**< Offset scale (log2). */
+    uint32_t  rsv;       /**< Reserved. */
+    uint32_t  data[ 0 ]; /**< Offset array. */
+};
+typedef struct gz_struct_s gz_s; /**< Compressed Gromer struct. */
+typedef gz_s*              gz_t; /**< Compressed Gromer. */
+typedef gz_t*              gz_p; /**< Compressed Gromer reference. */
+
+
+/** Compressed Gromer struct size for data size. */
+#define gz_struct_size( size ) ( sizeof( gz_s ) + ( ( size ) * sizeof( uint32_t ) ) )
+
+/** Decode offset to pointer. */
+#define gz_decode( gz, off )                                            \
+    ( ( ( off ) == GZ_NULL ) ? NULL : (gr_d)( ( gz )->base + ( (gr_size_t)( off ) << ( gz )->shift ) ) )
+
+/** Iterate over all items. */
+#define gz_each( gz, iter, cast )                                       \
+    for ( gr_size_t gr_idx = 0;                                         \
+          ( gr_idx < ( gz )->used ) && ( ( iter = ( cast )gz_decode( gz, ( gz )->data[ gr_idx ] ) ), 1 ); \
+          gr_idx++ )
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+/**
+ * Create Compressed Gromer with default size (GR_DEFAULT_SIZE).
+ *
+ * @param base  Arena base.
+ * @param shift Offset scale (log2, 0-3).
+ *
+ * @return Compressed Gromer.
+ */
+gz_t gz_new( gr_d base, int shift );
+
+
+/**
+ * Create Compressed Gromer with size.
+ *
+ * @param base  Arena base.
+ * @param shift Offset scale (log2, 0-3).
+ * @param size  Initial size.
+ *
+ * @return Compressed Gromer.
+ */
+gz_t gz_new_sized( gr_d base, int shift, gr_size_t size );
+
+
+/**
+ * Destroy Compressed Gromer.
+ *
+ * @param gp Compressed Gromer reference.
+ */
+void gz_destroy( gz_p gp );
+
+
+/**
+ * Resize Compressed Gromer to new_size.
+ *
+ * If new_size is smaller than usage, no action is performed.
+ *
+ * @param gp       Compressed Gromer reference.
+ * @param new_size Requested size.
+ */
+void gz_resize( gz_p gp, gr_size_t new_size );
+
+
+/**
+ * Push pointer to end of container.
+ *
+ * @param gp   Compressed Gromer reference.
+ * @param item Pointer (within arena, or NULL).
+ */
+void gz_push( gz_p gp, gr_d item );
+
+
+/**
+ * Pop pointer from end of container.
+ *
+ * @param gz Compressed Gromer.
+ *
+ * @return Pointer (or NULL).
+ */
+gr_d gz_pop( gz_t gz );
+
+
+/**
+ * Sort items by address.
+ *
+ * Radix sort over 32-bit offsets.
+ *
+ * @param gz Compressed Gromer.
+ */
+void gz_sort( gz_t gz );
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+/**
+ * Return used count.
+ *
+ * @param gz Compressed Gromer.
+ *
+ * @return Used count.
+ */
+gr_size_t gz_used( gz_t gz );
+
+
+/**
+ * Return size.
+ *
+ * @param gz Compressed Gromer.
+ *
+ * @return Size.
+ */
+gr_size_t gz_size( gz_t gz );
+
+
+/**
+ * Return nth pointer.
+ *
+ * @param gz  Compressed Gromer.
+ * @param pos Position (negative from end).
+ *
+ * @return Pointer (or NULL).
+ */
+gr_d gz_nth( gz_t gz, gr_pos_t pos );
+
+
+/**
+ * Find pointer.
+ *
+ * Search compares encoded offsets, four at a time with SSE2.
+ *
+ * @param gz   Compressed Gromer.
+ * @param item Pointer to find.
+ *
+ * @return Item index (or GR_NOT_INDEX).
+ */
+gr_pos_t gz_find( gz_t gz, gr_d item );
+
+
+/**
+ * Encode pointer to offset.
+ *
+ * Pointer must be within the arena range and aligned to the scale.
+ *
+ * @param gz   Compressed Gromer.
+ * @param item Pointer (or NULL).
+ *
+ * @return Offset.
+ */
+uint32_t gz_encode( gz_t gz, gr_d item );
+
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * @file   gromer_file.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 18:05:12 2026
+ *
+ * @brief  File Gromer - Gromer stored in memory mapped file.
+ *
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gromer_file.h"
+
+
+/** @cond gromer_none */
+/** File magic ("GRFILE01"). */
+#define gr_file_magic 0x3130454c49465247ULL
+/** @endcond gromer_none */
+
+
+/**
+ * File header.
+ *
+ * External storage hook is at the end of the header, i.e. just before
+ * the Gromer struct. Hook is runtime state and it is rewritten on
+ * open.
+ */
+typedef struct
+{
+    uint64_t magic;                                          /**< File magic. */
+    uint8_t  pad[ GR_FILE_HEAD - 8 - sizeof( gr_ext_s ) ]; /**< Reserved. */
+    gr_ext_s ext;                                            /**< Storage hook. */
+} gr_file_head_t;
+
+
+/**
+ * Open file state.
+ */
+typedef struct
+{
+    int       fd;    /**< File descriptor. */
+    gr_size_t bytes; /**< File (and mapping) size. */
+} gr_file_t;
+
+
+static gr_size_t gr_file_bytes( gr_size_t size );
+static gr_t gr_file_gromer( gr_d mem, gr_size_t bytes, gr_file_t* gf );
+static int gr_file_resize( gr_p gp, gr_size_t new_size, gr_d state );
+
+
+
+/* ------------------------------------------------------------
+ * File Gromer:
+ */
+
+
+gr_t gr_file_open( const char* path, gr_size_t size )
+{
+    gr_file_t*      gf;
+    gr_file_head_t* head;
+    struct stat     st;
+    gr_d            mem;
+    int             fd;
+    int             create;
+
+    fd = open( path, O_RDWR | O_CREAT, 0644 );
+    if ( fd < 0 )
+        return NULL;
+
+    if ( fstat( fd, &st ) != 0 )
+        goto fail; // GCOV_EXCL_LINE
+
+    create = ( st.st_size == 0 );
+    if ( create ) {
+        st.st_size = gr_file_bytes( size );
+        if ( ftruncate( fd, st.st_size ) != 0 )
+            goto fail; // GCOV_EXCL_LINE
+    } else if ( (gr_size_t)st.st_size < gr_file_bytes( GR_MIN_SIZE ) ) {
+        goto fail;
+    }
+
+    mem = mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( mem == MAP_FAILED )
+        goto fail; // GCOV_EXCL_LINE
+
+    head = (gr_file_head_t*)mem;
+    if ( create ) {
+        head->magic = gr_file_magic;
+        gr_use( (uint8_t*)mem + GR_FILE_HEAD, st.st_size - GR_FILE_HEAD );
+    } else if ( head->magic != gr_file_magic
+                || gr_struct_size( ( (gr_t)( head + 1 ) )->used ) > (gr_size_t)st.st_size - GR_FILE_HEAD ) {
+        munmap( mem, st.st_size );
+        goto fail;
+    }
+
+    gf = (gr_file_t*)gr_malloc( sizeof( gr_file_t ) );
+    gf->fd = fd;
+    gf->bytes = st.st_size;
+
+    return gr_file_gromer( mem, st.st_size, gf );
+
+fail:
+    close( fd );
+    return NULL;
+}
+
+
+int gr_file_sync( gr_t gr )
+{
+    gr_ext_s*  ext = gr_get_external( gr );
+    gr_file_t* gf;
+
+    gr_assert( ext && ext->resize == gr_file_resize );
+    gf = (gr_file_t*)ext->state;
+
+    return msync( (uint8_t*)gr - GR_FILE_HEAD, gf->bytes, MS_SYNC );
+}
+
+
+gr_size_t gr_file_alloc( gr_p gp, gr_size_t bytes )
+{
+    gr_size_t units = ( bytes + sizeof( gr_d ) - 1 ) / sizeof( gr_d );
+    gr_d      ptr;
+
+    if ( gr_used( *gp ) + units > gr_size( *gp ) )
+        gr_resize( gp, 2 * ( gr_used( *gp ) + units ) );
+
+    ptr = gr_alloc( gp, bytes );
+
+    return (uint8_t*)ptr - (uint8_t*)( *gp )->data;
+}
+
+
+gr_d gr_file_ptr( gr_t gr, gr_size_t off )
+{
+    return (uint8_t*)gr->data + off;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Return file size for Gromer size (page multiple).
+ *
+ * @param size Gromer size.
+ *
+ * @return File size.
+ */
+static gr_size_t gr_file_bytes( gr_size_t size )
+{
+    gr_size_t page = sysconf( _SC_PAGESIZE );
+
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+
+    return ( ( GR_FILE_HEAD + gr_struct_size( size ) + page - 1 ) / page ) * page;
+}
+
+
+/**
+ * Return Gromer of mapping and attach storage hook.
+ *
+ * Size is set to cover the whole mapping.
+ *
+ * @param mem   Mapping.
+ * @param bytes Mapping size.
+ * @param gf    File state.
+ *
+ * @return Gromer.
+ */
+static gr_t gr_file_gromer( gr_d mem, gr_size_t bytes, gr_file_t* gf )
+{
+    gr_t gr = (gr_t)( (uint8_t*)mem + GR_FILE_HEAD );
+
+    /* Page multiple minus header, hence size is even. */
+    gr->size = ( bytes - GR_FILE_HEAD - sizeof( gr_s ) ) / sizeof( gr_d );
+    gr_set_external( gr, gr_file_resize, gf );
+
+    return gr;
+}
+
+
+/**
+ * Resize (or release) File Gromer storage.
+ *
+ * @param gp       Gromer reference.
+ * @param new_size New size (0 for release).
+ * @param state    File state.
+ *
+ * @return 0 on success.
+ */
+static int gr_file_resize( gr_p gp, gr_size_t new_size, gr_d state )
+{
+    gr_file_t* gf = (gr_file_t*)state;
+    gr_d       old = (uint8_t*)*gp - GR_FILE_HEAD;
+    gr_size_t  bytes;
+    gr_d       mem;
+
+    if ( new_size == 0 ) {
+        munmap( old, gf->bytes );
+        close( gf->fd );
+        gr_free( gf );
+        return 0;
+    }
+
+    bytes = gr_file_bytes( new_size );
+    if ( bytes > gf->bytes && ftruncate( gf->fd, bytes ) != 0 )
+        return -1; // GCOV_EXCL_LINE
+
+    /* Map and truncate before unmapping old, in order to keep the old
+     * on failure. */
+    mem = mmap( NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, gf->fd, 0 );
+    if ( mem == MAP_FAILED )
+        return -1; // GCOV_EXCL_LINE
+
+    if ( bytes < gf->bytes && ftruncate( gf->fd, bytes ) != 0 ) {
+        munmap( mem, bytes ); // GCOV_EXCL_LINE
+        return -1;            // GCOV_EXCL_LINE
+    }
+
+    *gp = gr_file_gromer( mem, bytes, gf );
+    munmap( old, gf->bytes );
+    gf->bytes = bytes;
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#ifndef GROMER_FILE_H
+#define GROMER_FILE_H
+
+/**
+ * @file   gromer_file.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 18:05:12 2026
+ *
+ * @brief  File Gromer - Gromer stored in memory mapped file.
+ *
+ * Storage of File Gromer is a shared memory mapping of a file. File
+ * Gromer is a normal Gromer, i.e. all Gromer functions can be used
+ * for it, but it must be released with gr_destroy() (which unmaps
+ * and closes the file). When Gromer grows, file is extended and
+ * remapped, i.e. Gromer relocates as usual.
+ *
+ * File starts with a header of GR_FILE_HEAD bytes, which is followed
+ * by the Gromer struct and the items. File is reopened with the
+ * existing items.
+ *
+ * Items of a File Gromer are typically offsets to an arena File
+ * Gromer (see gr_file_alloc()), since pointers are not valid after
+ * remapping or reopening.
+ *
+ */
+
+#include "gromer.h"
+
+
+/** File header size. */
+#define GR_FILE_HEAD 64
+
+
+/**
+ * Open (or create) File Gromer.
+ *
+ * Existing file must be a File Gromer file. New file is created with
+ * size (in items) rounded up to page size.
+ *
+ * @param path File path.
+ * @param size Initial size for new file.
+ *
+ * @return Gromer (or NULL on failure).
+ */
+gr_t gr_file_open( const char* path, gr_size_t size );
+
+
+/**
+ * Flush File Gromer to file.
+ *
+ * @param gr File Gromer.
+ *
+ * @return 0 on success.
+ */
+int gr_file_sync( gr_t gr );
+
+
+/**
+ * Allocate bytes from arena Gromer and return offset.
+ *
+ * Allocation is as with gr_alloc(), but Gromer is resized if
+ * needed. Offset is relative to Gromer data, and it is stable over
+ * remapping and reopening.
+ *
+ * @param gp    Gromer reference.
+ * @param bytes Allocation size.
+ *
+ * @return Allocation offset.
+ */
+gr_size_t gr_file_alloc( gr_p gp, gr_size_t bytes );
+
+
+/**
+ * Return pointer for arena offset.
+ *
+ * Pointer is valid until Gromer relocates.
+ *
+ * @param gr  Gromer.
+ * @param off Allocation offset.
+ *
+ * @return Pointer.
+ */
+gr_d gr_file_ptr( gr_t gr, gr_size_t off );
+
+
+#endif
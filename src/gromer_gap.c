@@ -0,0 +1,204 @@
+/**
+ * @file   gromer_gap.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 20:02:36 2026
+ *
+ * @brief  Gap Gromer - Gromer with gap buffer.
+ *
+ */
+
+#include <string.h>
+
+#include "gromer_gap.h"
+
+
+static gr_size_t gb_norm_pos( gb_t gb, gr_pos_t pos, int end );
+static void gb_move_to( gb_t gb, gr_size_t pos );
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+gb_t gb_new( void )
+{
+    return gb_new_sized( GR_DEFAULT_SIZE );
+}
+
+
+gb_t gb_new_sized( gr_size_t size )
+{
+    gb_t gb;
+
+    gb = (gb_t)gr_malloc( sizeof( gb_s ) );
+    gb->gr = gr_new_sized( size );
+    gb->gap = 0;
+
+    return gb;
+}
+
+
+void gb_destroy( gb_p gp )
+{
+    if ( *gp == NULL )
+        return;
+
+    gr_destroy( &( *gp )->gr );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Editing:
+ */
+
+
+void gb_move( gb_t gb, gr_pos_t pos )
+{
+    gb_move_to( gb, gb_norm_pos( gb, pos, 1 ) );
+}
+
+
+void gb_insert_at( gb_t gb, gr_pos_t pos, gr_d item )
+{
+    gr_size_t norm = gb_norm_pos( gb, pos, 1 );
+
+    if ( gb_gap_len( gb ) == 0 ) {
+        /* Close gap, and grow with free slots at the end. */
+        gb_move_to( gb, gb->gr->used );
+        gr_resize( &gb->gr, 2 * gr_size( gb->gr ) );
+    }
+
+    gb_move_to( gb, norm );
+    gb->gr->data[ gb->gap++ ] = item;
+    gb->gr->used++;
+}
+
+
+gr_d gb_delete_at( gb_t gb, gr_pos_t pos )
+{
+    gr_d item;
+
+    if ( gb->gr->used == 0 )
+        return NULL;
+
+    gb_move_to( gb, gb_norm_pos( gb, pos, 0 ) );
+    item = gb->gr->data[ gb->gap + gb_gap_len( gb ) ];
+    gb->gr->used--;
+
+    return item;
+}
+
+
+void gb_push( gb_t gb, gr_d item )
+{
+    gb_insert_at( gb, gb->gr->used, item );
+}
+
+
+gr_d gb_pop( gb_t gb )
+{
+    return gb_delete_at( gb, -1 );
+}
+
+
+void gb_sort( gb_t gb, gr_compare_fn_p compare )
+{
+    gb_gromer( gb );
+    gr_sort( &gb->gr, compare );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+gr_size_t gb_used( gb_t gb )
+{
+    return gb->gr->used;
+}
+
+
+gr_size_t gb_cursor( gb_t gb )
+{
+    return gb->gap;
+}
+
+
+gr_d gb_nth( gb_t gb, gr_pos_t pos )
+{
+    if ( gb->gr->used == 0 )
+        return NULL;
+
+    return gb->gr->data[ gb_slot( gb, gb_norm_pos( gb, pos, 0 ) ) ];
+}
+
+
+gr_t gb_gromer( gb_t gb )
+{
+    gb_move_to( gb, gb->gr->used );
+    return gb->gr;
+}
+
+
+gr_d* gb_data( gb_t gb )
+{
+    return gb_gromer( gb )->data;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Normalize (possibly negative) position.
+ *
+ * @param gb  Gap Gromer.
+ * @param pos Position.
+ * @param end End position is legal, if non-zero.
+ *
+ * @return Normalized position.
+ */
+static gr_size_t gb_norm_pos( gb_t gb, gr_pos_t pos, int end )
+{
+    if ( pos < 0 )
+        pos += gb->gr->used;
+
+    gr_assert( pos >= 0 && (gr_size_t)pos < gb->gr->used + ( end != 0 ) );
+    (void)end;
+
+    return pos;
+}
+
+
+/**
+ * Move gap to position.
+ *
+ * Items between the old and the new gap position are moved over the
+ * gap.
+ *
+ * @param gb  Gap Gromer.
+ * @param pos Normalized position.
+ */
+static void gb_move_to( gb_t gb, gr_size_t pos )
+{
+    gr_d*     data = gb->gr->data;
+    gr_size_t len = gb_gap_len( gb );
+
+    if ( pos < gb->gap ) {
+        memmove( &data[ pos + len ], &data[ pos ], ( gb->gap - pos ) * sizeof( gr_d ) );
+    } else if ( pos > gb->gap ) {
+        memmove( &data[ gb->gap ], &data[ gb->gap + len ], ( pos - gb->gap ) * sizeof( gr_d ) );
+    }
+
+    gb->gap = pos;
+}
@@ -0,0 +1,214 @@
+#ifndef GROMER_GAP_H
+#define GROMER_GAP_H
+
+/**
+ * @file   gromer_gap.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 20:02:36 2026
+ *
+ * @brief  Gap Gromer - Gromer with gap buffer.
+ *
+ * Free slots of the storage form a gap, which is kept at the last
+ * edit position (cursor). Insert and delete at the cursor are O(1),
+ * and moving the cursor costs only the distance moved. Hence
+ * localized edits avoid moving the whole tail.
+ *
+ * Positions are item positions, i.e. gap is not visible in gb_nth()
+ * or gb_each(). gb_gromer() and gb_sort() close the gap (move it to
+ * the end), after which the storage is a plain Gromer.
+ *
+ */
+
+#include "gromer.h"
+
+
+/**
+ * Gap Gromer struct.
+ */
+struct gb_struct_s
+{
+    gr_t      gr;  /**< Storage, "used" is the item count. */
+    gr_size_t gap; /**< Gap position (cursor). */
+};
+typedef struct gb_struct_s gb_s; /**< Gap Gromer struct. */
+typedef gb_s*              gb_t; /**< Gap Gromer. */
+typedef gb_t*              gb_p; /**< Gap Gromer reference. */
+
+
+/** Gap length. */
+#define gb_gap_len( gb ) ( ( gb )->gr->size - ( gb )->gr->used )
+
+/** Storage index of item position. */
+#define gb_slot( gb, pos ) ( ( pos ) < ( gb )->gap ? ( pos ) : ( pos ) + gb_gap_len( gb ) )
+
+/** Iterate over all items. */
+#define gb_each( gb, iter, cast )                                       \
+    for ( gr_size_t gr_idx = 0;                                         \
+          ( gr_idx < ( gb )->gr->used )                                 \
+          && ( ( iter = ( cast )( gb )->gr->data[ gb_slot( gb, gr_idx ) ] ), 1 ); \
+          gr_idx++ )
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+/**
+ * Create Gap Gromer with default size (GR_DEFAULT_SIZE).
+ *
+ * @return Gap Gromer.
+ */
+gb_t gb_new( void );
+
+
+/**
+ * Create Gap Gromer with size.
+ *
+ * @param size Initial size.
+ *
+ * @return Gap Gromer.
+ */
+gb_t gb_new_sized( gr_size_t size );
+
+
+/**
+ * Destroy Gap Gromer.
+ *
+ * @param gp Gap Gromer reference.
+ */
+void gb_destroy( gb_p gp );
+
+
+
+/* ------------------------------------------------------------
+ * Editing:
+ */
+
+
+/**
+ * Move gap (cursor) to position.
+ *
+ * @param gb  Gap Gromer.
+ * @param pos Position (negative from end, gb_used() for end).
+ */
+void gb_move( gb_t gb, gr_pos_t pos );
+
+
+/**
+ * Insert item to position.
+ *
+ * Gap is moved to position, item is inserted before the gap, and
+ * cursor is after the inserted item.
+ *
+ * @param gb   Gap Gromer.
+ * @param pos  Position (negative from end, gb_used() for end).
+ * @param item Item to insert.
+ */
+void gb_insert_at( gb_t gb, gr_pos_t pos, gr_d item );
+
+
+/**
+ * Delete item at position.
+ *
+ * Gap is moved to position, and item after the gap is deleted.
+ *
+ * @param gb  Gap Gromer.
+ * @param pos Position (negative from end).
+ *
+ * @return Deleted item (or NULL if empty).
+ */
+gr_d gb_delete_at( gb_t gb, gr_pos_t pos );
+
+
+/**
+ * Push item to end of container.
+ *
+ * @param gb   Gap Gromer.
+ * @param item Item to push.
+ */
+void gb_push( gb_t gb, gr_d item );
+
+
+/**
+ * Pop item from end of container.
+ *
+ * @param gb Gap Gromer.
+ *
+ * @return Popped item (or NULL if empty).
+ */
+gr_d gb_pop( gb_t gb );
+
+
+/**
+ * Sort items.
+ *
+ * Gap is closed before sorting (see gr_sort()).
+ *
+ * @param gb      Gap Gromer.
+ * @param compare Compare function.
+ */
+void gb_sort( gb_t gb, gr_compare_fn_p compare );
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+/**
+ * Return item count.
+ *
+ * @param gb Gap Gromer.
+ *
+ * @return Item count.
+ */
+gr_size_t gb_used( gb_t gb );
+
+
+/**
+ * Return gap (cursor) position.
+ *
+ * @param gb Gap Gromer.
+ *
+ * @return Position.
+ */
+gr_size_t gb_cursor( gb_t gb );
+
+
+/**
+ * Return item at position.
+ *
+ * @param gb  Gap Gromer.
+ * @param pos Position (negative from end).
+ *
+ * @return Item (or NULL if empty).
+ */
+gr_d gb_nth( gb_t gb, gr_pos_t pos );
+
+
+/**
+ * Return Gromer with closed gap.
+ *
+ * Gromer is owned by Gap Gromer, and it is valid until next edit.
+ *
+ * @param gb Gap Gromer.
+ *
+ * @return Gromer.
+ */
+gr_t gb_gromer( gb_t gb );
+
+
+/**
+ * Return item array with closed gap.
+ *
+ * @param gb Gap Gromer.
+ *
+ * @return Item array.
+ */
+gr_d* gb_data( gb_t gb );
+
+
+#endif
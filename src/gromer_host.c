@@ -0,0 +1,232 @@
+/**
+ * @file   gromer_host.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Mon Oct 19 08:41:27 2026
+ *
+ * @brief  Host - arena for many small Gromers.
+ *
+ */
+
+#include <string.h>
+
+#include "gromer_host.h"
+
+
+/** @cond gromer_none */
+#define gh_slot_size( size ) ( sizeof( gr_ext_s ) + gr_struct_size( size ) )
+/** @endcond gromer_none */
+
+
+static gr_t gh_place( gh_t gh, gr_size_t size );
+static int gh_resize( gr_p gp, gr_size_t new_size, gr_d state );
+
+
+
+/* ------------------------------------------------------------
+ * Host:
+ */
+
+
+gh_t gh_new( gr_size_t pages )
+{
+    gh_t gh;
+
+    gh = (gh_t)gr_malloc( sizeof( gh_s ) );
+    gh->block = gr_new();
+    gh->pages = pages ? pages : GH_BLOCK_PAGES;
+    gh->live = 0;
+    gh->dead = 0;
+
+    return gh;
+}
+
+
+void gh_destroy( gh_p gp )
+{
+    gr_t block;
+
+    if ( *gp == NULL )
+        return;
+
+    gr_each( ( *gp )->block, block, gr_t )
+    {
+        gr_destroy( &block );
+    }
+    gr_destroy( &( *gp )->block );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+gr_t gh_gromer( gh_t gh, gr_size_t size )
+{
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+
+    return gh_place( gh, ( size + 1 ) & ~1ULL );
+}
+
+
+void gh_compact( gh_t gh, gr_t* grs, gr_size_t count )
+{
+    gr_t old = gh->block;
+    gr_t block;
+
+    gh->block = gr_new();
+    gh->live = 0;
+    gh->dead = 0;
+
+    for ( gr_size_t i = 0; i < count; i++ ) {
+        gr_t gr = grs[ i ];
+        if ( gr == NULL )
+            continue;
+        gr_assert( gr_get_external( gr ) && gr_get_external( gr )->state == gh );
+        grs[ i ] = gh_place( gh, gr_size( gr ) );
+        grs[ i ]->used = gr->used;
+        memcpy( grs[ i ]->data, gr->data, gr->used * sizeof( gr_d ) );
+    }
+
+    gr_each( old, block, gr_t )
+    {
+        gr_destroy( &block );
+    }
+    gr_destroy( &old );
+}
+
+
+gr_size_t gh_live( gh_t gh )
+{
+    return gh->live;
+}
+
+
+gr_size_t gh_dead( gh_t gh )
+{
+    return gh->dead;
+}
+
+
+gr_size_t gh_blocks( gh_t gh )
+{
+    return gr_used( gh->block );
+}
+
+
+
+/* ------------------------------------------------------------
+ * CSR:
+ */
+
+
+gh_csr_t gh_freeze( gr_t* grs, gr_size_t count )
+{
+    gh_csr_t  csr;
+    gr_size_t total = 0;
+
+    for ( gr_size_t i = 0; i < count; i++ ) {
+        if ( grs[ i ] )
+            total += grs[ i ]->used;
+    }
+
+    csr = (gh_csr_t)gr_malloc_uninit( sizeof( gh_csr_s )
+                                      + ( count + 1 ) * sizeof( gr_size_t )
+                                      + total * sizeof( gr_d ) );
+    csr->count = count;
+    csr->item = (gr_d*)&csr->offset[ count + 1 ];
+
+    total = 0;
+    for ( gr_size_t i = 0; i < count; i++ ) {
+        csr->offset[ i ] = total;
+        if ( grs[ i ] ) {
+            memcpy( &csr->item[ total ], grs[ i ]->data, grs[ i ]->used * sizeof( gr_d ) );
+            total += grs[ i ]->used;
+        }
+    }
+    csr->offset[ count ] = total;
+
+    return csr;
+}
+
+
+void gh_csr_destroy( gh_csr_p cp )
+{
+    if ( *cp == NULL )
+        return;
+
+    gr_free( *cp );
+    *cp = NULL;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Place new Gromer to host.
+ *
+ * Slot is the external storage hook followed by the Gromer. Slot that
+ * does not fit to a block gets a dedicated block.
+ *
+ * @param gh   Host.
+ * @param size Gromer size (even).
+ *
+ * @return Gromer.
+ */
+static gr_t gh_place( gh_t gh, gr_size_t size )
+{
+    gr_size_t bytes = gh_slot_size( size );
+    uint8_t*  slot = NULL;
+    gr_size_t page;
+    gr_size_t pages;
+    gr_t      gr;
+
+    if ( gr_used( gh->block ) > 0 )
+        slot = (uint8_t*)gr_alloc( (gr_p)gr_nth_ref( gh->block, -1 ), bytes );
+
+    if ( slot == NULL ) {
+        page = gr_alloc_pages( 0, NULL );
+        pages = ( bytes + sizeof( gr_s ) + page - 1 ) / page;
+        if ( pages < gh->pages )
+            pages = gh->pages;
+        gr_push( &gh->block, gr_new_page( pages ) );
+        slot = (uint8_t*)gr_alloc( (gr_p)gr_nth_ref( gh->block, -1 ), bytes );
+    }
+
+    gr = gr_use( slot + sizeof( gr_ext_s ), gr_struct_size( size ) );
+    gr_set_external( gr, gh_resize, gh );
+    gh->live += bytes;
+
+    return gr;
+}
+
+
+/**
+ * Resize (or release) hosted Gromer.
+ *
+ * @param gp       Gromer reference.
+ * @param new_size New size (0 for release).
+ * @param state    Host.
+ *
+ * @return 0 on success.
+ */
+static int gh_resize( gr_p gp, gr_size_t new_size, gr_d state )
+{
+    gh_t      gh = (gh_t)state;
+    gr_t      old = *gp;
+    gr_size_t bytes = gh_slot_size( gr_size( old ) );
+
+    gh->live -= bytes;
+    gh->dead += bytes;
+
+    if ( new_size == 0 )
+        return 0;
+
+    *gp = gh_place( gh, new_size );
+    ( *gp )->used = old->used;
+    memcpy( ( *gp )->data, old->data, old->used * sizeof( gr_d ) );
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+#ifndef GROMER_HOST_H
+#define GROMER_HOST_H
+
+/**
+ * @file   gromer_host.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Mon Oct 19 08:41:27 2026
+ *
+ * @brief  Host - arena for many small Gromers.
+ *
+ * Host allocates Gromers back-to-back within page Gromer blocks,
+ * i.e. without heap allocation per Gromer. Hosted Gromer is a normal
+ * Gromer with external storage (see gr_set_external()). When it
+ * outgrows its slot, it is relocated within the host, and the old
+ * slot becomes dead. gr_destroy() marks the slot dead.
+ *
+ * Dead slots are reclaimed by gh_compact(), which copies the given
+ * (live) Gromers to new blocks and updates the handles. All
+ * Gromers are released with gh_destroy().
+ *
+ * gh_freeze() converts a set of Gromers to one CSR array (offsets and
+ * items), which is read-only and contiguous:
+ *
+ *     csr = gh_freeze( grs, count );
+ *     gh_csr_each( csr, 5, item, node_t* ) { ... }
+ *
+ */
+
+#include "gromer.h"
+
+
+#ifndef GH_BLOCK_PAGES
+/** Default block size in pages. */
+#define GH_BLOCK_PAGES 16
+#endif
+
+
+/**
+ * Host struct.
+ */
+struct gh_struct_s
+{
+    gr_t      block; /**< Blocks (page Gromers), last is current. */
+    gr_size_t pages; /**< Block size in pages. */
+    gr_size_t live;  /**< Bytes in live slots. */
+    gr_size_t dead;  /**< Bytes in dead slots. */
+};
+typedef struct gh_struct_s gh_s; /**< Host struct. */
+typedef gh_s*              gh_t; /**< Host. */
+typedef gh_t*              gh_p; /**< Host reference. */
+
+
+/**
+ * CSR (compressed sparse row) struct.
+ *
+ * Items of row "i" are "item[ offset[i] ] ... item[ offset[i+1]-1 ]".
+ */
+struct gh_csr_struct_s
+{
+    gr_size_t  count;       /**< Row count. */
+    gr_d*      item;        /**< Items (after offsets). */
+    gr_size_t  offset[ 0 ]; /**< Row offsets (count+1). */
+};
+typedef struct gh_csr_struct_s gh_csr_s; /**< CSR struct. */
+typedef gh_csr_s*              gh_csr_t; /**< CSR. */
+typedef gh_csr_t*              gh_csr_p; /**< CSR reference. */
+
+
+/** Item count of CSR row. */
+#define gh_csr_used( csr, row ) ( ( csr )->offset[ ( row ) + 1 ] - ( csr )->offset[ ( row ) ] )
+
+/** Items of CSR row. */
+#define gh_csr_row( csr, row ) ( &( csr )->item[ ( csr )->offset[ ( row ) ] ] )
+
+/** Iterate over CSR row items. */
+#define gh_csr_each( csr, row, iter, cast )                             \
+    for ( gr_size_t gr_idx = ( csr )->offset[ ( row ) ];                \
+          ( gr_idx < ( csr )->offset[ ( row ) + 1 ] )                   \
+          && ( ( iter = ( cast )( csr )->item[ gr_idx ] ), 1 );         \
+          gr_idx++ )
+
+
+
+/* ------------------------------------------------------------
+ * Host:
+ */
+
+
+/**
+ * Create host.
+ *
+ * @param pages Block size in pages (0 for GH_BLOCK_PAGES).
+ *
+ * @return Host.
+ */
+gh_t gh_new( gr_size_t pages );
+
+
+/**
+ * Destroy host, including all hosted Gromers.
+ *
+ * @param gp Host reference.
+ */
+void gh_destroy( gh_p gp );
+
+
+/**
+ * Create hosted Gromer.
+ *
+ * @param gh   Host.
+ * @param size Initial size.
+ *
+ * @return Gromer.
+ */
+gr_t gh_gromer( gh_t gh, gr_size_t size );
+
+
+/**
+ * Compact host.
+ *
+ * Given Gromers are copied back-to-back to new blocks, and handles
+ * are updated. All other hosted Gromers are released. NULL handles
+ * are skipped.
+ *
+ * @param gh    Host.
+ * @param grs   Live Gromers (handles are updated).
+ * @param count Gromer count.
+ */
+void gh_compact( gh_t gh, gr_t* grs, gr_size_t count );
+
+
+/**
+ * Return bytes in live Gromer slots.
+ *
+ * @param gh Host.
+ *
+ * @return Bytes.
+ */
+gr_size_t gh_live( gh_t gh );
+
+
+/**
+ * Return bytes in dead (released or relocated) Gromer slots.
+ *
+ * @param gh Host.
+ *
+ * @return Bytes.
+ */
+gr_size_t gh_dead( gh_t gh );
+
+
+/**
+ * Return block count.
+ *
+ * @param gh Host.
+ *
+ * @return Block count.
+ */
+gr_size_t gh_blocks( gh_t gh );
+
+
+
+/* ------------------------------------------------------------
+ * CSR:
+ */
+
+
+/**
+ * Freeze Gromers to CSR.
+ *
+ * Gromers can be any Gromers (not only hosted), and they are not
+ * modified. NULL handles are empty rows.
+ *
+ * @param grs   Gromers.
+ * @param count Gromer count.
+ *
+ * @return CSR.
+ */
+gh_csr_t gh_freeze( gr_t* grs, gr_size_t count );
+
+
+/**
+ * Destroy CSR.
+ *
+ * @param cp CSR reference.
+ */
+void gh_csr_destroy( gh_csr_p cp );
+
+
+#endif
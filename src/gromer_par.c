@@ -0,0 +1,953 @@
+/**
+ * @file   gromer_par.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 10:12:41 2026
+ *
+ * @brief  Gromer parallel algorithms.
+ *
+ */
+
+#define _POSIX_C_SOURCE 200112L
+#define _DEFAULT_SOURCE
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "gromer_par.h"
+
+
+/** @cond gromer_none */
+#define gr_true  1
+#define gr_false 0
+
+/** Items per cache line. */
+#define gr_line_units ( GR_CACHE_LINE / sizeof( gr_d ) )
+
+/** NUMA node mask size in bits. */
+#define gr_numa_bits 1024
+/** Bits in node mask word. */
+#define gr_numa_word ( 8 * sizeof( unsigned long ) )
+
+/** First task of pool thread "t" (tasks are assigned in blocks). */
+#define gr_pool_first( pool, t ) ( ( t ) * ( pool )->count / ( pool )->threads )
+
+/** Memory policy modes (see mbind(2)). */
+#define gr_mpol_preferred  1
+#define gr_mpol_interleave 3
+/** @endcond gromer_none */
+
+
+/**
+ * Pool struct.
+ */
+struct gr_pool_s
+{
+    gr_exec_fn_p    exec;      /**< Caller executor (or NULL). */
+    gr_d            state;     /**< Caller executor state. */
+    int             threads;   /**< Thread count (including caller). */
+    gr_size_t       threshold; /**< Serial execution threshold. */
+    pthread_t*      workers;   /**< Worker threads. */
+    int             ids;       /**< Assigned worker thread indeces. */
+    pthread_mutex_t run;       /**< Serialize pool users. */
+    pthread_mutex_t lock;      /**< Job state lock. */
+    pthread_cond_t  wake;      /**< Job available. */
+    pthread_cond_t  done;      /**< Job completed. */
+    gr_task_fn_p    fn;        /**< Job task function. */
+    gr_d            ctx;       /**< Job context. */
+    gr_size_t       count;     /**< Job task count. */
+    gr_size_t*      next;      /**< Next task to execute (per thread). */
+    gr_size_t       finished;  /**< Completed task count. */
+    int             quit;      /**< Terminate workers. */
+};
+
+
+/**
+ * Chunked job over Gromer.
+ */
+typedef struct
+{
+    gr_t            src;     /**< Source Gromer. */
+    gr_t            dst;     /**< Destination Gromer (map). */
+    gr_size_t       chunk;   /**< Nominal chunk size. */
+    gr_size_t       skew;    /**< Cache line skew of aligned array. */
+    int             aligned; /**< Boundaries are aligned to cache lines. */
+    gr_size_t       chunks;  /**< Chunk count. */
+    gr_each_fn_p    each;    /**< Visit function. */
+    gr_map_fn_p     map;     /**< Map function. */
+    gr_combine_fn_p combine; /**< Combine function. */
+    gr_d            init;    /**< Reduce init value. */
+    gr_d            arg;     /**< Function argument. */
+    gr_d*           part;    /**< Chunk results (deterministic). */
+    gr_d            acc;     /**< Reduce accumulator. */
+    pthread_mutex_t lock;    /**< Accumulator lock. */
+} gr_job_t;
+
+
+/**
+ * Parallel merge job.
+ */
+typedef struct
+{
+    gr_t*           grs;     /**< Inputs. */
+    gr_size_t       count;   /**< Input count. */
+    gr_size_t*      bound;   /**< Part bounds ((parts + 1) * count). */
+    gr_size_t*      off;     /**< Part output offsets. */
+    gr_size_t*      cnt;     /**< Part output counts. */
+    gr_d*           dst;     /**< Output array. */
+    gr_compare_fn_p compare; /**< Compare function. */
+    int             dedup;   /**< Drop duplicates. */
+} gr_merge_job_t;
+
+
+/**
+ * First-touch job.
+ */
+typedef struct
+{
+    uint8_t*  mem;   /**< Storage. */
+    gr_size_t bytes; /**< Storage size. */
+    gr_size_t part;  /**< Range size (page multiple). */
+} gr_touch_job_t;
+
+
+static pthread_once_t gr_pool_once = PTHREAD_ONCE_INIT;
+static gr_pool_t      gr_pool_default = NULL;
+
+/** Built-in pool whose tasks the thread executes (or NULL). */
+static __thread gr_pool_t gr_pool_inside = NULL;
+
+static void  gr_pool_default_init( void );
+static gr_pool_t gr_pool_get( gr_pool_t pool );
+static void* gr_pool_worker( void* arg );
+static int   gr_pool_work( gr_pool_t pool, int self );
+static void  gr_job_init( gr_job_t* job, gr_pool_t pool, gr_t src, gr_d* align, gr_size_t chunk );
+static void  gr_job_range( gr_job_t* job, gr_size_t idx, gr_size_t* lo, gr_size_t* hi );
+static void  gr_task_each( gr_d ctx, gr_size_t idx );
+static void  gr_task_map( gr_d ctx, gr_size_t idx );
+static void  gr_task_reduce( gr_d ctx, gr_size_t idx );
+static void  gr_task_merge( gr_d ctx, gr_size_t idx );
+static gr_size_t gr_lower_bound( gr_t gr, gr_d ref, gr_compare_fn_p compare );
+static void  gr_task_touch( gr_d ctx, gr_size_t idx );
+static int   gr_numa_mask( unsigned long* mask );
+static void  gr_numa_place( gr_d mem, gr_size_t bytes, int policy, int node );
+static uint64_t gr_par_now_ns( void );
+
+
+
+/* ------------------------------------------------------------
+ * Pool:
+ */
+
+
+gr_pool_t gr_pool_new( int threads )
+{
+    gr_pool_t pool;
+
+    if ( threads <= 0 )
+        threads = sysconf( _SC_NPROCESSORS_ONLN );
+    if ( threads <= 0 )
+        threads = 1;
+
+    pool = (gr_pool_t)gr_malloc( sizeof( gr_pool_s ) );
+    pool->threads = threads;
+    pool->threshold = GR_PAR_THRESHOLD;
+    pool->next = (gr_size_t*)gr_malloc( threads * sizeof( gr_size_t ) );
+    pthread_mutex_init( &pool->run, NULL );
+    pthread_mutex_init( &pool->lock, NULL );
+    pthread_cond_init( &pool->wake, NULL );
+    pthread_cond_init( &pool->done, NULL );
+
+    if ( threads > 1 ) {
+        pool->workers = (pthread_t*)gr_malloc( ( threads - 1 ) * sizeof( pthread_t ) );
+        for ( int i = 0; i < threads - 1; i++ ) {
+            if ( pthread_create( &pool->workers[ i ], NULL, gr_pool_worker, pool ) ) {
+                /* Continue with threads that were created. */
+                pool->threads = i + 1; // GCOV_EXCL_LINE
+                break;                 // GCOV_EXCL_LINE
+            }
+        }
+    }
+
+    return pool;
+}
+
+
+gr_pool_t gr_pool_use( gr_exec_fn_p exec, gr_d state, int threads )
+{
+    gr_pool_t pool;
+
+    pool = (gr_pool_t)gr_malloc( sizeof( gr_pool_s ) );
+    pool->exec = exec;
+    pool->state = state;
+    pool->threads = ( threads > 0 ) ? threads : 1;
+    pool->threshold = GR_PAR_THRESHOLD;
+
+    return pool;
+}
+
+
+void gr_pool_destroy( gr_pool_p pp )
+{
+    gr_pool_t pool = *pp;
+
+    if ( pool == NULL )
+        return;
+
+    if ( pool->exec == NULL ) {
+
+        pthread_mutex_lock( &pool->lock );
+        pool->quit = gr_true;
+        pthread_cond_broadcast( &pool->wake );
+        pthread_mutex_unlock( &pool->lock );
+
+        for ( int i = 0; i < pool->threads - 1; i++ )
+            pthread_join( pool->workers[ i ], NULL );
+
+        gr_free( pool->workers );
+        gr_free( pool->next );
+        pthread_cond_destroy( &pool->done );
+        pthread_cond_destroy( &pool->wake );
+        pthread_mutex_destroy( &pool->lock );
+        pthread_mutex_destroy( &pool->run );
+    }
+
+    gr_free( pool );
+    *pp = NULL;
+}
+
+
+void gr_pool_set_threshold( gr_pool_t pool, gr_size_t threshold )
+{
+    gr_pool_get( pool )->threshold = threshold;
+}
+
+
+int gr_pool_threads( gr_pool_t pool )
+{
+    return gr_pool_get( pool )->threads;
+}
+
+
+void gr_pool_run( gr_pool_t pool, gr_task_fn_p fn, gr_d ctx, gr_size_t count )
+{
+    pool = gr_pool_get( pool );
+
+    if ( count == 0 )
+        return;
+
+    if ( pool->exec ) {
+        pool->exec( pool->state, fn, ctx, count );
+        return;
+    }
+
+    /* Nested run from a task of the same pool is serial, since the
+     * pool is busy with the outer run. */
+    if ( pool->threads <= 1 || count == 1 || gr_pool_inside == pool ) {
+        for ( gr_size_t i = 0; i < count; i++ )
+            fn( ctx, i );
+        return;
+    }
+
+    pthread_mutex_lock( &pool->run );
+    gr_pool_inside = pool;
+
+    pthread_mutex_lock( &pool->lock );
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->count = count;
+    for ( int t = 0; t < pool->threads; t++ )
+        pool->next[ t ] = gr_pool_first( pool, t );
+    pool->finished = 0;
+    pthread_cond_broadcast( &pool->wake );
+
+    /* Caller participates as thread 0. */
+    while ( gr_pool_work( pool, 0 ) )
+        ;
+
+    while ( pool->finished < pool->count )
+        pthread_cond_wait( &pool->done, &pool->lock );
+
+    pthread_mutex_unlock( &pool->lock );
+
+    gr_pool_inside = NULL;
+    pthread_mutex_unlock( &pool->run );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Algorithms:
+ */
+
+
+void gr_par_for_each( gr_t gr, gr_pool_t pool, gr_each_fn_p fn, gr_d arg )
+{
+    gr_job_t job;
+
+    pool = gr_pool_get( pool );
+
+    if ( gr_used( gr ) < pool->threshold ) {
+        for ( gr_size_t i = 0; i < gr_used( gr ); i++ )
+            fn( gr->data[ i ], arg );
+        return;
+    }
+
+    gr_job_init( &job, pool, gr, gr->data, 0 );
+    job.each = fn;
+    job.arg = arg;
+    gr_pool_run( pool, gr_task_each, &job, job.chunks );
+}
+
+
+gr_t gr_par_map( gr_t gr, gr_pool_t pool, gr_map_fn_p fn, gr_d arg )
+{
+    gr_job_t job;
+    gr_t     dst;
+
+    pool = gr_pool_get( pool );
+
+    /* Result is written fully, hence zero-fill only the tail. */
+    dst = gr_new_uninit( gr_used( gr ) );
+    dst->used = gr_used( gr );
+
+    if ( gr_used( gr ) < pool->threshold ) {
+        for ( gr_size_t i = 0; i < gr_used( gr ); i++ )
+            dst->data[ i ] = fn( gr->data[ i ], arg );
+        gr_set_uninit( dst, 0 );
+        return dst;
+    }
+
+    /* Align chunks to the written array, in order to avoid false
+     * sharing between threads. */
+    gr_job_init( &job, pool, gr, dst->data, 0 );
+    job.dst = dst;
+    job.map = fn;
+    job.arg = arg;
+    gr_pool_run( pool, gr_task_map, &job, job.chunks );
+    gr_set_uninit( dst, 0 );
+
+    return dst;
+}
+
+
+gr_d gr_par_reduce( gr_t            gr,
+                    gr_pool_t       pool,
+                    gr_combine_fn_p combine,
+                    gr_d            init,
+                    gr_d            arg,
+                    int             deterministic )
+{
+    gr_job_t job;
+    gr_d     acc;
+
+    pool = gr_pool_get( pool );
+
+    if ( gr_used( gr ) < pool->threshold && deterministic ) {
+        /* Same chunks as in parallel, hence same result. */
+        acc = init;
+        for ( gr_size_t lo = 0; lo < gr_used( gr ); lo += GR_PAR_CHUNK ) {
+            gr_d part = init;
+            for ( gr_size_t i = lo; i < gr_used( gr ) && i < lo + GR_PAR_CHUNK; i++ )
+                part = combine( part, gr->data[ i ], arg );
+            acc = combine( acc, part, arg );
+        }
+        return acc;
+    } else if ( gr_used( gr ) < pool->threshold ) {
+        acc = init;
+        for ( gr_size_t i = 0; i < gr_used( gr ); i++ )
+            acc = combine( acc, gr->data[ i ], arg );
+        return acc;
+    }
+
+    gr_job_init( &job, pool, gr, gr->data, deterministic ? GR_PAR_CHUNK : 0 );
+    job.combine = combine;
+    job.init = init;
+    job.arg = arg;
+    job.acc = init;
+
+    if ( deterministic ) {
+        job.part = (gr_d*)gr_malloc( job.chunks * sizeof( gr_d ) );
+        gr_pool_run( pool, gr_task_reduce, &job, job.chunks );
+        acc = init;
+        for ( gr_size_t i = 0; i < job.chunks; i++ )
+            acc = combine( acc, job.part[ i ], arg );
+        gr_free( job.part );
+    } else {
+        pthread_mutex_init( &job.lock, NULL );
+        gr_pool_run( pool, gr_task_reduce, &job, job.chunks );
+        pthread_mutex_destroy( &job.lock );
+        acc = job.acc;
+    }
+
+    return acc;
+}
+
+
+
+gr_t gr_par_merge( gr_t*           grs,
+                   gr_size_t       count,
+                   gr_pool_t       pool,
+                   gr_compare_fn_p compare,
+                   int             dedup )
+{
+    gr_merge_job_t job;
+    gr_size_t      total = 0;
+    gr_size_t      parts;
+    gr_t           sample;
+    gr_t           split;
+    gr_t           dst;
+
+    pool = gr_pool_get( pool );
+
+    for ( gr_size_t i = 0; i < count; i++ )
+        total += gr_used( grs[ i ] );
+
+    parts = pool->threads;
+    if ( total < pool->threshold || parts <= 1 || count <= 1 )
+        return gr_merge( grs, count, compare, dedup );
+
+    /* Sample "parts" items evenly from each input. Samples of each
+     * input are sorted, hence they are merged to get the splitters
+     * at even quantiles. */
+    gr_t* samples = (gr_t*)gr_malloc( count * sizeof( gr_t ) );
+    for ( gr_size_t i = 0; i < count; i++ ) {
+        gr_size_t used = gr_used( grs[ i ] );
+        samples[ i ] = gr_new_sized( parts );
+        for ( gr_size_t j = 1; j <= parts && used > 0; j++ )
+            gr_push( &samples[ i ], grs[ i ]->data[ ( j * used - 1 ) / ( parts + 1 ) ] );
+    }
+    sample = gr_merge( samples, count, compare, 0 );
+    for ( gr_size_t i = 0; i < count; i++ )
+        gr_destroy( &samples[ i ] );
+    gr_free( samples );
+
+    split = gr_new_sized( parts );
+    for ( gr_size_t j = 1; j < parts; j++ )
+        gr_push( &split, sample->data[ j * gr_used( sample ) / parts ] );
+    gr_destroy( &sample );
+
+    /* Equal items are placed into the same part, since bounds are
+     * lower bounds of splitters. */
+    memset( &job, 0, sizeof( job ) );
+    job.grs = grs;
+    job.count = count;
+    job.compare = compare;
+    job.dedup = dedup;
+    job.bound = (gr_size_t*)gr_malloc( ( parts + 1 ) * count * sizeof( gr_size_t ) );
+    job.off = (gr_size_t*)gr_malloc( ( parts + 1 ) * sizeof( gr_size_t ) );
+    job.cnt = (gr_size_t*)gr_malloc( parts * sizeof( gr_size_t ) );
+
+    for ( gr_size_t i = 0; i < count; i++ ) {
+        job.bound[ i ] = 0;
+        job.bound[ parts * count + i ] = gr_used( grs[ i ] );
+    }
+
+    for ( gr_size_t j = 1; j < parts; j++ ) {
+        for ( gr_size_t i = 0; i < count; i++ )
+            job.bound[ j * count + i ] = gr_lower_bound( grs[ i ], split->data[ j - 1 ], compare );
+    }
+    gr_destroy( &split );
+
+    for ( gr_size_t j = 0; j <= parts; j++ ) {
+        job.off[ j ] = 0;
+        for ( gr_size_t i = 0; i < count; i++ )
+            job.off[ j ] += job.bound[ j * count + i ];
+    }
+
+    dst = gr_new_uninit( total );
+    job.dst = dst->data;
+    gr_pool_run( pool, gr_task_merge, &job, parts );
+
+    /* Close gaps left by dropped duplicates. */
+    dst->used = job.cnt[ 0 ];
+    for ( gr_size_t j = 1; j < parts; j++ ) {
+        if ( dst->used != job.off[ j ] )
+            memmove( &dst->data[ dst->used ], &dst->data[ job.off[ j ] ], job.cnt[ j ] * sizeof( gr_d ) );
+        dst->used += job.cnt[ j ];
+    }
+    gr_set_uninit( dst, 0 );
+
+    gr_free( job.cnt );
+    gr_free( job.off );
+    gr_free( job.bound );
+
+    return dst;
+}
+
+
+
+/* ------------------------------------------------------------
+ * NUMA placement:
+ */
+
+
+gr_t gr_new_numa( gr_size_t size, gr_pool_t pool, int policy, int node )
+{
+    gr_touch_job_t  job;
+    gr_size_t       page = sysconf( _SC_PAGESIZE );
+    gr_observe_fn_p obs = gr_get_observer();
+    uint64_t        t0 = obs ? gr_par_now_ns() : 0;
+    gr_size_t       ranges;
+    gr_d            mem = NULL;
+    gr_t            gr;
+
+    pool = gr_pool_get( pool );
+
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+
+    job.bytes = ( ( gr_struct_size( size ) + page - 1 ) / page ) * page;
+    if ( posix_memalign( &mem, page, job.bytes ) )
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+    job.mem = (uint8_t*)mem;
+
+    /* Policy must be in place before pages are touched. */
+    gr_numa_place( mem, job.bytes, policy, node );
+
+    ranges = ( size < pool->threshold ) ? 1 : pool->threads;
+    job.part = ( ( job.bytes / page + ranges - 1 ) / ranges ) * page;
+    ranges = ( job.bytes + job.part - 1 ) / job.part;
+    gr_pool_run( pool, gr_task_touch, &job, ranges );
+    if ( obs )
+        obs( GR_ALLOC_PAGES, job.bytes, 0, gr_par_now_ns() - t0 );
+
+    /* Storage is page multiple, hence size is even. */
+    gr = (gr_t)mem;
+    gr->size = ( job.bytes - sizeof( gr_s ) ) / sizeof( gr_d );
+    gr->used = 0;
+
+    return gr;
+}
+
+
+int gr_numa_nodes( void )
+{
+    unsigned long mask[ gr_numa_bits / gr_numa_word ];
+
+    return gr_numa_mask( mask );
+}
+
+
+int gr_numa_node_of( gr_d addr )
+{
+#ifdef SYS_move_pages
+    uintptr_t page = sysconf( _SC_PAGESIZE );
+    void*     pages[ 1 ];
+    int       status[ 1 ] = { -1 };
+
+    /* Query only, i.e. no target nodes. */
+    pages[ 0 ] = (void*)( (uintptr_t)addr & ~( page - 1 ) );
+    if ( syscall( SYS_move_pages, 0, 1, pages, NULL, status, 0 ) != 0 )
+        return -1; // GCOV_EXCL_LINE
+
+    return ( status[ 0 ] >= 0 ) ? status[ 0 ] : -1;
+#else
+    (void)addr;
+    return -1;
+#endif
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Create default pool.
+ */
+static void gr_pool_default_init( void )
+{
+    gr_pool_default = gr_pool_new( 0 );
+}
+
+
+/**
+ * Return pool or the default pool, if pool is NULL.
+ *
+ * @param pool Pool.
+ *
+ * @return Pool.
+ */
+static gr_pool_t gr_pool_get( gr_pool_t pool )
+{
+    if ( pool )
+        return pool;
+
+    pthread_once( &gr_pool_once, gr_pool_default_init );
+
+    return gr_pool_default;
+}
+
+
+/**
+ * Worker thread main loop.
+ *
+ * @param arg Pool.
+ *
+ * @return NULL.
+ */
+static void* gr_pool_worker( void* arg )
+{
+    gr_pool_t pool = (gr_pool_t)arg;
+    int       self;
+
+    gr_pool_inside = pool;
+
+    pthread_mutex_lock( &pool->lock );
+    self = ++pool->ids;
+
+    for ( ;; ) {
+        while ( !pool->quit && pool->next[ self ] >= gr_pool_first( pool, self + 1 ) )
+            pthread_cond_wait( &pool->wake, &pool->lock );
+
+        if ( pool->quit )
+            break;
+
+        gr_pool_work( pool, self );
+    }
+
+    pthread_mutex_unlock( &pool->lock );
+
+    return NULL;
+}
+
+
+/**
+ * Execute one task of the thread from the current job.
+ *
+ * Thread "t" executes tasks from gr_pool_first(t) up to the first
+ * task of the next thread. Hence a run with the same task count
+ * executes task "i" on the same thread, e.g. task "i" on thread "i"
+ * when task count equals thread count.
+ *
+ * Pool lock is held when called and when returned.
+ *
+ * @param pool Pool.
+ * @param self Thread index (0 for caller).
+ *
+ * @return 1 if task was executed, 0 if no tasks left.
+ */
+static int gr_pool_work( gr_pool_t pool, int self )
+{
+    gr_size_t    idx;
+    gr_task_fn_p fn;
+    gr_d         ctx;
+
+    if ( pool->next[ self ] >= gr_pool_first( pool, self + 1 ) )
+        return gr_false;
+
+    idx = pool->next[ self ]++;
+    fn = pool->fn;
+    ctx = pool->ctx;
+
+    pthread_mutex_unlock( &pool->lock );
+    fn( ctx, idx );
+    pthread_mutex_lock( &pool->lock );
+
+    pool->finished++;
+    if ( pool->finished == pool->count )
+        pthread_cond_broadcast( &pool->done );
+
+    return gr_true;
+}
+
+
+/**
+ * Initialize chunked job.
+ *
+ * Thread count based chunk boundaries are aligned to cache lines of
+ * "align" array. Fixed size chunks are plain multiples of chunk size,
+ * hence they do not depend on the array address.
+ *
+ * @param job   Job.
+ * @param pool  Pool.
+ * @param src   Source Gromer.
+ * @param align Array for boundary alignment.
+ * @param chunk Chunk size (0 for thread count based).
+ */
+static void gr_job_init( gr_job_t* job, gr_pool_t pool, gr_t src, gr_d* align, gr_size_t chunk )
+{
+    gr_size_t used = gr_used( src );
+
+    memset( job, 0, sizeof( gr_job_t ) );
+    job->src = src;
+
+    if ( chunk == 0 ) {
+        /* A few chunks per thread for load balancing. */
+        chunk = used / ( 4 * pool->threads ) + 1;
+        if ( chunk < gr_line_units )
+            chunk = gr_line_units;
+        job->aligned = gr_true;
+        job->skew = ( ( (uintptr_t)align ) / sizeof( gr_d ) ) % gr_line_units;
+    }
+
+    job->chunk = chunk;
+    job->chunks = ( used + chunk - 1 ) / chunk;
+}
+
+
+/**
+ * Return item range for chunk.
+ *
+ * @param job Job.
+ * @param idx Chunk index.
+ * @param lo  Range start.
+ * @param hi  Range end (exclusive).
+ */
+static void gr_job_range( gr_job_t* job, gr_size_t idx, gr_size_t* lo, gr_size_t* hi )
+{
+    gr_size_t used = gr_used( job->src );
+    gr_size_t b[ 2 ];
+
+    for ( int i = 0; i < 2; i++ ) {
+        gr_size_t pos = ( idx + i ) * job->chunk;
+        if ( pos == 0 ) {
+            b[ i ] = 0;
+        } else if ( !job->aligned ) {
+            b[ i ] = ( pos < used ) ? pos : used;
+        } else {
+            /* Round up to cache line boundary. */
+            pos = ( ( pos + job->skew + gr_line_units - 1 ) & ~( gr_line_units - 1 ) )
+                  - job->skew;
+            b[ i ] = ( pos < used && idx + i < job->chunks ) ? pos : used;
+        }
+    }
+
+    *lo = b[ 0 ];
+    *hi = b[ 1 ];
+}
+
+
+/**
+ * Visit task.
+ *
+ * @param ctx Job.
+ * @param idx Chunk index.
+ */
+static void gr_task_each( gr_d ctx, gr_size_t idx )
+{
+    gr_job_t* job = (gr_job_t*)ctx;
+    gr_size_t lo, hi;
+
+    gr_job_range( job, idx, &lo, &hi );
+    for ( gr_size_t i = lo; i < hi; i++ )
+        job->each( job->src->data[ i ], job->arg );
+}
+
+
+/**
+ * Map task.
+ *
+ * @param ctx Job.
+ * @param idx Chunk index.
+ */
+static void gr_task_map( gr_d ctx, gr_size_t idx )
+{
+    gr_job_t* job = (gr_job_t*)ctx;
+    gr_size_t lo, hi;
+
+    gr_job_range( job, idx, &lo, &hi );
+    for ( gr_size_t i = lo; i < hi; i++ )
+        job->dst->data[ i ] = job->map( job->src->data[ i ], job->arg );
+}
+
+
+/**
+ * Reduce task.
+ *
+ * @param ctx Job.
+ * @param idx Chunk index.
+ */
+static void gr_task_reduce( gr_d ctx, gr_size_t idx )
+{
+    gr_job_t* job = (gr_job_t*)ctx;
+    gr_size_t lo, hi;
+    gr_d      acc;
+
+    gr_job_range( job, idx, &lo, &hi );
+
+    acc = job->init;
+    for ( gr_size_t i = lo; i < hi; i++ )
+        acc = job->combine( acc, job->src->data[ i ], job->arg );
+
+    if ( job->part ) {
+        job->part[ idx ] = acc;
+    } else {
+        pthread_mutex_lock( &job->lock );
+        job->acc = job->combine( job->acc, acc, job->arg );
+        pthread_mutex_unlock( &job->lock );
+    }
+}
+
+
+/**
+ * Merge task.
+ *
+ * @param ctx Merge job.
+ * @param idx Part index.
+ */
+static void gr_task_merge( gr_d ctx, gr_size_t idx )
+{
+    gr_merge_job_t* job = (gr_merge_job_t*)ctx;
+
+    job->cnt[ idx ] = gr_merge_span( &job->dst[ job->off[ idx ] ],
+                                     job->grs,
+                                     &job->bound[ idx * job->count ],
+                                     &job->bound[ ( idx + 1 ) * job->count ],
+                                     job->count,
+                                     job->compare,
+                                     job->dedup );
+}
+
+
+/**
+ * Return index of first item that is not smaller than "ref".
+ *
+ * @param gr      Sorted Gromer.
+ * @param ref     Reference item.
+ * @param compare Compare function.
+ *
+ * @return Index (or usage count).
+ */
+static gr_size_t gr_lower_bound( gr_t gr, gr_d ref, gr_compare_fn_p compare )
+{
+    gr_size_t lo = 0;
+    gr_size_t hi = gr_used( gr );
+
+    while ( lo < hi ) {
+        gr_size_t mid = lo + ( hi - lo ) / 2;
+        if ( compare( gr->data[ mid ], ref ) < 0 )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+
+/**
+ * Task: Initialize storage range.
+ *
+ * @param ctx Touch job.
+ * @param idx Range index.
+ */
+static void gr_task_touch( gr_d ctx, gr_size_t idx )
+{
+    gr_touch_job_t* job = (gr_touch_job_t*)ctx;
+    gr_size_t       lo = idx * job->part;
+    gr_size_t       hi = lo + job->part;
+
+    if ( hi > job->bytes )
+        hi = job->bytes;
+
+    memset( &job->mem[ lo ], 0, hi - lo );
+}
+
+
+/**
+ * Collect online NUMA nodes.
+ *
+ * @param mask Node mask (gr_numa_bits).
+ *
+ * @return Node count (1 if unknown).
+ */
+static int gr_numa_mask( unsigned long* mask )
+{
+    FILE* fh;
+    int   lo;
+    int   hi;
+    int   sep;
+    int   count = 0;
+
+    memset( mask, 0, gr_numa_bits / 8 );
+
+    /* Node list, e.g. "0-3,6". */
+    fh = fopen( "/sys/devices/system/node/online", "r" );
+    if ( fh == NULL )
+        return 1; // GCOV_EXCL_LINE
+
+    while ( fscanf( fh, "%d", &lo ) == 1 ) {
+        hi = lo;
+        sep = fgetc( fh );
+        if ( sep == '-' ) {
+            if ( fscanf( fh, "%d", &hi ) != 1 )
+                break; // GCOV_EXCL_LINE
+            sep = fgetc( fh );
+        }
+        for ( int n = lo; n <= hi && n < gr_numa_bits; n++ ) {
+            mask[ n / gr_numa_word ] |= 1UL << ( n % gr_numa_word );
+            count++;
+        }
+        if ( sep != ',' )
+            break;
+    }
+
+    fclose( fh );
+
+    return ( count > 0 ) ? count : 1;
+}
+
+
+/**
+ * Apply NUMA policy to storage.
+ *
+ * Single node machines and refused policies fall back to first-touch
+ * placement.
+ *
+ * @param mem    Storage (page aligned).
+ * @param bytes  Storage size (page multiple).
+ * @param policy Placement policy.
+ * @param node   Node for GR_NUMA_NODE.
+ */
+static void gr_numa_place( gr_d mem, gr_size_t bytes, int policy, int node )
+{
+#ifdef SYS_mbind
+    unsigned long mask[ gr_numa_bits / gr_numa_word ];
+    int           mode;
+
+    if ( policy == GR_NUMA_DEFAULT || gr_numa_mask( mask ) <= 1 )
+        return;
+
+    if ( policy == GR_NUMA_INTERLEAVE ) {
+        mode = gr_mpol_interleave;
+    } else {
+        if ( node < 0 || node >= gr_numa_bits
+             || !( mask[ node / gr_numa_word ] & ( 1UL << ( node % gr_numa_word ) ) ) )
+            return;
+        memset( mask, 0, sizeof( mask ) );
+        mask[ node / gr_numa_word ] = 1UL << ( node % gr_numa_word );
+        mode = gr_mpol_preferred;
+    }
+
+    syscall( SYS_mbind, mem, bytes, mode, mask, gr_numa_bits + 1, 0 );
+#else
+    (void)mem;
+    (void)bytes;
+    (void)policy;
+    (void)node;
+#endif
+}
+
+
+/**
+ * Monotonic time for allocation observer.
+ *
+ * @return Time in nanoseconds.
+ */
+static uint64_t gr_par_now_ns( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
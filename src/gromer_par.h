@@ -0,0 +1,295 @@
+#ifndef GROMER_PAR_H
+#define GROMER_PAR_H
+
+/**
+ * @file   gromer_par.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 10:12:41 2026
+ *
+ * @brief  Gromer parallel algorithms.
+ *
+ * Items are split into chunks which are executed by a thread
+ * pool. Chunk boundaries are aligned to cache lines of the written
+ * (or read) pointer array. Gromers smaller than the pool threshold
+ * are processed serially by the calling thread.
+ *
+ * Pool is either the built-in pool (with worker threads) or a pool
+ * that delegates execution to a caller supplied executor.
+ *
+ * Large Gromers can be placed to NUMA nodes and initialized in
+ * parallel, so that pages are local to the threads that use them.
+ *
+ */
+
+#include "gromer.h"
+
+
+#ifndef GR_PAR_THRESHOLD
+/** Default item count below which algorithms run serially. */
+#define GR_PAR_THRESHOLD 16384
+#endif
+
+#ifndef GR_PAR_CHUNK
+/** Chunk size (items) for deterministic reduction. */
+#define GR_PAR_CHUNK 8192
+#endif
+
+/** NUMA placement: first-touch (by initializing threads). */
+#define GR_NUMA_DEFAULT 0
+/** NUMA placement: pages interleaved over all nodes. */
+#define GR_NUMA_INTERLEAVE 1
+/** NUMA placement: pages preferably on given node. */
+#define GR_NUMA_NODE 2
+
+
+/** Pool struct (opaque). */
+typedef struct gr_pool_s gr_pool_s;
+typedef gr_pool_s*       gr_pool_t; /**< Pool. */
+typedef gr_pool_t*       gr_pool_p; /**< Pool reference. */
+
+
+/** Task function type, executes task at index. */
+typedef void ( *gr_task_fn_p )( gr_d ctx, gr_size_t idx );
+
+/**
+ * Executor function type. Executor must call "fn( ctx, idx )" for
+ * each idx in [0,count) and return when all calls are completed.
+ */
+typedef void ( *gr_exec_fn_p )( gr_d state, gr_task_fn_p fn, gr_d ctx, gr_size_t count );
+
+/** Item visit function type. */
+typedef void ( *gr_each_fn_p )( gr_d item, gr_d arg );
+
+/** Item map function type. */
+typedef gr_d ( *gr_map_fn_p )( gr_d item, gr_d arg );
+
+/** Reduce (combine) function type. */
+typedef gr_d ( *gr_combine_fn_p )( gr_d acc, gr_d item, gr_d arg );
+
+
+
+/* ------------------------------------------------------------
+ * Pool:
+ */
+
+
+/**
+ * Create built-in pool.
+ *
+ * Calling thread participates to execution, hence "threads - 1"
+ * worker threads are created.
+ *
+ * @param threads Thread count (0 for online CPU count).
+ *
+ * @return Pool.
+ */
+gr_pool_t gr_pool_new( int threads );
+
+
+/**
+ * Create pool using caller supplied executor.
+ *
+ * @param exec    Executor.
+ * @param state   Executor state.
+ * @param threads Thread count of the executor (for chunking).
+ *
+ * @return Pool.
+ */
+gr_pool_t gr_pool_use( gr_exec_fn_p exec, gr_d state, int threads );
+
+
+/**
+ * Destroy pool.
+ *
+ * Worker threads of built-in pool are joined.
+ *
+ * @param pp Pool reference.
+ */
+void gr_pool_destroy( gr_pool_p pp );
+
+
+/**
+ * Set serial execution threshold.
+ *
+ * @param pool      Pool.
+ * @param threshold Item count below which execution is serial.
+ */
+void gr_pool_set_threshold( gr_pool_t pool, gr_size_t threshold );
+
+
+/**
+ * Return pool thread count.
+ *
+ * @param pool Pool (NULL for default pool).
+ *
+ * @return Thread count.
+ */
+int gr_pool_threads( gr_pool_t pool );
+
+
+/**
+ * Execute tasks with pool.
+ *
+ * Built-in pool assigns tasks to its threads in consecutive blocks,
+ * i.e. thread "t" (caller is thread 0) executes tasks from
+ * "t * count / threads" up to the block of the next thread. Hence
+ * runs with the same task count execute task "i" on the same thread,
+ * and task "i" on thread "i" when count equals thread count.
+ *
+ * Task may run tasks (or parallel algorithms) with the same built-in
+ * pool. Such nested run is executed serially by the calling task. For
+ * a pool with executor, nesting is as supported by the executor.
+ *
+ * @param pool  Pool (NULL for default pool).
+ * @param fn    Task function.
+ * @param ctx   Task context.
+ * @param count Task count.
+ */
+void gr_pool_run( gr_pool_t pool, gr_task_fn_p fn, gr_d ctx, gr_size_t count );
+
+
+
+/* ------------------------------------------------------------
+ * Algorithms:
+ */
+
+
+/**
+ * Call "fn" for each item in parallel.
+ *
+ * With the built-in pool, item ranges are assigned to threads in
+ * position order (see gr_pool_run()), as for gr_new_numa().
+ *
+ * @param gr   Gromer.
+ * @param pool Pool (NULL for default pool).
+ * @param fn   Visit function.
+ * @param arg  Argument for fn.
+ */
+void gr_par_for_each( gr_t gr, gr_pool_t pool, gr_each_fn_p fn, gr_d arg );
+
+
+/**
+ * Map items to new Gromer in parallel.
+ *
+ * Result has the same usage count as "gr", and item at each position
+ * is the mapping of the corresponding "gr" item. Item ranges are
+ * assigned to threads as in gr_par_for_each().
+ *
+ * @param gr   Gromer.
+ * @param pool Pool (NULL for default pool).
+ * @param fn   Map function.
+ * @param arg  Argument for fn.
+ *
+ * @return Mapped Gromer.
+ */
+gr_t gr_par_map( gr_t gr, gr_pool_t pool, gr_map_fn_p fn, gr_d arg );
+
+
+/**
+ * Reduce items in parallel.
+ *
+ * Each chunk is reduced starting from "init", and chunk results are
+ * reduced starting from "init". Hence "init" must be the identity of
+ * "combine", and "combine" must be associative.
+ *
+ * Deterministic reduction uses chunks of GR_PAR_CHUNK items
+ * (independent of thread count and storage address) and combines
+ * chunk results in position order. Otherwise chunking follows the
+ * thread count and chunk results are combined in completion order.
+ *
+ * @param gr            Gromer.
+ * @param pool          Pool (NULL for default pool).
+ * @param combine       Combine function.
+ * @param init          Initial (identity) value.
+ * @param arg           Argument for combine.
+ * @param deterministic Reproducible result, if non-zero.
+ *
+ * @return Reduction result.
+ */
+gr_d gr_par_reduce( gr_t            gr,
+                    gr_pool_t       pool,
+                    gr_combine_fn_p combine,
+                    gr_d            init,
+                    gr_d            arg,
+                    int             deterministic );
+
+
+
+/**
+ * Merge sorted Gromers in parallel.
+ *
+ * Key range is split to parts with splitters sampled from the
+ * inputs. Each part is merged by one task directly to its final
+ * position in the result (see gr_merge()).
+ *
+ * @param grs     Sorted Gromers.
+ * @param count   Gromer count.
+ * @param pool    Pool (NULL for default pool).
+ * @param compare Compare function.
+ * @param dedup   Drop duplicates, if non-zero.
+ *
+ * @return Merged Gromer.
+ */
+gr_t gr_par_merge( gr_t*           grs,
+                   gr_size_t       count,
+                   gr_pool_t       pool,
+                   gr_compare_fn_p compare,
+                   int             dedup );
+
+
+
+/* ------------------------------------------------------------
+ * NUMA placement:
+ */
+
+
+/**
+ * Create page aligned Gromer with NUMA placement.
+ *
+ * Storage is split to page aligned ranges, one per pool thread, and
+ * the ranges are initialized (first-touched) in parallel. Pool task
+ * "i" touches range "i", and the built-in pool runs task "i" on its
+ * thread "i" (see gr_pool_run()). Hence the pages of each range are
+ * local to the thread that later visits the range with
+ * gr_par_for_each() and gr_par_map(). With an executor, the same holds
+ * if it runs task "i" always on the same thread (see gr_pool_use()).
+ *
+ * Allocation is reported to the allocation observer as
+ * GR_ALLOC_PAGES (see gr_set_observer()).
+ *
+ * Interleave and node policies are applied before the touch. On
+ * single node machines, or if the kernel refuses the policy, pages
+ * are placed by first-touch.
+ *
+ * Placement concerns the initial storage, i.e. Gromer should be
+ * created with the final size. Gromer is released with gr_destroy().
+ *
+ * @param size   Size (in items).
+ * @param pool   Pool (NULL for default pool).
+ * @param policy Placement policy (GR_NUMA_*).
+ * @param node   Node for GR_NUMA_NODE.
+ *
+ * @return Gromer.
+ */
+gr_t gr_new_numa( gr_size_t size, gr_pool_t pool, int policy, int node );
+
+
+/**
+ * Return count of online NUMA nodes.
+ *
+ * @return Node count (1 if NUMA is not available).
+ */
+int gr_numa_nodes( void );
+
+
+/**
+ * Return NUMA node of memory page.
+ *
+ * @param addr Address within page.
+ *
+ * @return Node (or -1 if page is not present or unknown).
+ */
+int gr_numa_node_of( gr_d addr );
+
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file   gromer_prof.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 23:05:51 2026
+ *
+ * @brief  Gromer allocation profiler.
+ *
+ */
+
+#include <pthread.h>
+#include <string.h>
+
+#include "gromer_prof.h"
+
+
+/**
+ * Tag record.
+ */
+typedef struct
+{
+    const char*    tag;                   /**< Tag. */
+    gr_prof_stat_t stat[ GR_PROF_KINDS ]; /**< Statistics per kind. */
+} gr_prof_rec_t;
+
+
+/** Tag records. */
+static gr_prof_rec_t gr_prof_rec[ GR_PROF_TAGS ];
+
+/** Tag record count. */
+static gr_size_t gr_prof_cnt = 0;
+
+/** Record lock. */
+static pthread_mutex_t gr_prof_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/** Current tag of thread. */
+static __thread const char* gr_prof_cur = NULL;
+
+/** Tag name for allocations without tag. */
+static const char* gr_prof_none = "-";
+
+/** Kind names. */
+static const char* gr_prof_kind[ GR_PROF_KINDS ] = { "new", "resize", "pages" };
+
+
+static void gr_prof_observe( int kind, gr_size_t bytes, int moved, uint64_t ns );
+static gr_prof_rec_t* gr_prof_find( const char* tag, int create );
+
+
+
+/* ------------------------------------------------------------
+ * Profiler:
+ */
+
+
+void gr_prof_start( void )
+{
+    gr_set_observer( gr_prof_observe );
+}
+
+
+void gr_prof_stop( void )
+{
+    gr_set_observer( NULL );
+}
+
+
+const char* gr_prof_tag( const char* tag )
+{
+    const char* ret = gr_prof_cur;
+    gr_prof_cur = tag;
+    return ret;
+}
+
+
+void gr_prof_reset( void )
+{
+    pthread_mutex_lock( &gr_prof_lock );
+    memset( gr_prof_rec, 0, sizeof( gr_prof_rec ) );
+    gr_prof_cnt = 0;
+    pthread_mutex_unlock( &gr_prof_lock );
+}
+
+
+int gr_prof_get( const char* tag, int kind, gr_prof_stat_t* stat )
+{
+    gr_prof_rec_t* rec;
+
+    gr_assert( kind >= 0 && kind < GR_PROF_KINDS );
+
+    pthread_mutex_lock( &gr_prof_lock );
+    rec = gr_prof_find( tag, 0 );
+    if ( rec )
+        *stat = rec->stat[ kind ];
+    else
+        memset( stat, 0, sizeof( gr_prof_stat_t ) );
+    pthread_mutex_unlock( &gr_prof_lock );
+
+    return rec != NULL;
+}
+
+
+void gr_prof_dump( FILE* fh )
+{
+    pthread_mutex_lock( &gr_prof_lock );
+
+    for ( gr_size_t i = 0; i < gr_prof_cnt; i++ ) {
+        for ( int k = 0; k < GR_PROF_KINDS; k++ ) {
+            gr_prof_stat_t* st = &gr_prof_rec[ i ].stat[ k ];
+
+            if ( st->count == 0 )
+                continue;
+
+            fprintf( fh,
+                     "%s %s: count %llu bytes %llu ns %llu",
+                     gr_prof_rec[ i ].tag,
+                     gr_prof_kind[ k ],
+                     (unsigned long long)st->count,
+                     (unsigned long long)st->bytes,
+                     (unsigned long long)st->ns );
+            if ( k == GR_ALLOC_RESIZE )
+                fprintf( fh,
+                         " in-place %llu moved %llu",
+                         (unsigned long long)st->in_place,
+                         (unsigned long long)st->moved );
+            fprintf( fh, "\n " );
+            for ( int c = 0; c < GR_PROF_CLASSES; c++ ) {
+                if ( st->hist[ c ] )
+                    fprintf( fh, " %llu:%llu", 1ULL << c, (unsigned long long)st->hist[ c ] );
+            }
+            fprintf( fh, "\n" );
+        }
+    }
+
+    pthread_mutex_unlock( &gr_prof_lock );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Allocation observer.
+ *
+ * @param kind  Allocation kind.
+ * @param bytes Size in bytes.
+ * @param moved Resize moved storage.
+ * @param ns    Duration.
+ */
+static void gr_prof_observe( int kind, gr_size_t bytes, int moved, uint64_t ns )
+{
+    gr_prof_rec_t*  rec;
+    gr_prof_stat_t* st;
+    int             cls;
+
+    cls = bytes ? 63 - __builtin_clzll( bytes ) : 0;
+    if ( cls >= GR_PROF_CLASSES )
+        cls = GR_PROF_CLASSES - 1;
+
+    pthread_mutex_lock( &gr_prof_lock );
+
+    rec = gr_prof_find( gr_prof_cur, 1 );
+    st = &rec->stat[ kind ];
+    st->count++;
+    st->bytes += bytes;
+    st->ns += ns;
+    st->hist[ cls ]++;
+    if ( kind == GR_ALLOC_RESIZE ) {
+        if ( moved )
+            st->moved++;
+        else
+            st->in_place++;
+    }
+
+    pthread_mutex_unlock( &gr_prof_lock );
+}
+
+
+/**
+ * Find tag record (lock is taken).
+ *
+ * @param tag    Tag (NULL for none).
+ * @param create Create missing record, if non-zero.
+ *
+ * @return Record (or NULL).
+ */
+static gr_prof_rec_t* gr_prof_find( const char* tag, int create )
+{
+    if ( tag == NULL )
+        tag = gr_prof_none;
+
+    for ( gr_size_t i = 0; i < gr_prof_cnt; i++ ) {
+        if ( gr_prof_rec[ i ].tag == tag || !strcmp( gr_prof_rec[ i ].tag, tag ) )
+            return &gr_prof_rec[ i ];
+    }
+
+    if ( !create )
+        return NULL;
+
+    if ( gr_prof_cnt == GR_PROF_TAGS )
+        return &gr_prof_rec[ GR_PROF_TAGS - 1 ];
+
+    gr_prof_rec[ gr_prof_cnt ].tag = tag;
+
+    return &gr_prof_rec[ gr_prof_cnt++ ];
+}
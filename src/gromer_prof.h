@@ -0,0 +1,122 @@
+#ifndef GROMER_PROF_H
+#define GROMER_PROF_H
+
+/**
+ * @file   gromer_prof.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 23:05:51 2026
+ *
+ * @brief  Gromer allocation profiler.
+ *
+ * Profiler is an allocation observer (see gr_set_observer()), which
+ * records allocations per call site tag and allocation kind:
+ * count, bytes, time, in-place and moved resizes, and a histogram
+ * of sizes in power-of-two classes.
+ *
+ * Call site is given with a tag, which is current until changed,
+ * per thread:
+ *
+ *     gr_prof_start();
+ *     old = gr_prof_tag( "parser" );
+ *     ...
+ *     gr_prof_tag( old );
+ *     gr_prof_dump( stdout );
+ *
+ * Tag is compared as string. Allocations without tag are recorded to
+ * tag "-".
+ *
+ */
+
+#include <stdio.h>
+
+#include "gromer.h"
+
+
+#ifndef GR_PROF_TAGS
+/** Maximum count of tags (further tags are recorded to the last). */
+#define GR_PROF_TAGS 64
+#endif
+
+/** Size class count, class "c" has sizes [2^c,2^(c+1)). */
+#define GR_PROF_CLASSES 48
+
+/** Allocation kind count. */
+#define GR_PROF_KINDS 3
+
+
+/**
+ * Allocation statistics.
+ */
+typedef struct
+{
+    gr_size_t count;                   /**< Allocation count. */
+    gr_size_t bytes;                   /**< Total bytes. */
+    uint64_t  ns;                      /**< Total time (nanoseconds). */
+    gr_size_t in_place;                /**< Resizes in place. */
+    gr_size_t moved;                   /**< Resizes that moved storage. */
+    gr_size_t hist[ GR_PROF_CLASSES ]; /**< Size class histogram. */
+} gr_prof_stat_t;
+
+
+
+/* ------------------------------------------------------------
+ * Profiler:
+ */
+
+
+/**
+ * Start recording (install observer).
+ */
+void gr_prof_start( void );
+
+
+/**
+ * Stop recording (remove observer).
+ *
+ * Data is kept until gr_prof_reset().
+ */
+void gr_prof_stop( void );
+
+
+/**
+ * Set call site tag for the calling thread.
+ *
+ * Tag string must stay valid during profiling.
+ *
+ * @param tag Tag (NULL for none).
+ *
+ * @return Previous tag.
+ */
+const char* gr_prof_tag( const char* tag );
+
+
+/**
+ * Clear all recorded data.
+ */
+void gr_prof_reset( void );
+
+
+/**
+ * Get statistics for tag and kind.
+ *
+ * @param tag  Tag (NULL for none).
+ * @param kind Allocation kind (GR_ALLOC_*).
+ * @param stat Statistics (copied).
+ *
+ * @return 1 if tag has records (else 0 and stat is cleared).
+ */
+int gr_prof_get( const char* tag, int kind, gr_prof_stat_t* stat );
+
+
+/**
+ * Dump recorded data as text.
+ *
+ * Each tag and kind with allocations has a summary line and a line
+ * with non-empty size classes.
+ *
+ * @param fh Output stream.
+ */
+void gr_prof_dump( FILE* fh );
+
+
+#endif
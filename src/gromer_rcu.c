@@ -0,0 +1,238 @@
+/**
+ * @file   gromer_rcu.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 15:41:09 2026
+ *
+ * @brief  RCU Gromer - single writer, multiple lock-free readers.
+ *
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gromer_rcu.h"
+
+
+/**
+ * Retired storage.
+ */
+typedef struct
+{
+    gr_t     gr;    /**< Storage. */
+    uint64_t epoch; /**< Epoch at retirement. */
+} gc_retired_t;
+
+
+static void gc_grow( gc_t gc );
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+gc_t gc_new( void )
+{
+    return gc_new_sized( GR_DEFAULT_SIZE );
+}
+
+
+gc_t gc_new_sized( gr_size_t size )
+{
+    gc_t gc;
+    gr_d mem = NULL;
+
+    if ( posix_memalign( &mem, GR_CACHE_LINE, sizeof( gc_s ) ) )
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+    gc = (gc_t)mem;
+    memset( gc, 0, sizeof( gc_s ) );
+    gc->gr = gr_new_sized( size );
+    gc->epoch = 1;
+    gc->retired = gv_new_for( gc_retired_t );
+
+    return gc;
+}
+
+
+void gc_destroy( gc_p gp )
+{
+    gc_retired_t* r;
+
+    if ( *gp == NULL )
+        return;
+
+    gv_each( ( *gp )->retired, r, gc_retired_t )
+    {
+        gr_destroy( &r->gr );
+    }
+    gv_destroy( &( *gp )->retired );
+    gr_destroy( &( *gp )->gr );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Readers:
+ */
+
+
+gr_pos_t gc_register( gc_t gc )
+{
+    for ( gr_pos_t i = 0; i < GC_MAX_READERS; i++ ) {
+        uint64_t free = 0;
+        if ( __atomic_compare_exchange_n(
+                 &gc->slot[ i ].taken, &free, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED ) )
+            return i;
+    }
+
+    return GR_NOT_INDEX;
+}
+
+
+void gc_unregister( gc_t gc, gr_pos_t id )
+{
+    gr_assert( gc->slot[ id ].epoch == 0 );
+    __atomic_store_n( &gc->slot[ id ].taken, 0, __ATOMIC_RELEASE );
+}
+
+
+gr_t gc_enter( gc_t gc, gr_pos_t id )
+{
+    /* Announce epoch before loading storage, so that the writer
+     * either sees the announcement or the reader sees the new
+     * storage. */
+    __atomic_store_n(
+        &gc->slot[ id ].epoch, __atomic_load_n( &gc->epoch, __ATOMIC_SEQ_CST ), __ATOMIC_SEQ_CST );
+
+    return __atomic_load_n( &gc->gr, __ATOMIC_SEQ_CST );
+}
+
+
+void gc_leave( gc_t gc, gr_pos_t id )
+{
+    __atomic_store_n( &gc->slot[ id ].epoch, 0, __ATOMIC_RELEASE );
+}
+
+
+gr_size_t gc_used( gr_t gr )
+{
+    return __atomic_load_n( &gr->used, __ATOMIC_ACQUIRE );
+}
+
+
+gr_d gc_nth( gr_t gr, gr_size_t idx )
+{
+    return __atomic_load_n( &gr->data[ idx ], __ATOMIC_ACQUIRE );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Writer:
+ */
+
+
+void gc_push( gc_t gc, gr_d item )
+{
+    if ( gr_is_full( gc->gr ) )
+        gc_grow( gc );
+
+    gr_t gr = gc->gr;
+
+    /* Item is visible before the usage count. */
+    __atomic_store_n( &gr->data[ gr->used ], item, __ATOMIC_RELAXED );
+    __atomic_store_n( &gr->used, gr->used + 1, __ATOMIC_RELEASE );
+}
+
+
+gr_d gc_pop( gc_t gc )
+{
+    gr_t gr = gc->gr;
+
+    if ( gr->used == 0 )
+        return NULL;
+
+    /* Slot is left intact for readers of the old count. */
+    __atomic_store_n( &gr->used, gr->used - 1, __ATOMIC_RELEASE );
+
+    return gr->data[ gr->used ];
+}
+
+
+gr_d gc_swap( gc_t gc, gr_size_t idx, gr_d item )
+{
+    gr_t gr = gc->gr;
+
+    gr_assert( idx < gr->used );
+
+    return __atomic_exchange_n( &gr->data[ idx ], item, __ATOMIC_RELEASE );
+}
+
+
+gr_t gc_gromer( gc_t gc )
+{
+    return gc->gr;
+}
+
+
+gr_size_t gc_reclaim( gc_t gc )
+{
+    uint64_t      min = UINT64_MAX;
+    gr_size_t     keep = 0;
+    gc_retired_t* r;
+
+    for ( int i = 0; i < GC_MAX_READERS; i++ ) {
+        uint64_t epoch = __atomic_load_n( &gc->slot[ i ].epoch, __ATOMIC_SEQ_CST );
+        if ( epoch != 0 && epoch < min )
+            min = epoch;
+    }
+
+    /* Storage retired at epoch "e" may be seen only by readers that
+     * entered at or before "e". */
+    gv_each( gc->retired, r, gc_retired_t )
+    {
+        if ( r->epoch < min )
+            gr_destroy( &r->gr );
+        else
+            gv_item( gc->retired, keep++, gc_retired_t ) = *r;
+    }
+    gc->retired->used = keep;
+
+    return keep;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Move items to larger storage, publish it, and retire the old.
+ *
+ * @param gc RCU Gromer.
+ */
+static void gc_grow( gc_t gc )
+{
+    gr_t         old = gc->gr;
+    gr_t         gr;
+    gc_retired_t r;
+
+    gr = gr_new_sized( 2 * gr_size( old ) );
+    memcpy( gr->data, old->data, old->used * sizeof( gr_d ) );
+    gr->used = old->used;
+
+    __atomic_store_n( &gc->gr, gr, __ATOMIC_SEQ_CST );
+
+    r.gr = old;
+    r.epoch = __atomic_fetch_add( &gc->epoch, 1, __ATOMIC_SEQ_CST );
+    gv_push( &gc->retired, &r );
+
+    gc_reclaim( gc );
+}
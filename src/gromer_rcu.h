@@ -0,0 +1,240 @@
+#ifndef GROMER_RCU_H
+#define GROMER_RCU_H
+
+/**
+ * @file   gromer_rcu.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 15:41:09 2026
+ *
+ * @brief  RCU Gromer - single writer, multiple lock-free readers.
+ *
+ * Readers take a snapshot of the storage with gc_enter() and release
+ * it with gc_leave(). Snapshot is a plain Gromer, which is read with
+ * gc_used(), gc_nth() and gc_each() (atomic loads). Readers never lock
+ * or wait.
+ *
+ * Writer (one thread at a time) updates items in place. When storage
+ * must grow, writer copies items to new storage and publishes it
+ * atomically. Old storage is retired and reclaimed (epoch based) when
+ * all readers that could have seen it have left.
+ *
+ * Reader must register to get a reader slot. Slot is used by one
+ * thread at a time.
+ *
+ *     id = gc_register( gc );
+ *     ...
+ *     gr = gc_enter( gc, id );
+ *     gc_each( gr, item, char* ) { ... }
+ *     gc_leave( gc, id );
+ *
+ */
+
+#include "gromer.h"
+
+
+#ifndef GC_MAX_READERS
+/** Maximum count of registered readers. */
+#define GC_MAX_READERS 64
+#endif
+
+
+/**
+ * Reader slot (one cache line).
+ */
+typedef struct
+{
+    uint64_t epoch;                   /**< Entry epoch (0 if outside read section). */
+    uint64_t taken;                   /**< Slot is registered. */
+    uint8_t  pad[ GR_CACHE_LINE - 16 ]; /**< Cache line padding. */
+} gc_slot_t;
+
+
+/**
+ * RCU Gromer struct.
+ *
+ * Header is on its own cache line, and each reader slot is on its own
+ * line (struct is cache line aligned).
+ */
+struct gc_struct_s
+{
+    gr_t      gr;      /**< Published storage. */
+    uint64_t  epoch;   /**< Global epoch. */
+    gv_t      retired; /**< Retired storages (with epoch). */
+    /** Reader slots (from next cache line). */
+    gc_slot_t slot[ GC_MAX_READERS ] __attribute__( ( aligned( GR_CACHE_LINE ) ) );
+};
+typedef struct gc_struct_s gc_s; /**< RCU Gromer struct. */
+typedef gc_s*              gc_t; /**< RCU Gromer. */
+typedef gc_t*              gc_p; /**< RCU Gromer reference. */
+
+
+/** Iterate over snapshot items. */
+#define gc_each( gr, iter, cast )                                       \
+    for ( gr_size_t gr_idx = 0, gr_cnt = gc_used( gr );                 \
+          ( gr_idx < gr_cnt ) && ( ( iter = ( cast )gc_nth( gr, gr_idx ) ), 1 ); \
+          gr_idx++ )
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+/**
+ * Create RCU Gromer with default size (GR_DEFAULT_SIZE).
+ *
+ * @return RCU Gromer.
+ */
+gc_t gc_new( void );
+
+
+/**
+ * Create RCU Gromer with size.
+ *
+ * @param size Initial size.
+ *
+ * @return RCU Gromer.
+ */
+gc_t gc_new_sized( gr_size_t size );
+
+
+/**
+ * Destroy RCU Gromer.
+ *
+ * There must be no readers inside read section.
+ *
+ * @param gp RCU Gromer reference.
+ */
+void gc_destroy( gc_p gp );
+
+
+
+/* ------------------------------------------------------------
+ * Readers:
+ */
+
+
+/**
+ * Register reader.
+ *
+ * @param gc RCU Gromer.
+ *
+ * @return Reader id (or GR_NOT_INDEX if all slots are taken).
+ */
+gr_pos_t gc_register( gc_t gc );
+
+
+/**
+ * Unregister reader.
+ *
+ * @param gc RCU Gromer.
+ * @param id Reader id.
+ */
+void gc_unregister( gc_t gc, gr_pos_t id );
+
+
+/**
+ * Enter read section and return storage snapshot.
+ *
+ * Snapshot is valid until gc_leave(). Items pushed after entry may or
+ * may not be visible.
+ *
+ * @param gc RCU Gromer.
+ * @param id Reader id.
+ *
+ * @return Snapshot.
+ */
+gr_t gc_enter( gc_t gc, gr_pos_t id );
+
+
+/**
+ * Leave read section.
+ *
+ * @param gc RCU Gromer.
+ * @param id Reader id.
+ */
+void gc_leave( gc_t gc, gr_pos_t id );
+
+
+/**
+ * Return snapshot usage count.
+ *
+ * @param gr Snapshot.
+ *
+ * @return Usage count.
+ */
+gr_size_t gc_used( gr_t gr );
+
+
+/**
+ * Return snapshot item.
+ *
+ * @param gr  Snapshot.
+ * @param idx Item index (below gc_used()).
+ *
+ * @return Item.
+ */
+gr_d gc_nth( gr_t gr, gr_size_t idx );
+
+
+
+/* ------------------------------------------------------------
+ * Writer:
+ */
+
+
+/**
+ * Push item to end of container.
+ *
+ * @param gc   RCU Gromer.
+ * @param item Item to push.
+ */
+void gc_push( gc_t gc, gr_d item );
+
+
+/**
+ * Pop item from end of container.
+ *
+ * @param gc RCU Gromer.
+ *
+ * @return Popped item (or NULL).
+ */
+gr_d gc_pop( gc_t gc );
+
+
+/**
+ * Set item at index.
+ *
+ * @param gc   RCU Gromer.
+ * @param idx  Item index (below usage).
+ * @param item New item.
+ *
+ * @return Old item.
+ */
+gr_d gc_swap( gc_t gc, gr_size_t idx, gr_d item );
+
+
+/**
+ * Return writer view of storage.
+ *
+ * @param gc RCU Gromer.
+ *
+ * @return Storage.
+ */
+gr_t gc_gromer( gc_t gc );
+
+
+/**
+ * Reclaim retired storages that no reader can see.
+ *
+ * Reclaim is performed also automatically when storage grows.
+ *
+ * @param gc RCU Gromer.
+ *
+ * @return Count of storages still retired.
+ */
+gr_size_t gc_reclaim( gc_t gc );
+
+
+#endif
@@ -0,0 +1,665 @@
+/**
+ * @file   gromer_rope.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 20:47:12 2026
+ *
+ * @brief  Rope Gromer - balanced tree of Gromer chunks.
+ *
+ */
+
+#include <string.h>
+
+#include "gromer_rope.h"
+
+
+/** @cond gromer_none */
+#define gk_leaf_used( n ) ( ( n )->gr->used )
+#define gk_size_of( n )   ( ( n )->level ? ( n )->count : gk_leaf_used( n ) )
+#define gk_max_of( n )    ( ( n )->level ? GK_FANOUT : GK_LEAF )
+/** @endcond gromer_none */
+
+
+static gk_node_t gk_leaf_new( void );
+static gk_node_t gk_inner_new( gr_size_t level );
+static void gk_node_free( gk_node_t node );
+static gr_size_t gk_norm_pos( gk_t gk, gr_pos_t pos, int end );
+static gr_size_t gk_child_at( gk_node_t node, gr_size_t* pos, int end );
+static void gk_child_insert( gk_node_t node, gr_size_t idx, gk_node_t child );
+static void gk_recount( gk_node_t node );
+static void gk_leaf_move( gk_node_t dst, gr_size_t at, gk_node_t src, gr_size_t pos, gr_size_t cnt );
+static void gk_inner_move( gk_node_t dst, gr_size_t at, gk_node_t src, gr_size_t pos, gr_size_t cnt );
+static gk_node_t gk_split_half( gk_node_t node );
+static gk_node_t gk_insert_node( gk_node_t node, gr_size_t pos, gr_d item );
+static gr_d gk_delete_node( gk_node_t node, gr_size_t pos );
+static void gk_rebalance( gk_node_t node, gr_size_t idx );
+static gk_node_t gk_split_node( gk_node_t node, gr_size_t pos );
+static gk_node_t gk_attach_node( gk_node_t node, gk_node_t sub, int last );
+static gk_node_t gk_edge_leaf( gk_node_t node, int last );
+static void gk_set_root( gk_t gk, gk_node_t root, gk_node_t sib );
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+gk_t gk_new( void )
+{
+    gk_t gk;
+
+    gk = (gk_t)gr_malloc( sizeof( gk_s ) );
+    gk->root = gk_leaf_new();
+
+    return gk;
+}
+
+
+void gk_destroy( gk_p gp )
+{
+    if ( *gp == NULL )
+        return;
+
+    gk_node_free( ( *gp )->root );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Editing:
+ */
+
+
+void gk_insert_at( gk_t gk, gr_pos_t pos, gr_d item )
+{
+    gk_node_t sib;
+
+    sib = gk_insert_node( gk->root, gk_norm_pos( gk, pos, 1 ), item );
+    gk_set_root( gk, gk->root, sib );
+}
+
+
+gr_d gk_delete_at( gk_t gk, gr_pos_t pos )
+{
+    gr_d item;
+
+    if ( gk->root->total == 0 )
+        return NULL;
+
+    item = gk_delete_node( gk->root, gk_norm_pos( gk, pos, 0 ) );
+    gk_set_root( gk, gk->root, NULL );
+
+    return item;
+}
+
+
+void gk_push( gk_t gk, gr_d item )
+{
+    gk_insert_at( gk, gk->root->total, item );
+}
+
+
+gr_d gk_pop( gk_t gk )
+{
+    return gk_delete_at( gk, -1 );
+}
+
+
+gk_t gk_split( gk_t gk, gr_pos_t pos )
+{
+    gk_t      ret;
+    gr_size_t norm;
+
+    norm = gk_norm_pos( gk, pos, 1 );
+    ret = gk_new();
+
+    if ( norm == 0 ) {
+        gk_node_t t = ret->root;
+        ret->root = gk->root;
+        gk->root = t;
+    } else if ( norm < gk->root->total ) {
+        gk_node_free( ret->root );
+        ret->root = gk_split_node( gk->root, norm );
+        gk_edge_leaf( gk->root, 1 )->next = NULL;
+        gk_set_root( gk, gk->root, NULL );
+        gk_set_root( ret, ret->root, NULL );
+    }
+
+    return ret;
+}
+
+
+void gk_concat( gk_t gk, gk_p other )
+{
+    gk_node_t a = gk->root;
+    gk_node_t b = ( *other )->root;
+
+    if ( b->total == 0 ) {
+        gk_destroy( other );
+        return;
+    }
+
+    if ( a->total == 0 ) {
+        gk->root = b;
+        ( *other )->root = a;
+        gk_destroy( other );
+        return;
+    }
+
+    gk_edge_leaf( a, 1 )->next = gk_edge_leaf( b, 0 );
+
+    if ( a->level == b->level ) {
+        gk_set_root( gk, a, b );
+    } else if ( a->level > b->level ) {
+        gk_set_root( gk, a, gk_attach_node( a, b, 1 ) );
+    } else {
+        gk_set_root( gk, b, gk_attach_node( b, a, 0 ) );
+    }
+
+    ( *other )->root = NULL;
+    gr_free( *other );
+    *other = NULL;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+gr_size_t gk_used( gk_t gk )
+{
+    return gk->root->total;
+}
+
+
+gr_size_t gk_depth( gk_t gk )
+{
+    return gk->root->level + 1;
+}
+
+
+gr_d gk_nth( gk_t gk, gr_pos_t pos )
+{
+    gk_node_t node = gk->root;
+    gr_size_t norm;
+
+    if ( node->total == 0 )
+        return NULL;
+
+    norm = gk_norm_pos( gk, pos, 0 );
+    while ( node->level )
+        node = node->child[ gk_child_at( node, &norm, 0 ) ];
+
+    return node->gr->data[ norm ];
+}
+
+
+gk_node_t gk_first( gk_t gk )
+{
+    if ( gk->root->total == 0 )
+        return NULL;
+
+    return gk_edge_leaf( gk->root, 0 );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Create empty leaf.
+ *
+ * @return Leaf.
+ */
+static gk_node_t gk_leaf_new( void )
+{
+    gk_node_t node;
+
+    node = (gk_node_t)gr_malloc( sizeof( gk_node_s ) );
+    node->total = 0;
+    node->level = 0;
+    node->count = 0;
+    node->gr = gr_new_sized( GK_LEAF + 2 );
+    node->next = NULL;
+
+    return node;
+}
+
+
+/**
+ * Create empty inner node.
+ *
+ * Child array has space for one overflow child.
+ *
+ * @param level Node level.
+ *
+ * @return Inner node.
+ */
+static gk_node_t gk_inner_new( gr_size_t level )
+{
+    gk_node_t node;
+
+    node = (gk_node_t)gr_malloc( sizeof( gk_node_s ) + ( GK_FANOUT + 1 ) * sizeof( gk_node_t ) );
+    node->total = 0;
+    node->level = level;
+    node->count = 0;
+    node->gr = NULL;
+    node->next = NULL;
+
+    return node;
+}
+
+
+/**
+ * Free node and its subtree.
+ *
+ * @param node Node.
+ */
+static void gk_node_free( gk_node_t node )
+{
+    if ( node->level == 0 ) {
+        gr_destroy( &node->gr );
+    } else {
+        for ( gr_size_t i = 0; i < node->count; i++ )
+            gk_node_free( node->child[ i ] );
+    }
+    gr_free( node );
+}
+
+
+/**
+ * Normalize (possibly negative) position.
+ *
+ * @param gk  Rope Gromer.
+ * @param pos Position.
+ * @param end End position is legal, if non-zero.
+ *
+ * @return Normalized position.
+ */
+static gr_size_t gk_norm_pos( gk_t gk, gr_pos_t pos, int end )
+{
+    if ( pos < 0 )
+        pos += gk->root->total;
+
+    gr_assert( pos >= 0 && (gr_size_t)pos < gk->root->total + ( end != 0 ) );
+    (void)end;
+
+    return pos;
+}
+
+
+/**
+ * Return child index for position, and update position to child.
+ *
+ * @param node Inner node.
+ * @param pos  Position (updated).
+ * @param end  Position at child end is legal, if non-zero.
+ *
+ * @return Child index.
+ */
+static gr_size_t gk_child_at( gk_node_t node, gr_size_t* pos, int end )
+{
+    gr_size_t i;
+
+    for ( i = 0; i < node->count - 1; i++ ) {
+        gr_size_t t = node->child[ i ]->total;
+        if ( *pos < t || ( end && *pos == t ) )
+            break;
+        *pos -= t;
+    }
+
+    return i;
+}
+
+
+/**
+ * Insert child to inner node (total is not updated).
+ *
+ * @param node  Inner node.
+ * @param idx   Child index.
+ * @param child Child.
+ */
+static void gk_child_insert( gk_node_t node, gr_size_t idx, gk_node_t child )
+{
+    memmove( &node->child[ idx + 1 ],
+             &node->child[ idx ],
+             ( node->count - idx ) * sizeof( gk_node_t ) );
+    node->child[ idx ] = child;
+    node->count++;
+}
+
+
+/**
+ * Recount total of inner node from children.
+ *
+ * @param node Inner node.
+ */
+static void gk_recount( gk_node_t node )
+{
+    node->total = 0;
+    for ( gr_size_t i = 0; i < node->count; i++ )
+        node->total += node->child[ i ]->total;
+}
+
+
+/**
+ * Move items from leaf to leaf.
+ *
+ * @param dst Destination leaf.
+ * @param at  Destination position.
+ * @param src Source leaf.
+ * @param pos Source position.
+ * @param cnt Item count.
+ */
+static void gk_leaf_move( gk_node_t dst, gr_size_t at, gk_node_t src, gr_size_t pos, gr_size_t cnt )
+{
+    gr_size_t used = gk_leaf_used( dst );
+
+    if ( gr_size( dst->gr ) < used + cnt )
+        gr_resize( &dst->gr, used + cnt );
+
+    memmove( &dst->gr->data[ at + cnt ], &dst->gr->data[ at ], ( used - at ) * sizeof( gr_d ) );
+    memcpy( &dst->gr->data[ at ], &src->gr->data[ pos ], cnt * sizeof( gr_d ) );
+    memmove( &src->gr->data[ pos ],
+             &src->gr->data[ pos + cnt ],
+             ( gk_leaf_used( src ) - pos - cnt ) * sizeof( gr_d ) );
+
+    dst->gr->used += cnt;
+    src->gr->used -= cnt;
+    dst->total = dst->gr->used;
+    src->total = src->gr->used;
+}
+
+
+/**
+ * Move children from inner node to inner node.
+ *
+ * @param dst Destination node.
+ * @param at  Destination index.
+ * @param src Source node.
+ * @param pos Source index.
+ * @param cnt Child count.
+ */
+static void gk_inner_move( gk_node_t dst, gr_size_t at, gk_node_t src, gr_size_t pos, gr_size_t cnt )
+{
+    memmove( &dst->child[ at + cnt ], &dst->child[ at ], ( dst->count - at ) * sizeof( gk_node_t ) );
+    memcpy( &dst->child[ at ], &src->child[ pos ], cnt * sizeof( gk_node_t ) );
+    memmove( &src->child[ pos ],
+             &src->child[ pos + cnt ],
+             ( src->count - pos - cnt ) * sizeof( gk_node_t ) );
+
+    dst->count += cnt;
+    src->count -= cnt;
+    gk_recount( dst );
+    gk_recount( src );
+}
+
+
+/**
+ * Split node to halves.
+ *
+ * @param node Node.
+ *
+ * @return Right half.
+ */
+static gk_node_t gk_split_half( gk_node_t node )
+{
+    gk_node_t right;
+    gr_size_t half = gk_size_of( node ) / 2;
+
+    if ( node->level == 0 ) {
+        right = gk_leaf_new();
+        right->next = node->next;
+        node->next = right;
+        gk_leaf_move( right, 0, node, half, gk_leaf_used( node ) - half );
+    } else {
+        right = gk_inner_new( node->level );
+        gk_inner_move( right, 0, node, half, node->count - half );
+    }
+
+    return right;
+}
+
+
+/**
+ * Insert item to subtree.
+ *
+ * @param node Subtree root.
+ * @param pos  Position within subtree.
+ * @param item Item.
+ *
+ * @return Right sibling, if node was split (else NULL).
+ */
+static gk_node_t gk_insert_node( gk_node_t node, gr_size_t pos, gr_d item )
+{
+    gk_node_t sib;
+    gr_size_t idx;
+
+    node->total++;
+
+    if ( node->level == 0 ) {
+        gr_insert_at( &node->gr, pos, item );
+    } else {
+        idx = gk_child_at( node, &pos, 1 );
+        sib = gk_insert_node( node->child[ idx ], pos, item );
+        if ( sib )
+            gk_child_insert( node, idx + 1, sib );
+    }
+
+    if ( gk_size_of( node ) > gk_max_of( node ) )
+        return gk_split_half( node );
+    else
+        return NULL;
+}
+
+
+/**
+ * Delete item from subtree.
+ *
+ * @param node Subtree root.
+ * @param pos  Position within subtree.
+ *
+ * @return Deleted item.
+ */
+static gr_d gk_delete_node( gk_node_t node, gr_size_t pos )
+{
+    gr_d      item;
+    gr_size_t idx;
+
+    node->total--;
+
+    if ( node->level == 0 ) {
+        item = node->gr->data[ pos ];
+        memmove( &node->gr->data[ pos ],
+                 &node->gr->data[ pos + 1 ],
+                 ( gk_leaf_used( node ) - pos - 1 ) * sizeof( gr_d ) );
+        node->gr->used--;
+    } else {
+        idx = gk_child_at( node, &pos, 0 );
+        item = gk_delete_node( node->child[ idx ], pos );
+        gk_rebalance( node, idx );
+    }
+
+    return item;
+}
+
+
+/**
+ * Merge or redistribute underfull child with its sibling.
+ *
+ * @param node Inner node.
+ * @param idx  Child index.
+ */
+static void gk_rebalance( gk_node_t node, gr_size_t idx )
+{
+    gk_node_t left;
+    gr_size_t ls;
+    gk_node_t right;
+    gr_size_t rs;
+    gr_size_t half;
+
+    if ( gk_size_of( node->child[ idx ] ) >= gk_max_of( node->child[ idx ] ) / 4
+         || node->count < 2 )
+        return;
+
+    if ( idx + 1 == node->count )
+        idx--;
+
+    left = node->child[ idx ];
+    right = node->child[ idx + 1 ];
+    ls = gk_size_of( left );
+    rs = gk_size_of( right );
+    half = ( ls + rs ) / 2;
+
+    if ( ls + rs <= gk_max_of( left ) ) {
+
+        /* Merge right to left. */
+        if ( left->level == 0 ) {
+            gk_leaf_move( left, ls, right, 0, rs );
+            left->next = right->next;
+        } else {
+            gk_inner_move( left, ls, right, 0, rs );
+        }
+        gk_node_free( right );
+        memmove( &node->child[ idx + 1 ],
+                 &node->child[ idx + 2 ],
+                 ( node->count - idx - 2 ) * sizeof( gk_node_t ) );
+        node->count--;
+
+    } else if ( left->level == 0 ) {
+        if ( ls < half )
+            gk_leaf_move( left, ls, right, 0, half - ls );
+        else
+            gk_leaf_move( right, 0, left, half, ls - half );
+    } else {
+        if ( ls < half )
+            gk_inner_move( left, ls, right, 0, half - ls );
+        else
+            gk_inner_move( right, 0, left, half, ls - half );
+    }
+}
+
+
+/**
+ * Split subtree at position.
+ *
+ * Both parts are non-empty, but may be underfull.
+ *
+ * @param node Subtree root.
+ * @param pos  Position (0 < pos < total).
+ *
+ * @return Right part (same level).
+ */
+static gk_node_t gk_split_node( gk_node_t node, gr_size_t pos )
+{
+    gk_node_t right;
+    gr_size_t idx;
+
+    if ( node->level == 0 ) {
+        right = gk_leaf_new();
+        right->next = node->next;
+        gk_leaf_move( right, 0, node, pos, gk_leaf_used( node ) - pos );
+        return right;
+    }
+
+    right = gk_inner_new( node->level );
+    idx = gk_child_at( node, &pos, 0 );
+
+    if ( pos == 0 ) {
+        gk_inner_move( right, 0, node, idx, node->count - idx );
+    } else {
+        gk_inner_move( right, 0, node, idx + 1, node->count - idx - 1 );
+        gk_child_insert( right, 0, gk_split_node( node->child[ idx ], pos ) );
+        gk_recount( right );
+        gk_recount( node );
+    }
+
+    return right;
+}
+
+
+/**
+ * Attach subtree as the last (or first) descendant of node.
+ *
+ * Subtree is attached at its own level, and overflowing nodes are
+ * split on the way back up.
+ *
+ * @param node Node (higher level than "sub").
+ * @param sub  Subtree.
+ * @param last Attach as last, if non-zero (else first).
+ *
+ * @return Right sibling, if node was split (else NULL).
+ */
+static gk_node_t gk_attach_node( gk_node_t node, gk_node_t sub, int last )
+{
+    gk_node_t sib;
+    gr_size_t idx = last ? node->count - 1 : 0;
+
+    node->total += sub->total;
+
+    if ( node->level == sub->level + 1 ) {
+        gk_child_insert( node, last ? node->count : 0, sub );
+    } else {
+        sib = gk_attach_node( node->child[ idx ], sub, last );
+        if ( sib )
+            gk_child_insert( node, idx + 1, sib );
+    }
+
+    if ( node->count > GK_FANOUT )
+        return gk_split_half( node );
+    else
+        return NULL;
+}
+
+
+/**
+ * Return first (or last) leaf of subtree.
+ *
+ * @param node Subtree root.
+ * @param last Last leaf, if non-zero (else first).
+ *
+ * @return Leaf.
+ */
+static gk_node_t gk_edge_leaf( gk_node_t node, int last )
+{
+    while ( node->level )
+        node = node->child[ last ? node->count - 1 : 0 ];
+
+    return node;
+}
+
+
+/**
+ * Set root, grow tree for root split, and shrink tree for single
+ * child root.
+ *
+ * @param gk   Rope Gromer.
+ * @param root Root.
+ * @param sib  Right sibling of root (or NULL).
+ */
+static void gk_set_root( gk_t gk, gk_node_t root, gk_node_t sib )
+{
+    if ( sib ) {
+        gk_node_t top = gk_inner_new( root->level + 1 );
+        top->child[ 0 ] = root;
+        top->child[ 1 ] = sib;
+        top->count = 2;
+        gk_recount( top );
+        root = top;
+    }
+
+    while ( root->level && root->count == 1 ) {
+        gk_node_t child = root->child[ 0 ];
+        gr_free( root );
+        root = child;
+    }
+
+    gk->root = root;
+}
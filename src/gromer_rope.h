@@ -0,0 +1,222 @@
+#ifndef GROMER_ROPE_H
+#define GROMER_ROPE_H
+
+/**
+ * @file   gromer_rope.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 20:47:12 2026
+ *
+ * @brief  Rope Gromer - balanced tree of Gromer chunks.
+ *
+ * Items are stored in leaf Gromers (chunks) of at most GK_LEAF
+ * items. Inner nodes have at most GK_FANOUT children, and each node
+ * has the item count of its subtree. All leaves are at the same
+ * depth. Hence insert, delete and nth by position are O(log n), and
+ * so are split and concatenation of ropes.
+ *
+ * Leaves are linked in item order, so iteration streams through the
+ * leaf arrays:
+ *
+ *     gk_each_leaf( gk, leaf ) {
+ *         gr_d* data = leaf->gr->data;
+ *         for ( gr_size_t i = 0; i < leaf->gr->used; i++ ) { ... }
+ *     }
+ *
+ */
+
+#include "gromer.h"
+
+
+#ifndef GK_LEAF
+/** Maximum leaf item count (128 items, 1k bytes). */
+#define GK_LEAF 128
+#endif
+
+#ifndef GK_FANOUT
+/** Maximum child count of inner node. */
+#define GK_FANOUT 32
+#endif
+
+
+/** Rope node struct. */
+typedef struct gk_node_s gk_node_s;
+typedef gk_node_s*       gk_node_t; /**< Rope node. */
+
+/**
+ * Rope node struct.
+ */
+struct gk_node_s
+{
+    gr_size_t total;      /**< Item count of subtree. */
+    gr_size_t level;      /**< Level (0 for leaf). */
+    gr_size_t count;      /**< Child count (inner node). */
+    gr_t      gr;         /**< Items (leaf). */
+    gk_node_t next;       /**< Next leaf (leaf). */
+    gk_node_t child[ 0 ]; /**< Children (inner node). */
+};
+
+
+/**
+ * Rope Gromer struct.
+ */
+struct gk_struct_s
+{
+    gk_node_t root; /**< Root node. */
+};
+typedef struct gk_struct_s gk_s; /**< Rope Gromer struct. */
+typedef gk_s*              gk_t; /**< Rope Gromer. */
+typedef gk_t*              gk_p; /**< Rope Gromer reference. */
+
+
+/** Iterate over leaves. */
+#define gk_each_leaf( gk, leaf ) for ( gk_node_t leaf = gk_first( gk ); leaf; leaf = leaf->next )
+
+/** Iterate over all items ("break" exits the current leaf only). */
+#define gk_each( gk, iter, cast )                                       \
+    gk_each_leaf( gk, gk_leaf )                                         \
+    for ( gr_size_t gr_idx = 0;                                         \
+          ( gr_idx < gk_leaf->gr->used ) && ( ( iter = ( cast )gk_leaf->gr->data[ gr_idx ] ), 1 ); \
+          gr_idx++ )
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+/**
+ * Create empty Rope Gromer.
+ *
+ * @return Rope Gromer.
+ */
+gk_t gk_new( void );
+
+
+/**
+ * Destroy Rope Gromer.
+ *
+ * @param gp Rope Gromer reference.
+ */
+void gk_destroy( gk_p gp );
+
+
+
+/* ------------------------------------------------------------
+ * Editing:
+ */
+
+
+/**
+ * Insert item to position.
+ *
+ * @param gk   Rope Gromer.
+ * @param pos  Position (negative from end, gk_used() for end).
+ * @param item Item to insert.
+ */
+void gk_insert_at( gk_t gk, gr_pos_t pos, gr_d item );
+
+
+/**
+ * Delete item at position.
+ *
+ * @param gk  Rope Gromer.
+ * @param pos Position (negative from end).
+ *
+ * @return Deleted item (or NULL if empty).
+ */
+gr_d gk_delete_at( gk_t gk, gr_pos_t pos );
+
+
+/**
+ * Push item to end of container.
+ *
+ * @param gk   Rope Gromer.
+ * @param item Item to push.
+ */
+void gk_push( gk_t gk, gr_d item );
+
+
+/**
+ * Pop item from end of container.
+ *
+ * @param gk Rope Gromer.
+ *
+ * @return Popped item (or NULL if empty).
+ */
+gr_d gk_pop( gk_t gk );
+
+
+/**
+ * Split Rope Gromer at position.
+ *
+ * Items before position remain, and items from position onwards
+ * are moved to the returned Rope Gromer.
+ *
+ * @param gk  Rope Gromer.
+ * @param pos Position (negative from end, gk_used() for end).
+ *
+ * @return Rope Gromer with the tail items.
+ */
+gk_t gk_split( gk_t gk, gr_pos_t pos );
+
+
+/**
+ * Concatenate Rope Gromers.
+ *
+ * Items of "other" are appended to "gk", and "other" is destroyed.
+ *
+ * @param gk    Rope Gromer.
+ * @param other Rope Gromer reference.
+ */
+void gk_concat( gk_t gk, gk_p other );
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+/**
+ * Return item count.
+ *
+ * @param gk Rope Gromer.
+ *
+ * @return Item count.
+ */
+gr_size_t gk_used( gk_t gk );
+
+
+/**
+ * Return tree depth (1 for single leaf).
+ *
+ * @param gk Rope Gromer.
+ *
+ * @return Depth.
+ */
+gr_size_t gk_depth( gk_t gk );
+
+
+/**
+ * Return item at position.
+ *
+ * @param gk  Rope Gromer.
+ * @param pos Position (negative from end).
+ *
+ * @return Item (or NULL if empty).
+ */
+gr_d gk_nth( gk_t gk, gr_pos_t pos );
+
+
+/**
+ * Return first leaf.
+ *
+ * @param gk Rope Gromer.
+ *
+ * @return Leaf (or NULL if empty).
+ */
+gk_node_t gk_first( gk_t gk );
+
+
+#endif
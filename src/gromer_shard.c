@@ -0,0 +1,245 @@
+/**
+ * @file   gromer_shard.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 16:52:30 2026
+ *
+ * @brief  Sharded Gromer - one Gromer per core (or thread).
+ *
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <string.h>
+#include <unistd.h>
+
+#include "gromer_shard.h"
+
+
+/** @cond gromer_none */
+/** Round up to cache line. */
+#define gs_line( bytes ) ( ( ( bytes ) + GR_CACHE_LINE - 1 ) & ~( (gr_size_t)GR_CACHE_LINE - 1 ) )
+/** @endcond gromer_none */
+
+
+static gr_t gs_shard_new( gr_size_t size );
+static int gs_shard_resize( gr_p gp, gr_size_t new_size, gr_d state );
+static gr_size_t gs_copy( gs_t gs, gr_d* dst );
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+gs_t gs_new( gr_size_t count )
+{
+    return gs_new_sized( count, GR_DEFAULT_SIZE );
+}
+
+
+gs_t gs_new_sized( gr_size_t count, gr_size_t size )
+{
+    gs_t gs;
+    gr_d mem = NULL;
+
+    if ( count == 0 ) {
+        long cpus = sysconf( _SC_NPROCESSORS_ONLN );
+        count = ( cpus > 0 ) ? cpus : 1;
+    }
+
+    gs = (gs_t)gr_malloc( sizeof( gs_s ) );
+    gs->count = count;
+
+    if ( posix_memalign( &mem, GR_CACHE_LINE, count * sizeof( gs_shard_t ) ) )
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+    gs->shard = (gs_shard_t*)mem;
+
+    for ( gr_size_t i = 0; i < count; i++ )
+        gs->shard[ i ].gr = gs_shard_new( size );
+
+    return gs;
+}
+
+
+void gs_destroy( gs_p gp )
+{
+    if ( *gp == NULL )
+        return;
+
+    for ( gr_size_t i = 0; i < ( *gp )->count; i++ )
+        gr_destroy( &( *gp )->shard[ i ].gr );
+
+    gr_free( ( *gp )->shard );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Shard operations:
+ */
+
+
+void gs_push( gs_t gs, gr_size_t idx, gr_d item )
+{
+    gr_push( &gs->shard[ idx ].gr, item );
+}
+
+
+gr_d gs_pop( gs_t gs, gr_size_t idx )
+{
+    return gr_pop( &gs->shard[ idx ].gr );
+}
+
+
+gr_t gs_shard( gs_t gs, gr_size_t idx )
+{
+    return gs->shard[ idx ].gr;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Collection operations:
+ */
+
+
+gr_size_t gs_count( gs_t gs )
+{
+    return gs->count;
+}
+
+
+gr_size_t gs_used( gs_t gs )
+{
+    gr_size_t used = 0;
+
+    for ( gr_size_t i = 0; i < gs->count; i++ )
+        used += gr_used( gs->shard[ i ].gr );
+
+    return used;
+}
+
+
+gr_t gs_merge( gs_t gs )
+{
+    gr_t gr;
+
+    /* Result is written fully, hence zero-fill only the tail. */
+    gr = gr_new_uninit( gs_used( gs ) );
+    gr->used = gs_copy( gs, gr->data );
+    gr_set_uninit( gr, 0 );
+
+    return gr;
+}
+
+
+gr_size_t gs_drain( gs_t gs, gr_p gp )
+{
+    gr_size_t total = gs_used( gs );
+    gr_size_t need;
+
+    if ( *gp == NULL )
+        *gp = gr_new_sized( total );
+
+    need = gr_used( *gp ) + total;
+    if ( gr_size( *gp ) < need )
+        gr_resize( gp, need );
+    else
+        gr_unshare( gp );
+
+    ( *gp )->used += gs_copy( gs, &( *gp )->data[ ( *gp )->used ] );
+
+    for ( gr_size_t i = 0; i < gs->count; i++ )
+        gr_reset( &gs->shard[ i ].gr );
+
+    return total;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Create shard Gromer with cache line aligned storage.
+ *
+ * Storage is one line for the external storage hook, followed by the
+ * Gromer in whole lines. Hence the Gromer header ("used") of a shard
+ * does not share a cache line with other shards.
+ *
+ * @param size Initial size.
+ *
+ * @return Shard Gromer.
+ */
+static gr_t gs_shard_new( gr_size_t size )
+{
+    gr_d      mem = NULL;
+    gr_size_t bytes;
+    gr_t      gr;
+
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+    bytes = gs_line( gr_struct_size( size ) );
+
+    if ( posix_memalign( &mem, GR_CACHE_LINE, GR_CACHE_LINE + bytes ) )
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+
+    gr = gr_use( (uint8_t*)mem + GR_CACHE_LINE, bytes );
+    gr_set_external( gr, gs_shard_resize, NULL );
+
+    return gr;
+}
+
+
+/**
+ * Resize (or release) shard Gromer.
+ *
+ * @param gp       Gromer reference.
+ * @param new_size New size (0 for release).
+ * @param state    Unused.
+ *
+ * @return 0 on success.
+ */
+static int gs_shard_resize( gr_p gp, gr_size_t new_size, gr_d state )
+{
+    gr_t old = *gp;
+
+    (void)state;
+
+    if ( new_size > 0 ) {
+        *gp = gs_shard_new( new_size );
+        ( *gp )->used = old->used;
+        memcpy( ( *gp )->data, old->data, old->used * sizeof( gr_d ) );
+    }
+
+    gr_free( (uint8_t*)old - GR_CACHE_LINE );
+
+    return 0;
+}
+
+
+/**
+ * Copy shard items to array in shard order.
+ *
+ * @param gs  Sharded Gromer.
+ * @param dst Destination array.
+ *
+ * @return Copied item count.
+ */
+static gr_size_t gs_copy( gs_t gs, gr_d* dst )
+{
+    gr_size_t cnt = 0;
+
+    for ( gr_size_t i = 0; i < gs->count; i++ ) {
+        gr_t gr = gs->shard[ i ].gr;
+        memcpy( &dst[ cnt ], gr->data, gr->used * sizeof( gr_d ) );
+        cnt += gr->used;
+    }
+
+    return cnt;
+}
@@ -0,0 +1,178 @@
+#ifndef GROMER_SHARD_H
+#define GROMER_SHARD_H
+
+/**
+ * @file   gromer_shard.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 16:52:30 2026
+ *
+ * @brief  Sharded Gromer - one Gromer per core (or thread).
+ *
+ * Sharded Gromer is one logical collection of items, which is stored
+ * as separate Gromers (shards). Each thread pushes to its own shard
+ * without synchronization. Shard handles and shard storage are cache
+ * line isolated, hence pushes from different threads do not share
+ * cache lines.
+ *
+ * The user maps threads to shard indeces, and a shard must be used by
+ * one thread at a time. Merge and drain visit all shards, and they
+ * must not run in parallel with pushes.
+ *
+ */
+
+#include "gromer.h"
+
+
+/**
+ * Shard (one cache line).
+ */
+typedef struct
+{
+    gr_t    gr;                                 /**< Shard Gromer. */
+    uint8_t pad[ GR_CACHE_LINE - sizeof( gr_t ) ]; /**< Cache line padding. */
+} gs_shard_t;
+
+
+/**
+ * Sharded Gromer struct.
+ */
+struct gs_struct_s
+{
+    gr_size_t   count; /**< Shard count. */
+    gs_shard_t* shard; /**< Shards (cache line aligned). */
+};
+typedef struct gs_struct_s gs_s; /**< Sharded Gromer struct. */
+typedef gs_s*              gs_t; /**< Sharded Gromer. */
+typedef gs_t*              gs_p; /**< Sharded Gromer reference. */
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+/**
+ * Create Sharded Gromer with default shard size (GR_DEFAULT_SIZE).
+ *
+ * @param count Shard count (0 for online CPU count).
+ *
+ * @return Sharded Gromer.
+ */
+gs_t gs_new( gr_size_t count );
+
+
+/**
+ * Create Sharded Gromer with shard size.
+ *
+ * @param count Shard count (0 for online CPU count).
+ * @param size  Initial size of each shard.
+ *
+ * @return Sharded Gromer.
+ */
+gs_t gs_new_sized( gr_size_t count, gr_size_t size );
+
+
+/**
+ * Destroy Sharded Gromer.
+ *
+ * @param gp Sharded Gromer reference.
+ */
+void gs_destroy( gs_p gp );
+
+
+
+/* ------------------------------------------------------------
+ * Shard operations:
+ */
+
+
+/**
+ * Push item to shard.
+ *
+ * @param gs   Sharded Gromer.
+ * @param idx  Shard index.
+ * @param item Item to push.
+ */
+void gs_push( gs_t gs, gr_size_t idx, gr_d item );
+
+
+/**
+ * Pop item from shard.
+ *
+ * @param gs  Sharded Gromer.
+ * @param idx Shard index.
+ *
+ * @return Popped item (or NULL).
+ */
+gr_d gs_pop( gs_t gs, gr_size_t idx );
+
+
+/**
+ * Return shard Gromer.
+ *
+ * Gromer is owned by Sharded Gromer. Storage is external (cache line
+ * aligned), hence it is not shared by copy-on-write.
+ *
+ * @param gs  Sharded Gromer.
+ * @param idx Shard index.
+ *
+ * @return Shard Gromer.
+ */
+gr_t gs_shard( gs_t gs, gr_size_t idx );
+
+
+
+/* ------------------------------------------------------------
+ * Collection operations:
+ */
+
+
+/**
+ * Return shard count.
+ *
+ * @param gs Sharded Gromer.
+ *
+ * @return Shard count.
+ */
+gr_size_t gs_count( gs_t gs );
+
+
+/**
+ * Return total usage count of all shards.
+ *
+ * @param gs Sharded Gromer.
+ *
+ * @return Usage count.
+ */
+gr_size_t gs_used( gs_t gs );
+
+
+/**
+ * Merge shards to new Gromer.
+ *
+ * Shards are concatenated in index order, and the result is
+ * reserved to total size up front. Shards are not changed.
+ *
+ * @param gs Sharded Gromer.
+ *
+ * @return Merged Gromer.
+ */
+gr_t gs_merge( gs_t gs );
+
+
+/**
+ * Drain shards to end of Gromer.
+ *
+ * Shards are concatenated in index order and reset. Gromer is resized
+ * (once) if needed, and created if "*gp" is NULL.
+ *
+ * @param gs Sharded Gromer.
+ * @param gp Gromer reference.
+ *
+ * @return Count of drained items.
+ */
+gr_size_t gs_drain( gs_t gs, gr_p gp );
+
+
+#endif
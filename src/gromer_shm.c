@@ -0,0 +1,344 @@
+/**
+ * @file   gromer_shm.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Mon Oct 19 09:14:27 2026
+ *
+ * @brief  Shared memory Gromer - Gromer shared by local processes.
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "gromer_shm.h"
+
+
+/** @cond gromer_none */
+/** Segment magic ("GRSHM001"). */
+#define gr_shm_magic 0x3130304d48535247ULL
+/** Attach wait rounds (1 ms each). */
+#define gr_shm_wait_rounds 1000
+/** Round up to cache line. */
+#define gr_shm_line( bytes ) ( ( ( bytes ) + GR_CACHE_LINE - 1 ) & ~( (gr_size_t)GR_CACHE_LINE - 1 ) )
+/** @endcond gromer_none */
+
+
+/**
+ * Segment header.
+ *
+ * Header is followed by the Gromer and the arena, both at cache line
+ * boundary. Offsets are relative to segment start.
+ */
+struct gr_shm_s
+{
+    uint64_t        magic; /**< Segment magic (set when initialized). */
+    gr_size_t       bytes; /**< Segment size. */
+    gr_size_t       items; /**< Gromer offset. */
+    gr_size_t       arena; /**< Arena offset. */
+    gr_size_t       limit; /**< Arena size. */
+    gr_size_t       next;  /**< Next free arena offset. */
+    pthread_mutex_t lock;  /**< Process shared robust lock. */
+};
+
+
+static gr_shm_t gr_shm_create( int fd, gr_size_t size, gr_size_t arena );
+static gr_shm_t gr_shm_attach( int fd );
+static void gr_shm_pause( void );
+
+
+
+/* ------------------------------------------------------------
+ * Open and close:
+ */
+
+
+gr_shm_t gr_shm_open( const char* name, gr_size_t size, gr_size_t arena )
+{
+    gr_shm_t shm;
+    int      fd;
+
+    fd = shm_open( name, O_RDWR | O_CREAT | O_EXCL, 0600 );
+    if ( fd >= 0 ) {
+        shm = gr_shm_create( fd, size, arena );
+        if ( shm == NULL )
+            shm_unlink( name ); // GCOV_EXCL_LINE
+    } else if ( errno == EEXIST ) {
+        fd = shm_open( name, O_RDWR, 0 );
+        if ( fd < 0 )
+            return NULL; // GCOV_EXCL_LINE
+        shm = gr_shm_attach( fd );
+    } else {
+        return NULL;
+    }
+
+    /* Mapping remains after close. */
+    close( fd );
+
+    return shm;
+}
+
+
+void gr_shm_close( gr_shm_p sp )
+{
+    if ( *sp == NULL )
+        return;
+
+    munmap( *sp, ( *sp )->bytes );
+    *sp = NULL;
+}
+
+
+int gr_shm_unlink( const char* name )
+{
+    return shm_unlink( name );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Items:
+ */
+
+
+int gr_shm_push( gr_shm_t shm, gr_d item )
+{
+    gr_t gr = gr_shm_gromer( shm );
+    int  ret = -1;
+
+    gr_shm_lock( shm );
+    if ( gr_used( gr ) < gr_size( gr ) ) {
+        gr_push( &gr, item );
+        ret = 0;
+    }
+    gr_shm_unlock( shm );
+
+    return ret;
+}
+
+
+gr_d gr_shm_pop( gr_shm_t shm )
+{
+    gr_t gr = gr_shm_gromer( shm );
+    gr_d ret;
+
+    gr_shm_lock( shm );
+    ret = gr_pop( &gr );
+    gr_shm_unlock( shm );
+
+    return ret;
+}
+
+
+gr_size_t gr_shm_pop_into( gr_shm_t shm, gr_p dst, gr_size_t count )
+{
+    gr_t      gr = gr_shm_gromer( shm );
+    gr_size_t ret;
+
+    gr_shm_lock( shm );
+    ret = gr_pop_into( &gr, dst, count );
+    gr_shm_unlock( shm );
+
+    return ret;
+}
+
+
+gr_size_t gr_shm_used( gr_shm_t shm )
+{
+    gr_size_t ret;
+
+    gr_shm_lock( shm );
+    ret = gr_used( gr_shm_gromer( shm ) );
+    gr_shm_unlock( shm );
+
+    return ret;
+}
+
+
+gr_size_t gr_shm_size( gr_shm_t shm )
+{
+    return gr_size( gr_shm_gromer( shm ) );
+}
+
+
+void gr_shm_lock( gr_shm_t shm )
+{
+    int ret;
+
+    ret = pthread_mutex_lock( &shm->lock );
+
+    /* Owner died while holding the lock. Items are updated before
+     * usage, hence the Gromer is consistent. */
+    if ( ret == EOWNERDEAD )
+        ret = pthread_mutex_consistent( &shm->lock );
+
+    gr_assert( ret == 0 );
+    (void)ret;
+}
+
+
+void gr_shm_unlock( gr_shm_t shm )
+{
+    pthread_mutex_unlock( &shm->lock );
+}
+
+
+gr_t gr_shm_gromer( gr_shm_t shm )
+{
+    return (gr_t)( (uint8_t*)shm + shm->items );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Arena:
+ */
+
+
+gr_size_t gr_shm_alloc( gr_shm_t shm, gr_size_t bytes )
+{
+    gr_size_t off;
+
+    bytes = ( bytes + sizeof( gr_d ) - 1 ) & ~( sizeof( gr_d ) - 1 );
+
+    off = __atomic_load_n( &shm->next, __ATOMIC_RELAXED );
+    do {
+        if ( off + bytes > shm->limit )
+            return 0;
+    } while ( !__atomic_compare_exchange_n(
+        &shm->next, &off, off + bytes, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) );
+
+    return off;
+}
+
+
+gr_d gr_shm_ptr( gr_shm_t shm, gr_size_t off )
+{
+    return (uint8_t*)shm + shm->arena + off;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Size, map and initialize new segment.
+ *
+ * Magic is set last, since attaching processes wait for it.
+ *
+ * @param fd    Segment descriptor.
+ * @param size  Size (in items).
+ * @param arena Arena size (in bytes).
+ *
+ * @return Shared memory Gromer (or NULL on failure).
+ */
+static gr_shm_t gr_shm_create( int fd, gr_size_t size, gr_size_t arena )
+{
+    gr_shm_t            shm;
+    pthread_mutexattr_t attr;
+    gr_size_t           page = sysconf( _SC_PAGESIZE );
+    gr_size_t           items;
+    gr_size_t           base;
+    gr_size_t           bytes;
+
+    if ( size < GR_MIN_SIZE )
+        size = GR_MIN_SIZE;
+    size = ( size + 1 ) & ~1ULL;
+
+    /* First unit is reserved, hence offsets are non-zero. */
+    arena = ( arena + sizeof( gr_d ) - 1 ) & ~( sizeof( gr_d ) - 1 );
+    arena += sizeof( gr_d );
+
+    items = gr_shm_line( sizeof( gr_shm_s ) );
+    base = items + gr_shm_line( gr_struct_size( size ) );
+    bytes = ( ( base + arena + page - 1 ) / page ) * page;
+
+    if ( ftruncate( fd, bytes ) != 0 )
+        return NULL; // GCOV_EXCL_LINE
+
+    shm = (gr_shm_t)mmap( NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( shm == MAP_FAILED )
+        return NULL; // GCOV_EXCL_LINE
+
+    shm->bytes = bytes;
+    shm->items = items;
+    shm->arena = base;
+    shm->limit = bytes - base;
+    shm->next = sizeof( gr_d );
+
+    pthread_mutexattr_init( &attr );
+    pthread_mutexattr_setpshared( &attr, PTHREAD_PROCESS_SHARED );
+    pthread_mutexattr_setrobust( &attr, PTHREAD_MUTEX_ROBUST );
+    pthread_mutex_init( &shm->lock, &attr );
+    pthread_mutexattr_destroy( &attr );
+
+    gr_use( (uint8_t*)shm + items, gr_struct_size( size ) );
+
+    __atomic_store_n( &shm->magic, gr_shm_magic, __ATOMIC_RELEASE );
+
+    return shm;
+}
+
+
+/**
+ * Map existing segment.
+ *
+ * Wait (for a while) until the creator has sized and initialized the
+ * segment.
+ *
+ * @param fd Segment descriptor.
+ *
+ * @return Shared memory Gromer (or NULL on failure).
+ */
+static gr_shm_t gr_shm_attach( int fd )
+{
+    gr_shm_t    shm;
+    struct stat st;
+    int         round;
+
+    for ( round = 0; round < gr_shm_wait_rounds; round++ ) {
+        if ( fstat( fd, &st ) != 0 )
+            return NULL; // GCOV_EXCL_LINE
+        if ( (gr_size_t)st.st_size >= sizeof( gr_shm_s ) )
+            break;
+        gr_shm_pause(); // GCOV_EXCL_LINE
+    }
+    if ( round == gr_shm_wait_rounds )
+        return NULL; // GCOV_EXCL_LINE
+
+    shm = (gr_shm_t)mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( shm == MAP_FAILED )
+        return NULL; // GCOV_EXCL_LINE
+
+    for ( round = 0; round < gr_shm_wait_rounds; round++ ) {
+        if ( __atomic_load_n( &shm->magic, __ATOMIC_ACQUIRE ) == gr_shm_magic )
+            break;
+        gr_shm_pause(); // GCOV_EXCL_LINE
+    }
+    if ( round == gr_shm_wait_rounds || shm->bytes != (gr_size_t)st.st_size ) {
+        munmap( shm, st.st_size );
+        return NULL;
+    }
+
+    return shm;
+}
+
+
+/**
+ * Pause for attach wait round.
+ */
+static void gr_shm_pause( void )
+{
+    struct timespec ts = { 0, 1000000 };
+
+    nanosleep( &ts, NULL );
+}
@@ -0,0 +1,206 @@
+#ifndef GROMER_SHM_H
+#define GROMER_SHM_H
+
+/**
+ * @file   gromer_shm.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Mon Oct 19 09:14:27 2026
+ *
+ * @brief  Shared memory Gromer - Gromer shared by local processes.
+ *
+ * Shared memory Gromer lives in a POSIX shared memory segment
+ * (shm_open() and mmap()), which is opened by name in each
+ * process. Segment contains a Gromer of fixed size and a byte arena.
+ *
+ * Items are typically arena offsets (see gr_shm_alloc()), since
+ * segment is mapped to different address in each process. Arena
+ * offsets are never 0, hence NULL item means "no item".
+ *
+ * Push and pop are protected by a process shared robust mutex. If a
+ * process dies while holding the lock, the next locker recovers
+ * it. Arena allocation is lock free (atomic).
+ *
+ *     shm = gr_shm_open( "/ingest", 4096, 1 << 20 );
+ *     off = gr_shm_alloc( shm, len );
+ *     memcpy( gr_shm_ptr( shm, off ), data, len );
+ *     gr_shm_push( shm, (gr_d)off );
+ *     ...
+ *     gr_shm_close( &shm );
+ *
+ */
+
+#include "gromer.h"
+
+
+/** Shared memory Gromer segment header (opaque). */
+typedef struct gr_shm_s gr_shm_s;
+typedef gr_shm_s*       gr_shm_t; /**< Shared memory Gromer. */
+typedef gr_shm_t*       gr_shm_p; /**< Shared memory Gromer reference. */
+
+
+
+/* ------------------------------------------------------------
+ * Open and close:
+ */
+
+
+/**
+ * Open (or create) Shared memory Gromer.
+ *
+ * Missing segment is created with "size" items and "arena" bytes of
+ * arena. Existing segment is attached as is, i.e. "size" and "arena"
+ * are ignored.
+ *
+ * @param name  Segment name (e.g. "/name").
+ * @param size  Size (in items) for new segment.
+ * @param arena Arena size (in bytes) for new segment.
+ *
+ * @return Shared memory Gromer (or NULL on failure).
+ */
+gr_shm_t gr_shm_open( const char* name, gr_size_t size, gr_size_t arena );
+
+
+/**
+ * Close (unmap) Shared memory Gromer.
+ *
+ * Segment and items remain until gr_shm_unlink().
+ *
+ * @param sp Shared memory Gromer reference.
+ */
+void gr_shm_close( gr_shm_p sp );
+
+
+/**
+ * Remove segment name.
+ *
+ * Segment is released when all processes have closed it.
+ *
+ * @param name Segment name.
+ *
+ * @return 0 on success.
+ */
+int gr_shm_unlink( const char* name );
+
+
+
+/* ------------------------------------------------------------
+ * Items:
+ */
+
+
+/**
+ * Push item to end of container.
+ *
+ * @param shm  Shared memory Gromer.
+ * @param item Item to push.
+ *
+ * @return 0 on success (-1 if full).
+ */
+int gr_shm_push( gr_shm_t shm, gr_d item );
+
+
+/**
+ * Pop item from end of container.
+ *
+ * @param shm Shared memory Gromer.
+ *
+ * @return Popped item (or NULL).
+ */
+gr_d gr_shm_pop( gr_shm_t shm );
+
+
+/**
+ * Pop up to "count" items into (process local) Gromer.
+ *
+ * Items are appended to "dst" in the same order as in the
+ * container, and they are removed with one lock round.
+ *
+ * @param shm   Shared memory Gromer.
+ * @param dst   Destination Gromer reference.
+ * @param count Maximum number of items.
+ *
+ * @return Number of items popped.
+ */
+gr_size_t gr_shm_pop_into( gr_shm_t shm, gr_p dst, gr_size_t count );
+
+
+/**
+ * Return usage count.
+ *
+ * @param shm Shared memory Gromer.
+ *
+ * @return Usage count.
+ */
+gr_size_t gr_shm_used( gr_shm_t shm );
+
+
+/**
+ * Return size (capacity).
+ *
+ * @param shm Shared memory Gromer.
+ *
+ * @return Size.
+ */
+gr_size_t gr_shm_size( gr_shm_t shm );
+
+
+/**
+ * Lock Shared memory Gromer.
+ *
+ * @param shm Shared memory Gromer.
+ */
+void gr_shm_lock( gr_shm_t shm );
+
+
+/**
+ * Unlock Shared memory Gromer.
+ *
+ * @param shm Shared memory Gromer.
+ */
+void gr_shm_unlock( gr_shm_t shm );
+
+
+/**
+ * Return Gromer of Shared memory Gromer.
+ *
+ * Gromer is valid in the calling process only, and it must be
+ * accessed under lock. Gromer is local and it can't be resized.
+ *
+ * @param shm Shared memory Gromer.
+ *
+ * @return Gromer.
+ */
+gr_t gr_shm_gromer( gr_shm_t shm );
+
+
+
+/* ------------------------------------------------------------
+ * Arena:
+ */
+
+
+/**
+ * Allocate bytes from arena and return offset.
+ *
+ * Allocation is rounded up to Gromer unit (8 bytes).
+ *
+ * @param shm   Shared memory Gromer.
+ * @param bytes Allocation size.
+ *
+ * @return Allocation offset (or 0 if arena is exhausted).
+ */
+gr_size_t gr_shm_alloc( gr_shm_t shm, gr_size_t bytes );
+
+
+/**
+ * Return pointer for arena offset.
+ *
+ * @param shm Shared memory Gromer.
+ * @param off Allocation offset.
+ *
+ * @return Pointer (in calling process).
+ */
+gr_d gr_shm_ptr( gr_shm_t shm, gr_size_t off );
+
+
+#endif
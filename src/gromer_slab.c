@@ -0,0 +1,228 @@
+/**
+ * @file   gromer_slab.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 22:18:40 2026
+ *
+ * @brief  Slab pool - fixed size objects from page Gromers.
+ *
+ */
+
+#include "gromer_slab.h"
+
+
+static gr_d ga_carve( ga_t ga );
+
+
+
+/* ------------------------------------------------------------
+ * Pool:
+ */
+
+
+ga_t ga_new( gr_size_t size )
+{
+    ga_t      ga;
+    gr_size_t page = gr_alloc_pages( 0, NULL );
+    gr_size_t min;
+
+    gr_assert( size > 0 );
+
+    ga = (ga_t)gr_malloc( sizeof( ga_s ) );
+    ga->obj = ( size + sizeof( gr_d ) - 1 ) & ~( sizeof( gr_d ) - 1 );
+
+    /* Block holds at least one object. */
+    min = ( ga->obj + sizeof( gr_s ) + page - 1 ) / page;
+    ga->pages = min > GA_BLOCK_PAGES ? min : GA_BLOCK_PAGES;
+
+    ga->block = gr_new();
+    ga->cur = 0;
+    ga->free = gr_new();
+    ga->live = 0;
+    pthread_mutex_init( &ga->lock, NULL );
+
+    return ga;
+}
+
+
+void ga_destroy( ga_p gp )
+{
+    gr_t block;
+
+    if ( *gp == NULL )
+        return;
+
+    gr_each( ( *gp )->block, block, gr_t )
+    {
+        gr_destroy( &block );
+    }
+    gr_destroy( &( *gp )->block );
+    gr_destroy( &( *gp )->free );
+    pthread_mutex_destroy( &( *gp )->lock );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+gr_d ga_get( ga_t ga )
+{
+    gr_d obj;
+
+    pthread_mutex_lock( &ga->lock );
+    obj = gr_pop( &ga->free );
+    if ( obj == NULL )
+        obj = ga_carve( ga );
+    ga->live++;
+    pthread_mutex_unlock( &ga->lock );
+
+    return obj;
+}
+
+
+void ga_put( ga_t ga, gr_d obj )
+{
+    pthread_mutex_lock( &ga->lock );
+    gr_push( &ga->free, obj );
+    ga->live--;
+    pthread_mutex_unlock( &ga->lock );
+}
+
+
+void ga_reset( ga_t ga )
+{
+    gr_t block;
+
+    pthread_mutex_lock( &ga->lock );
+    gr_each( ga->block, block, gr_t )
+    {
+        gr_reset( &block );
+    }
+    ga->cur = 0;
+    gr_reset( &ga->free );
+    ga->live = 0;
+    pthread_mutex_unlock( &ga->lock );
+}
+
+
+gr_size_t ga_size( ga_t ga )
+{
+    return ga->obj;
+}
+
+
+gr_size_t ga_live( ga_t ga )
+{
+    return ga->live;
+}
+
+
+gr_size_t ga_blocks( ga_t ga )
+{
+    return gr_used( ga->block );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Cache:
+ */
+
+
+ga_cache_t ga_cache_new( ga_t ga )
+{
+    ga_cache_t cache;
+
+    cache = (ga_cache_t)gr_malloc( sizeof( ga_cache_s ) );
+    cache->ga = ga;
+    cache->free = gr_new_sized( 2 * GA_CACHE_BATCH );
+
+    return cache;
+}
+
+
+void ga_cache_destroy( ga_cache_p cp )
+{
+    if ( *cp == NULL )
+        return;
+
+    ga_cache_clear( *cp );
+    gr_destroy( &( *cp )->free );
+    gr_free( *cp );
+    *cp = NULL;
+}
+
+
+gr_d ga_cache_get( ga_cache_t cache )
+{
+    ga_t ga = cache->ga;
+
+    if ( gr_used( cache->free ) == 0 ) {
+
+        /* Refill batch, free objects first. */
+        pthread_mutex_lock( &ga->lock );
+        gr_pop_into( &ga->free, &cache->free, GA_CACHE_BATCH );
+        while ( gr_used( cache->free ) < GA_CACHE_BATCH )
+            gr_push( &cache->free, ga_carve( ga ) );
+        ga->live += GA_CACHE_BATCH;
+        pthread_mutex_unlock( &ga->lock );
+    }
+
+    return gr_pop( &cache->free );
+}
+
+
+void ga_cache_put( ga_cache_t cache, gr_d obj )
+{
+    ga_t ga = cache->ga;
+
+    if ( gr_used( cache->free ) >= 2 * GA_CACHE_BATCH ) {
+
+        /* Return batch. */
+        pthread_mutex_lock( &ga->lock );
+        gr_pop_into( &cache->free, &ga->free, GA_CACHE_BATCH );
+        ga->live -= GA_CACHE_BATCH;
+        pthread_mutex_unlock( &ga->lock );
+    }
+
+    gr_push( &cache->free, obj );
+}
+
+
+void ga_cache_clear( ga_cache_t cache )
+{
+    ga_t      ga = cache->ga;
+    gr_size_t cnt = gr_used( cache->free );
+
+    pthread_mutex_lock( &ga->lock );
+    gr_pop_into( &cache->free, &ga->free, cnt );
+    ga->live -= cnt;
+    pthread_mutex_unlock( &ga->lock );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Carve new object from blocks (pool is locked).
+ *
+ * @param ga Slab pool.
+ *
+ * @return Object.
+ */
+static gr_d ga_carve( ga_t ga )
+{
+    gr_d obj;
+
+    for ( ; ga->cur < gr_used( ga->block ); ga->cur++ ) {
+        obj = gr_alloc( (gr_p)gr_nth_ref( ga->block, ga->cur ), ga->obj );
+        if ( obj )
+            return obj;
+    }
+
+    gr_push( &ga->block, gr_new_page( ga->pages ) );
+
+    return gr_alloc( (gr_p)gr_nth_ref( ga->block, -1 ), ga->obj );
+}
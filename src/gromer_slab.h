@@ -0,0 +1,212 @@
+#ifndef GROMER_SLAB_H
+#define GROMER_SLAB_H
+
+/**
+ * @file   gromer_slab.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 22:18:40 2026
+ *
+ * @brief  Slab pool - fixed size objects from page Gromers.
+ *
+ * Objects (slots) are carved from page Gromers (blocks) with
+ * gr_alloc(). Released objects are kept in a free list Gromer, and
+ * they are reused (LIFO) before new slots are carved. Hence object
+ * churn is a pointer pop and push. ga_reset() releases all objects at
+ * once, and keeps the blocks for reuse.
+ *
+ * Pool is thread safe (locked). Per-thread caches (ga_cache_t) take
+ * and return objects in batches of GA_CACHE_BATCH, and hence most
+ * cache operations are lock free.
+ *
+ */
+
+#include <pthread.h>
+
+#include "gromer.h"
+
+
+#ifndef GA_BLOCK_PAGES
+/** Default block size in pages. */
+#define GA_BLOCK_PAGES 16
+#endif
+
+#ifndef GA_CACHE_BATCH
+/** Transfer batch size between cache and pool. */
+#define GA_CACHE_BATCH 32
+#endif
+
+
+/**
+ * Slab pool struct.
+ */
+struct ga_struct_s
+{
+    gr_size_t       obj;   /**< Object (slot) size in bytes. */
+    gr_size_t       pages; /**< Block size in pages. */
+    gr_t            block; /**< Blocks (page Gromers). */
+    gr_size_t       cur;   /**< Block index for carving. */
+    gr_t            free;  /**< Released objects. */
+    gr_size_t       live;  /**< Objects in use (including caches). */
+    pthread_mutex_t lock;  /**< Pool lock. */
+};
+typedef struct ga_struct_s ga_s; /**< Slab pool struct. */
+typedef ga_s*              ga_t; /**< Slab pool. */
+typedef ga_t*              ga_p; /**< Slab pool reference. */
+
+
+/**
+ * Slab pool cache struct.
+ */
+struct ga_cache_struct_s
+{
+    ga_t ga;   /**< Pool. */
+    gr_t free; /**< Cached objects. */
+};
+typedef struct ga_cache_struct_s ga_cache_s; /**< Slab pool cache struct. */
+typedef ga_cache_s*              ga_cache_t; /**< Slab pool cache. */
+typedef ga_cache_t*              ga_cache_p; /**< Slab pool cache reference. */
+
+
+
+/* ------------------------------------------------------------
+ * Pool:
+ */
+
+
+/**
+ * Create slab pool.
+ *
+ * Object size is rounded up to Gromer unit (8 bytes).
+ *
+ * @param size Object size in bytes.
+ *
+ * @return Slab pool.
+ */
+ga_t ga_new( gr_size_t size );
+
+
+/**
+ * Destroy slab pool, including all objects.
+ *
+ * @param gp Slab pool reference.
+ */
+void ga_destroy( ga_p gp );
+
+
+/**
+ * Get object.
+ *
+ * Object content is undefined (unlike with malloc() and calloc(),
+ * released objects are not cleared).
+ *
+ * @param ga Slab pool.
+ *
+ * @return Object.
+ */
+gr_d ga_get( ga_t ga );
+
+
+/**
+ * Put (release) object.
+ *
+ * @param ga  Slab pool.
+ * @param obj Object.
+ */
+void ga_put( ga_t ga, gr_d obj );
+
+
+/**
+ * Release all objects.
+ *
+ * Blocks are kept for reuse. Caches must be empty (see
+ * ga_cache_clear()).
+ *
+ * @param ga Slab pool.
+ */
+void ga_reset( ga_t ga );
+
+
+/**
+ * Return object size.
+ *
+ * @param ga Slab pool.
+ *
+ * @return Object size in bytes.
+ */
+gr_size_t ga_size( ga_t ga );
+
+
+/**
+ * Return count of objects in use.
+ *
+ * @param ga Slab pool.
+ *
+ * @return Object count.
+ */
+gr_size_t ga_live( ga_t ga );
+
+
+/**
+ * Return block count.
+ *
+ * @param ga Slab pool.
+ *
+ * @return Block count.
+ */
+gr_size_t ga_blocks( ga_t ga );
+
+
+
+/* ------------------------------------------------------------
+ * Cache:
+ */
+
+
+/**
+ * Create cache for pool.
+ *
+ * Cache is used by one thread at a time.
+ *
+ * @param ga Slab pool.
+ *
+ * @return Cache.
+ */
+ga_cache_t ga_cache_new( ga_t ga );
+
+
+/**
+ * Destroy cache, cached objects are returned to pool.
+ *
+ * @param cp Cache reference.
+ */
+void ga_cache_destroy( ga_cache_p cp );
+
+
+/**
+ * Get object from cache.
+ *
+ * @param cache Cache.
+ *
+ * @return Object.
+ */
+gr_d ga_cache_get( ga_cache_t cache );
+
+
+/**
+ * Put (release) object to cache.
+ *
+ * @param cache Cache.
+ * @param obj   Object.
+ */
+void ga_cache_put( ga_cache_t cache, gr_d obj );
+
+
+/**
+ * Return cached objects to pool.
+ *
+ * @param cache Cache.
+ */
+void ga_cache_clear( ga_cache_t cache );
+
+
+#endif
@@ -0,0 +1,322 @@
+/**
+ * @file   gromer_tomb.c
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 11:03:27 2026
+ *
+ * @brief  Tombstone Gromer - Gromer with lazy deletion.
+ *
+ */
+
+#include <string.h>
+
+#include "gromer_tomb.h"
+
+
+/** @cond gromer_none */
+#define gr_true  1
+#define gr_false 0
+
+#define gt_word( idx )       ( ( idx ) >> 6 )
+#define gt_bit( idx )        ( 1ULL << ( ( idx ) & 0x3F ) )
+#define gt_words_for( cnt ) ( ( ( cnt ) + 63 ) >> 6 )
+/** @endcond gromer_none */
+
+
+static uint64_t gt_live_mask( gt_t gt, gr_size_t word );
+static void gt_clear_bit( gt_t gt, gr_size_t idx );
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+gt_t gt_new( void )
+{
+    return gt_new_sized( GR_DEFAULT_SIZE );
+}
+
+
+gt_t gt_new_sized( gr_size_t size )
+{
+    gt_t gt;
+
+    gt = (gt_t)gr_malloc( sizeof( gt_s ) );
+    gt->gr = gr_new_sized( size );
+    gt->limit = GT_DEFAULT_LIMIT;
+
+    return gt;
+}
+
+
+void gt_destroy( gt_p gp )
+{
+    if ( *gp == NULL )
+        return;
+
+    gr_destroy( &( *gp )->gr );
+    gr_free( ( *gp )->bits );
+    gr_free( *gp );
+    *gp = NULL;
+}
+
+
+void gt_set_limit( gt_t gt, gr_size_t limit )
+{
+    gt->limit = limit;
+}
+
+
+void gt_push( gt_t gt, gr_d item )
+{
+    gr_push( &gt->gr, item );
+}
+
+
+gr_d gt_pop( gt_t gt )
+{
+    /* Trim dead tail. */
+    while ( gr_used( gt->gr ) > 0 && gt_is_dead( gt, gr_used( gt->gr ) - 1 ) ) {
+        gt_clear_bit( gt, gr_used( gt->gr ) - 1 );
+        gt->dead--;
+        gr_pop( &gt->gr );
+    }
+
+    return gr_pop( &gt->gr );
+}
+
+
+gr_d gt_delete_at( gt_t gt, gr_size_t idx )
+{
+    gr_d ret;
+
+    gr_assert( idx < gr_used( gt->gr ) );
+
+    if ( gt_is_dead( gt, idx ) )
+        return NULL;
+
+    ret = gt->gr->data[ idx ];
+
+    if ( idx == gr_used( gt->gr ) - 1 ) {
+        /* Last item is removed directly. */
+        gr_pop( &gt->gr );
+        return ret;
+    }
+
+    if ( gt_word( idx ) >= gt->words ) {
+        gr_size_t words = gt_words_for( gr_size( gt->gr ) );
+        gt->bits = (uint64_t*)gr_realloc( gt->bits, words * sizeof( uint64_t ) );
+        memset( &gt->bits[ gt->words ], 0, ( words - gt->words ) * sizeof( uint64_t ) );
+        gt->words = words;
+    }
+
+    gt->bits[ gt_word( idx ) ] |= gt_bit( idx );
+    gt->dead++;
+
+    if ( gt->limit > 0 && gt->dead * 100 >= gr_used( gt->gr ) * gt->limit )
+        gt_compact( gt );
+
+    return ret;
+}
+
+
+void gt_compact( gt_t gt )
+{
+    gr_size_t used = gr_used( gt->gr );
+    gr_d*     data = gt->gr->data;
+    gr_size_t wr;
+    gr_size_t rd;
+
+    if ( gt->dead == 0 )
+        return;
+
+    /* Skip live prefix. */
+    wr = 0;
+    while ( wr < used && !gt_is_dead( gt, wr ) )
+        wr++;
+
+    for ( rd = gt_next( gt, wr ); rd < used; rd = gt_next( gt, rd + 1 ) )
+        data[ wr++ ] = data[ rd ];
+
+    gr_drop( &gt->gr, used - wr );
+    memset( gt->bits, 0, gt->words * sizeof( uint64_t ) );
+    gt->dead = 0;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+gr_size_t gt_used( gt_t gt )
+{
+    return gr_used( gt->gr ) - gt->dead;
+}
+
+
+gr_size_t gt_dead( gt_t gt )
+{
+    return gt->dead;
+}
+
+
+int gt_is_dead( gt_t gt, gr_size_t idx )
+{
+    if ( gt_word( idx ) >= gt->words )
+        return gr_false;
+
+    return ( gt->bits[ gt_word( idx ) ] & gt_bit( idx ) ) != 0;
+}
+
+
+gr_size_t gt_next( gt_t gt, gr_size_t idx )
+{
+    gr_size_t used = gr_used( gt->gr );
+    gr_size_t word;
+    uint64_t  live;
+
+    if ( gt->dead == 0 || idx >= used )
+        return idx;
+
+    word = gt_word( idx );
+    live = gt_live_mask( gt, word ) & ~( gt_bit( idx ) - 1 );
+
+    for ( ;; ) {
+        if ( live )
+            return ( word << 6 ) + __builtin_ctzll( live );
+        word++;
+        if ( ( word << 6 ) >= used )
+            return used;
+        live = gt_live_mask( gt, word );
+    }
+}
+
+
+gr_pos_t gt_live_pos( gt_t gt, gr_size_t idx )
+{
+    gr_size_t dead = 0;
+
+    if ( idx >= gr_used( gt->gr ) || gt_is_dead( gt, idx ) )
+        return GR_NOT_INDEX;
+
+    for ( gr_size_t w = 0; w < gt_word( idx ) && w < gt->words; w++ )
+        dead += __builtin_popcountll( gt->bits[ w ] );
+
+    if ( gt_word( idx ) < gt->words )
+        dead += __builtin_popcountll( gt->bits[ gt_word( idx ) ] & ( gt_bit( idx ) - 1 ) );
+
+    return idx - dead;
+}
+
+
+gr_d gt_nth( gt_t gt, gr_pos_t pos )
+{
+    gr_size_t live = gt_used( gt );
+    gr_size_t rem;
+
+    if ( live == 0 )
+        return NULL;
+
+    if ( pos < 0 )
+        pos += live;
+
+    if ( pos < 0 || (gr_size_t)pos >= live ) {
+        gr_assert( 0 ); // GCOV_EXCL_LINE
+        return NULL;    // GCOV_EXCL_LINE
+    }
+
+    if ( gt->dead == 0 )
+        return gt->gr->data[ pos ];
+
+    rem = pos;
+    for ( gr_size_t w = 0;; w++ ) {
+        uint64_t  mask = gt_live_mask( gt, w );
+        gr_size_t cnt = __builtin_popcountll( mask );
+        if ( rem < cnt ) {
+            while ( rem-- > 0 )
+                mask &= mask - 1;
+            return gt->gr->data[ ( w << 6 ) + __builtin_ctzll( mask ) ];
+        }
+        rem -= cnt;
+    }
+}
+
+
+gr_pos_t gt_find( gt_t gt, gr_d item )
+{
+    gr_d cur;
+
+    for ( gr_size_t i = gt_next( gt, 0 ); i < gr_used( gt->gr ); i = gt_next( gt, i + 1 ) ) {
+        cur = gt->gr->data[ i ];
+        if ( cur == item )
+            return i;
+    }
+
+    return GR_NOT_INDEX;
+}
+
+
+gr_pos_t gt_find_with( gt_t gt, gr_compare_fn_p compare, gr_d ref )
+{
+    for ( gr_size_t i = gt_next( gt, 0 ); i < gr_used( gt->gr ); i = gt_next( gt, i + 1 ) ) {
+        if ( compare( gt->gr->data[ i ], ref ) )
+            return i;
+    }
+
+    return GR_NOT_INDEX;
+}
+
+
+gr_t gt_gromer( gt_t gt )
+{
+    gt_compact( gt );
+    return gt->gr;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Internal support:
+ */
+
+
+/**
+ * Return mask of live items in bitmap word.
+ *
+ * Items beyond usage are not live.
+ *
+ * @param gt   Tombstone Gromer.
+ * @param word Word index.
+ *
+ * @return Live mask.
+ */
+static uint64_t gt_live_mask( gt_t gt, gr_size_t word )
+{
+    gr_size_t used = gr_used( gt->gr );
+    uint64_t  live;
+
+    if ( word < gt->words )
+        live = ~gt->bits[ word ];
+    else
+        live = ~0ULL;
+
+    if ( ( ( word + 1 ) << 6 ) > used )
+        live &= gt_bit( used ) - 1;
+
+    return live;
+}
+
+
+/**
+ * Clear dead bit of raw index.
+ *
+ * @param gt  Tombstone Gromer.
+ * @param idx Raw index.
+ */
+static void gt_clear_bit( gt_t gt, gr_size_t idx )
+{
+    gt->bits[ gt_word( idx ) ] &= ~gt_bit( idx );
+}
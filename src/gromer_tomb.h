@@ -0,0 +1,242 @@
+#ifndef GROMER_TOMB_H
+#define GROMER_TOMB_H
+
+/**
+ * @file   gromer_tomb.h
+ * @author Tero Isannainen <tero.isannainen@gmail.com>
+ * @date   Sun Oct 18 11:03:27 2026
+ *
+ * @brief  Tombstone Gromer - Gromer with lazy deletion.
+ *
+ * Deleted items are marked dead in a bitmap instead of moving the
+ * tail of the pointer array. Dead items are skipped by iteration,
+ * find, and nth. Storage is compacted in one linear pass, either
+ * explicitly or automatically when the dead fraction exceeds the
+ * limit.
+ *
+ * Positions of gt_delete_at(), gt_find(), and gt_each() are raw slot
+ * indeces (including dead slots). gt_live_pos() converts raw index to
+ * live position, and gt_nth() takes live position.
+ *
+ */
+
+#include "gromer.h"
+
+
+#ifndef GT_DEFAULT_LIMIT
+/** Default dead percentage limit for automatic compaction. */
+#define GT_DEFAULT_LIMIT 25
+#endif
+
+
+/**
+ * Tombstone Gromer struct.
+ */
+struct gt_struct_s
+{
+    gr_t      gr;    /**< Items (including dead). */
+    uint64_t* bits;  /**< Dead bitmap. */
+    gr_size_t words; /**< Bitmap size in words. */
+    gr_size_t dead;  /**< Dead item count. */
+    gr_size_t limit; /**< Dead percentage for compaction (0 for none). */
+};
+typedef struct gt_struct_s gt_s; /**< Tombstone Gromer struct. */
+typedef gt_s*              gt_t; /**< Tombstone Gromer. */
+typedef gt_t*              gt_p; /**< Tombstone Gromer reference. */
+
+
+/** Iterate over live items, "gr_idx" is the raw index. */
+#define gt_each( gt, iter, cast )                                       \
+    for ( gr_size_t gr_idx = gt_next( gt, 0 );                          \
+          ( gr_idx < ( gt )->gr->used ) && ( iter = ( cast )( gt )->gr->data[ gr_idx ] ); \
+          gr_idx = gt_next( gt, gr_idx + 1 ) )
+
+
+
+/* ------------------------------------------------------------
+ * Create and destroy:
+ */
+
+
+/**
+ * Create Tombstone Gromer with default size (GR_DEFAULT_SIZE).
+ *
+ * @return Tombstone Gromer.
+ */
+gt_t gt_new( void );
+
+
+/**
+ * Create Tombstone Gromer with size.
+ *
+ * @param size Initial size.
+ *
+ * @return Tombstone Gromer.
+ */
+gt_t gt_new_sized( gr_size_t size );
+
+
+/**
+ * Destroy Tombstone Gromer.
+ *
+ * @param gp Tombstone Gromer reference.
+ */
+void gt_destroy( gt_p gp );
+
+
+/**
+ * Set dead percentage limit for automatic compaction.
+ *
+ * @param gt    Tombstone Gromer.
+ * @param limit Dead percentage (0 disables automatic compaction).
+ */
+void gt_set_limit( gt_t gt, gr_size_t limit );
+
+
+/**
+ * Push item to end of container.
+ *
+ * @param gt   Tombstone Gromer.
+ * @param item Item to push.
+ */
+void gt_push( gt_t gt, gr_d item );
+
+
+/**
+ * Pop last live item from container.
+ *
+ * @param gt Tombstone Gromer.
+ *
+ * @return Popped item (or NULL).
+ */
+gr_d gt_pop( gt_t gt );
+
+
+/**
+ * Delete item at raw index lazily.
+ *
+ * Item is marked dead. Container is compacted if dead percentage
+ * reaches the limit, which invalidates raw indeces.
+ *
+ * @param gt  Tombstone Gromer.
+ * @param idx Raw index.
+ *
+ * @return Deleted item (or NULL if already dead).
+ */
+gr_d gt_delete_at( gt_t gt, gr_size_t idx );
+
+
+/**
+ * Compact container, i.e. remove dead items.
+ *
+ * @param gt Tombstone Gromer.
+ */
+void gt_compact( gt_t gt );
+
+
+
+/* ------------------------------------------------------------
+ * Queries:
+ */
+
+
+/**
+ * Return live item count.
+ *
+ * @param gt Tombstone Gromer.
+ *
+ * @return Live count.
+ */
+gr_size_t gt_used( gt_t gt );
+
+
+/**
+ * Return dead item count.
+ *
+ * @param gt Tombstone Gromer.
+ *
+ * @return Dead count.
+ */
+gr_size_t gt_dead( gt_t gt );
+
+
+/**
+ * Return dead status of raw index.
+ *
+ * @param gt  Tombstone Gromer.
+ * @param idx Raw index.
+ *
+ * @return 1 if dead, 0 if live.
+ */
+int gt_is_dead( gt_t gt, gr_size_t idx );
+
+
+/**
+ * Return next live raw index.
+ *
+ * @param gt  Tombstone Gromer.
+ * @param idx Raw index to start from.
+ *
+ * @return Live raw index (or raw count if none).
+ */
+gr_size_t gt_next( gt_t gt, gr_size_t idx );
+
+
+/**
+ * Return live position of raw index.
+ *
+ * @param gt  Tombstone Gromer.
+ * @param idx Raw index.
+ *
+ * @return Live position (or GR_NOT_INDEX if dead).
+ */
+gr_pos_t gt_live_pos( gt_t gt, gr_size_t idx );
+
+
+/**
+ * Return nth live item.
+ *
+ * @param gt  Tombstone Gromer.
+ * @param pos Live position (negative from end).
+ *
+ * @return Item (or NULL).
+ */
+gr_d gt_nth( gt_t gt, gr_pos_t pos );
+
+
+/**
+ * Find live item.
+ *
+ * @param gt   Tombstone Gromer.
+ * @param item Item to find.
+ *
+ * @return Raw index (or GR_NOT_INDEX).
+ */
+gr_pos_t gt_find( gt_t gt, gr_d item );
+
+
+/**
+ * Find live item using compare function.
+ *
+ * @param gt      Tombstone Gromer.
+ * @param compare Compare function.
+ * @param ref     Item to find.
+ *
+ * @return Raw index (or GR_NOT_INDEX).
+ */
+gr_pos_t gt_find_with( gt_t gt, gr_compare_fn_p compare, gr_d ref );
+
+
+/**
+ * Return compacted Gromer.
+ *
+ * Gromer is owned by Tombstone Gromer.
+ *
+ * @param gt Tombstone Gromer.
+ *
+ * @return Gromer.
+ */
+gr_t gt_gromer( gt_t gt );
+
+
+#endif
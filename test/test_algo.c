@@ -0,0 +1,80 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_algo.h"
+#include <string.h>
+
+
+GR_DEFINE_ALGOS( num, uintptr_t, a < b )
+GR_DEFINE_ALGOS( str, char*, strcmp( a, b ) < 0 )
+
+
+static int num_is_odd( uintptr_t a, gr_d arg )
+{
+    (void)arg;
+    return a & 1;
+}
+
+
+static int num_is_odd_half( uintptr_t a, gr_d arg )
+{
+    (void)arg;
+    return ( a / 2 ) & 1;
+}
+
+
+void test_algo_num( void )
+{
+    gr_t gr;
+
+    gr = gr_new();
+    for ( uintptr_t i = 0; i < 1000; i++ )
+        gr_push( &gr, (gr_d)( ( i * 7919 ) % 1000 ) );
+
+    TEST_ASSERT_EQUAL( 1, num_find_with( gr, 7919 % 1000 ) );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, num_find_with( gr, 1000 ) );
+
+    num_sort( &gr );
+    for ( uintptr_t i = 0; i < 1000; i++ ) {
+        TEST_ASSERT_EQUAL( i, (uintptr_t)gr_nth( gr, i ) );
+    }
+
+    TEST_ASSERT_EQUAL( 0, num_search( gr, 0 ) );
+    TEST_ASSERT_EQUAL( 517, num_search( gr, 517 ) );
+    TEST_ASSERT_EQUAL( 999, num_search( gr, 999 ) );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, num_search( gr, 1000 ) );
+
+    TEST_ASSERT_EQUAL( 500, num_remove_if( &gr, num_is_odd, NULL ) );
+    TEST_ASSERT_EQUAL( 500, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 998, (uintptr_t)gr_last( gr ) );
+    TEST_ASSERT_EQUAL( 250, num_search( gr, 500 ) );
+
+    /* Snapshot is made private by removal. */
+    gr_t snap = gr_duplicate_cow( gr );
+    TEST_ASSERT_EQUAL( 250, num_remove_if( &snap, num_is_odd_half, NULL ) );
+    TEST_ASSERT_EQUAL( 250, gr_used( snap ) );
+    TEST_ASSERT_EQUAL( 500, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 2, (uintptr_t)gr_nth( gr, 1 ) );
+    gr_destroy( &snap );
+
+    gr_destroy( &gr );
+}
+
+
+void test_algo_str( void )
+{
+    gr_t  gr;
+    char* strs[] = { "ddd", "bbb", "eee", "aaa", "ccc" };
+
+    gr = gr_new();
+    for ( int i = 0; i < 5; i++ )
+        gr_push( &gr, strs[ i ] );
+
+    str_sort( &gr );
+    TEST_ASSERT_EQUAL_STRING( "aaa", gr_first( gr ) );
+    TEST_ASSERT_EQUAL_STRING( "eee", gr_last( gr ) );
+    TEST_ASSERT_EQUAL( 2, str_search( gr, "ccc" ) );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, str_search( gr, "abc" ) );
+    TEST_ASSERT_EQUAL( 3, str_find_with( gr, "ddd" ) );
+
+    gr_destroy( &gr );
+}
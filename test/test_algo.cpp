@@ -0,0 +1,81 @@
+/*
+ * C++ test for gromer_algo.hpp (not a Ceedling test):
+ *
+ *     shell> gcc -c -Isrc src/gromer.c -o build/gromer.o
+ *     shell> g++ -Wall -Wextra -Werror -Isrc test/test_algo.cpp build/gromer.o -o build/test_algo_cpp
+ *     shell> build/test_algo_cpp
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "gromer.h"
+#include "gromer_algo.hpp"
+
+
+static int failures = 0;
+
+#define CHECK( cond )                                                   \
+    do {                                                                \
+        if ( !( cond ) ) {                                              \
+            std::printf( "%s:%d: FAIL %s\n", __FILE__, __LINE__, #cond ); \
+            failures++;                                                 \
+        }                                                               \
+    } while ( 0 )
+
+
+static void test_algo_num( void )
+{
+    gr_t gr;
+    auto less = []( uintptr_t a, uintptr_t b ) { return a < b; };
+
+    gr = gr_new();
+    for ( uintptr_t i = 0; i < 1000; i++ )
+        gr_push( &gr, (gr_d)( ( i * 7919 ) % 1000 ) );
+
+    CHECK( 1 == gromer::find_with<uintptr_t>( gr, 7919 % 1000, less ) );
+    CHECK( GR_NOT_INDEX == gromer::find_with<uintptr_t>( gr, 1000, less ) );
+
+    gromer::sort<uintptr_t>( &gr, less );
+    for ( uintptr_t i = 0; i < 1000; i++ )
+        CHECK( i == (uintptr_t)gr_nth( gr, i ) );
+
+    CHECK( 517 == gromer::search<uintptr_t>( gr, 517, less ) );
+    CHECK( GR_NOT_INDEX == gromer::search<uintptr_t>( gr, 1000, less ) );
+
+    CHECK( 500 == gromer::remove_if<uintptr_t>( &gr, []( uintptr_t a ) { return a & 1; } ) );
+    CHECK( 500 == gr_used( gr ) );
+    CHECK( 998 == (uintptr_t)gr_last( gr ) );
+
+    gr_destroy( &gr );
+}
+
+
+static void test_algo_str( void )
+{
+    gr_t        gr;
+    const char* words[] = { "pear", "apple", "fig", "kiwi", "banana" };
+    auto        less = []( const char* a, const char* b ) { return std::strcmp( a, b ) < 0; };
+
+    gr = gr_new();
+    for ( const char* w : words )
+        gr_push( &gr, (gr_d)w );
+
+    gromer::sort<const char*>( &gr, less );
+    CHECK( 0 == std::strcmp( "apple", (const char*)gr_first( gr ) ) );
+    CHECK( 0 == std::strcmp( "pear", (const char*)gr_last( gr ) ) );
+    CHECK( 2 == gromer::search<const char*>( gr, "fig", less ) );
+
+    gr_destroy( &gr );
+}
+
+
+int main( void )
+{
+    test_algo_num();
+    test_algo_str();
+
+    std::printf( "%d failures\n", failures );
+
+    return failures != 0;
+}
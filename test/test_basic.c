@@ -1,7 +1,11 @@
 #include "unity.h"
 #include "gromer.h"
 #include <string.h>
+#include <stddef.h>
+#include <signal.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 
 void test_basics( void )
 {
@@ -26,7 +30,7 @@ void test_basics( void )
     TEST_ASSERT_EQUAL( 12, gr_size( gr ) );
     TEST_ASSERT_EQUAL( 1, gr_used( gr ) );
 
-    ret = gr_pop( gr );
+    ret = gr_pop( &gr );
     TEST_ASSERT_EQUAL( text, ret );
     TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
 
@@ -45,7 +49,7 @@ void test_basics( void )
     TEST_ASSERT_EQUAL( 1, gr_is_full( gr ) );
     TEST_ASSERT_EQUAL( 0, gr_is_empty( gr ) );
 
-    gr_reset( gr );
+    gr_reset( &gr );
     TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
     gr_resize( &gr, GR_DEFAULT_SIZE );
     TEST_ASSERT_EQUAL( GR_DEFAULT_SIZE, gr_size( gr ) );
@@ -75,6 +79,228 @@ void test_basics( void )
 }
 
 
+void test_cow( void )
+{
+    gr_t  gr;
+    gr_t  snap;
+    gr_t  snap2;
+    char* str1 = "aaa";
+    char* str2 = "bbb";
+
+    gr = gr_new_sized( 4 );
+    gr_push( &gr, str1 );
+    gr_push( &gr, str2 );
+
+    snap = gr_duplicate_cow( gr );
+    TEST_ASSERT_TRUE( snap == gr );
+    TEST_ASSERT_EQUAL( 1, gr_is_shared( gr ) );
+    TEST_ASSERT_EQUAL( 4, gr_size( gr ) );
+
+    /* Push makes a private copy. */
+    gr_push( &gr, str1 );
+    TEST_ASSERT_TRUE( snap != gr );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( gr ) );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( snap ) );
+    TEST_ASSERT_EQUAL( 3, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 2, gr_used( snap ) );
+    TEST_ASSERT_EQUAL( str2, gr_nth( snap, 1 ) );
+
+    /* Delete makes a private copy. */
+    snap2 = gr_duplicate_cow( gr );
+    gr_delete_at( &gr, 0 );
+    TEST_ASSERT_EQUAL( 2, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 3, gr_used( snap2 ) );
+    TEST_ASSERT_EQUAL( str1, gr_first( snap2 ) );
+    TEST_ASSERT_EQUAL( str2, gr_first( gr ) );
+
+    /* Shared storage is released by the last holder. */
+    gr_destroy( &snap2 );
+    snap2 = gr_duplicate_cow( snap );
+    gr_destroy( &snap );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( snap2 ) );
+    gr_push( &snap2, str1 );
+    TEST_ASSERT_EQUAL( 3, gr_used( snap2 ) );
+
+    gr_destroy( &snap2 );
+    gr_destroy( &gr );
+}
+
+
+static const uintptr_t cow_ref[ 8 ] = { 5, 3, 8, 1, 7, 2, 6, 4 };
+
+
+static int cow_compare( const gr_d a, const gr_d b )
+{
+    return ( (uintptr_t)a > (uintptr_t)b ) - ( (uintptr_t)a < (uintptr_t)b );
+}
+
+
+static int cow_sort_compare( const gr_d a, const gr_d b )
+{
+    return cow_compare( *(gr_d*)a, *(gr_d*)b );
+}
+
+
+static gr_size_t cow_key( const gr_d item )
+{
+    return (uintptr_t)item;
+}
+
+
+/* Return snapshot of "gr" after checking that "gr" is intact. */
+static gr_t cow_snap( gr_t gr )
+{
+    TEST_ASSERT_EQUAL( 8, gr_used( gr ) );
+    for ( int i = 0; i < 8; i++ ) {
+        TEST_ASSERT_EQUAL( cow_ref[ i ], (uintptr_t)gr_nth( gr, i ) );
+    }
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( gr ) );
+
+    return gr_duplicate_cow( gr );
+}
+
+
+void test_cow_mutators( void )
+{
+    gr_t  gr;
+    gr_t  snap;
+    gr_d  buf[ 4 ];
+
+    gr = gr_new_sized( 8 );
+    for ( int i = 0; i < 8; i++ )
+        gr_push( &gr, (gr_d)cow_ref[ i ] );
+
+    /* Each mutator makes the snapshot private. */
+    snap = cow_snap( gr );
+    TEST_ASSERT_EQUAL( 4, (uintptr_t)gr_pop( &snap ) );
+    TEST_ASSERT_TRUE( snap != gr );
+    TEST_ASSERT_EQUAL( 7, gr_used( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    TEST_ASSERT_EQUAL( 3, gr_drop( &snap, 3 ) );
+    TEST_ASSERT_EQUAL( 5, gr_used( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    TEST_ASSERT_EQUAL( 4, gr_pop_n( &snap, buf, 4 ) );
+    TEST_ASSERT_EQUAL( 7, (uintptr_t)buf[ 0 ] );
+    TEST_ASSERT_EQUAL( 4, gr_used( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_reset( &snap );
+    TEST_ASSERT_EQUAL( 0, gr_used( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_clear( &snap );
+    TEST_ASSERT_EQUAL( 0, gr_used( snap ) );
+    TEST_ASSERT_NULL( gr_data( snap )[ 0 ] );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_release( &snap );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    TEST_ASSERT_EQUAL( 5, (uintptr_t)gr_swap( &snap, 0, (gr_d)9 ) );
+    TEST_ASSERT_EQUAL( 9, (uintptr_t)gr_first( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    TEST_ASSERT_EQUAL( 0, gr_insert_if( &snap, 0, (gr_d)9 ) );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( snap ) );
+    gr_pop( &snap );
+    TEST_ASSERT_EQUAL( 1, gr_insert_if( &snap, 0, (gr_d)9 ) );
+    TEST_ASSERT_EQUAL( 9, (uintptr_t)gr_first( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    TEST_ASSERT_EQUAL( 3, (uintptr_t)gr_delete_at( &snap, 1 ) );
+    TEST_ASSERT_EQUAL( 8, (uintptr_t)gr_nth( snap, 1 ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_sort( &snap, cow_sort_compare );
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gr_first( snap ) );
+    TEST_ASSERT_EQUAL( 8, (uintptr_t)gr_last( snap ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_pop( &snap );
+    TEST_ASSERT_NOT_NULL( gr_alloc( &snap, 8 ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_heapify( &snap, cow_compare );
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gr_heap_peek( snap ) );
+    gr_swap( &snap, 7, (gr_d)0 );
+    gr_heap_decrease( &snap, 7, cow_compare );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gr_heap_pop( &snap, cow_compare ) );
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gr_heap_pop( &snap, cow_compare ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_heapify_by( &snap, cow_key );
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gr_heap_pop_by( &snap, cow_key ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_heapify_by( &snap, cow_key );
+    TEST_ASSERT_EQUAL( 7, gr_heap_decrease_by( &snap, 7, cow_key ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_select( &snap, 3, cow_compare );
+    TEST_ASSERT_EQUAL( 4, (uintptr_t)gr_nth( snap, 3 ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_select_by( &snap, 3, cow_key );
+    TEST_ASSERT_EQUAL( 4, (uintptr_t)gr_nth( snap, 3 ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_partial_sort( &snap, 3, cow_compare );
+    TEST_ASSERT_EQUAL( 3, (uintptr_t)gr_nth( snap, 2 ) );
+    gr_destroy( &snap );
+
+    snap = cow_snap( gr );
+    gr_partial_sort_by( &snap, 3, cow_key );
+    TEST_ASSERT_EQUAL( 3, (uintptr_t)gr_nth( snap, 2 ) );
+    gr_destroy( &snap );
+
+    /* Top-k heap of the snapshot. */
+    snap = NULL;
+    for ( int i = 0; i < 8; i++ )
+        gr_topk_push( &snap, 3, (gr_d)cow_ref[ i ], cow_compare );
+    gr_t top = gr_duplicate_cow( snap );
+    TEST_ASSERT_EQUAL( 9, (uintptr_t)gr_topk_push( &top, 3, (gr_d)9, cow_compare ) );
+    TEST_ASSERT_EQUAL( 3, (uintptr_t)gr_topk_push( &top, 3, (gr_d)0, cow_compare ) );
+    TEST_ASSERT_TRUE( top != snap );
+    gr_topk_sort( &top, cow_compare );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gr_first( top ) );
+    gr_destroy( &top );
+    top = gr_duplicate_cow( snap );
+    gr_topk_sort_by( &top, cow_key );
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gr_first( top ) );
+    TEST_ASSERT_EQUAL( 3, (uintptr_t)gr_last( top ) );
+    gr_destroy( &top );
+    gr_destroy( &snap );
+
+    /* Original is mutated while snapshot is held. */
+    snap = cow_snap( gr );
+    gr_reset( &gr );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 8, gr_used( snap ) );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( snap ) );
+
+    gr_destroy( &snap );
+    gr_destroy( &gr );
+}
+
 int gr_compare_fn( const gr_d a, const gr_d b )
 {
     if ( a == b )
@@ -84,6 +310,319 @@ int gr_compare_fn( const gr_d a, const gr_d b )
 }
 
 
+void test_uninit( void )
+{
+    gr_t gr;
+    gr_t dup;
+    gr_t snap;
+
+    gr = gr_new_sized( 4 );
+    TEST_ASSERT_EQUAL( GR_UNINIT, gr_get_uninit( gr ) );
+    gr_destroy( &gr );
+
+    gr = gr_new_uninit( 4 );
+    TEST_ASSERT_EQUAL( 1, gr_get_uninit( gr ) );
+    TEST_ASSERT_EQUAL( 4, gr_size( gr ) );
+    TEST_ASSERT_NULL( gr_first( gr ) );
+
+    /* Mode is preserved over growth. */
+    for ( uintptr_t i = 1; i <= 100; i++ )
+        gr_push( &gr, (gr_d)i );
+    TEST_ASSERT_EQUAL( 1, gr_get_uninit( gr ) );
+    TEST_ASSERT_EQUAL( 100, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 100, (uintptr_t)gr_last( gr ) );
+    TEST_ASSERT_TRUE( gr_size( gr ) >= 100 );
+    TEST_ASSERT_TRUE( gr_size( gr ) < 256 );
+
+    dup = gr_duplicate( gr );
+    TEST_ASSERT_EQUAL( 1, gr_get_uninit( dup ) );
+    TEST_ASSERT_EQUAL( 55, (uintptr_t)gr_nth( dup, 54 ) );
+    gr_destroy( &dup );
+
+    /* ... and over copy-on-write relocation. */
+    snap = gr_duplicate_cow( gr );
+    gr_push( &gr, (gr_d)101 );
+    TEST_ASSERT_EQUAL( 1, gr_get_uninit( gr ) );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( gr ) );
+    TEST_ASSERT_EQUAL( 100, gr_used( snap ) );
+    gr_destroy( &snap );
+
+    /* Clear touches only used slots. */
+    gr_clear( &gr );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    TEST_ASSERT_NULL( gr_first( gr ) );
+    TEST_ASSERT_NULL( gr_data( gr )[ 100 ] );
+
+    /* Default mode zero-fills slots beyond usage. */
+    gr_data( gr )[ gr_size( gr ) - 1 ] = (gr_d)1;
+    gr_set_uninit( gr, 0 );
+    TEST_ASSERT_EQUAL( GR_UNINIT, gr_get_uninit( gr ) );
+    if ( !GR_UNINIT ) {
+        TEST_ASSERT_NULL( gr_data( gr )[ gr_size( gr ) - 1 ] );
+    }
+    gr_resize( &gr, 1024 );
+    if ( !GR_UNINIT ) {
+        TEST_ASSERT_NULL( gr_data( gr )[ 1023 ] );
+    }
+
+    gr_destroy( &gr );
+}
+
+
+static gr_size_t resident_pages( gr_d mem, gr_size_t bytes )
+{
+    gr_size_t     page = gr_alloc_pages( 0, NULL );
+    gr_size_t     count = bytes / page;
+    unsigned char vec[ 64 ];
+    gr_size_t     ret = 0;
+
+    TEST_ASSERT_TRUE( count <= 64 );
+    TEST_ASSERT_EQUAL( 0, mincore( mem, bytes, vec ) );
+    for ( gr_size_t i = 0; i < count; i++ )
+        ret += vec[ i ] & 1;
+
+    return ret;
+}
+
+
+void test_release( void )
+{
+    gr_t      gr;
+    gr_size_t page = gr_alloc_pages( 0, NULL );
+    gr_size_t size;
+
+    /* Explicit release of paged Gromer. */
+    gr = gr_new_page( 16 );
+    size = gr_size( gr );
+    while ( !gr_is_full( gr ) )
+        gr_push( &gr, (gr_d)1 );
+    TEST_ASSERT_EQUAL( 16, resident_pages( gr, 16 * page ) );
+
+    gr_drop( &gr, size - 10 );
+    TEST_ASSERT_EQUAL( 15 * page, gr_release( &gr ) );
+    TEST_ASSERT_EQUAL( size, gr_size( gr ) );
+    TEST_ASSERT_EQUAL( 10, gr_used( gr ) );
+    if ( !GR_UNINIT ) {
+        /* MADV_FREE pages are reclaimed lazily. */
+        TEST_ASSERT_EQUAL( 1, resident_pages( gr, 16 * page ) );
+        TEST_ASSERT_NULL( gr_data( gr )[ size - 1 ] );
+    }
+
+    /* Refill faults pages back. */
+    while ( !gr_is_full( gr ) )
+        gr_push( &gr, (gr_d)2 );
+    TEST_ASSERT_EQUAL( (gr_d)1, gr_nth( gr, 9 ) );
+    TEST_ASSERT_EQUAL( (gr_d)2, gr_last( gr ) );
+    TEST_ASSERT_EQUAL( 0, gr_release( &gr ) );
+    gr_destroy( &gr );
+
+    /* Reset of well used storage keeps pages. */
+    size = 2 * GR_RELEASE_SIZE / sizeof( gr_d );
+    gr = gr_new_sized( size );
+    size = gr_size( gr );
+    for ( gr_size_t i = 0; i < size; i++ )
+        gr_push( &gr, (gr_d)1 );
+    gr_reset( &gr );
+    TEST_ASSERT_EQUAL( (gr_d)1, gr_data( gr )[ size - 1 ] );
+
+    /* Reset of idle storage keeps twice the usage. */
+    for ( gr_size_t i = 0; i < size / 8; i++ )
+        gr_push( &gr, (gr_d)2 );
+    gr_reset( &gr );
+    TEST_ASSERT_EQUAL( (gr_d)1, gr_data( gr )[ size / 8 + size / 16 ] );
+    if ( !GR_UNINIT )
+        TEST_ASSERT_NULL( gr_data( gr )[ size / 2 ] );
+
+    /* Clear releases as reset. */
+    for ( gr_size_t i = 0; i < size; i++ )
+        gr_push( &gr, (gr_d)1 );
+    gr_reset( &gr );
+    for ( gr_size_t i = 0; i < size / 8; i++ )
+        gr_push( &gr, (gr_d)2 );
+    gr_clear( &gr );
+    TEST_ASSERT_NULL( gr_data( gr )[ 0 ] );
+    TEST_ASSERT_EQUAL( (gr_d)1, gr_data( gr )[ size / 8 + size / 16 ] );
+    if ( !GR_UNINIT )
+        TEST_ASSERT_NULL( gr_data( gr )[ size / 2 ] );
+
+    /* Explicit release on reset releases all unused pages. */
+    for ( gr_size_t i = 0; i < size; i++ )
+        gr_push( &gr, (gr_d)1 );
+    TEST_ASSERT_TRUE( gr_reset_release( &gr ) > 0 );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    if ( !GR_UNINIT )
+        TEST_ASSERT_NULL( gr_data( gr )[ size / 2 ] );
+    gr_push( &gr, (gr_d)1 );
+    TEST_ASSERT_EQUAL( size, gr_size( gr ) );
+    gr_destroy( &gr );
+
+    /* Small Gromer is not released. */
+    gr = gr_new_sized( 64 );
+    gr_push( &gr, (gr_d)1 );
+    TEST_ASSERT_EQUAL( 0, gr_reset_release( &gr ) );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    gr_destroy( &gr );
+}
+
+
+void test_batch( void )
+{
+    gr_t      gr;
+    gr_t      dst = NULL;
+    gr_t      out;
+    gr_d      buf[ 8 ];
+    gr_size_t count;
+    pid_t     pid;
+    int       status;
+
+    gr = gr_new_sized( 32 );
+    for ( uintptr_t i = 1; i <= 20; i++ )
+        gr_push( &gr, (gr_d)i );
+
+    TEST_ASSERT_EQUAL( 8, gr_pop_n( &gr, buf, 8 ) );
+    TEST_ASSERT_EQUAL( 12, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)13, buf[ 0 ] );
+    TEST_ASSERT_EQUAL( (gr_d)20, buf[ 7 ] );
+
+    TEST_ASSERT_EQUAL( 5, gr_pop_into( &gr, &dst, 5 ) );
+    TEST_ASSERT_EQUAL( 5, gr_used( dst ) );
+    TEST_ASSERT_EQUAL( (gr_d)8, gr_first( dst ) );
+    TEST_ASSERT_EQUAL( (gr_d)12, gr_last( dst ) );
+
+    /* Count is limited to usage. */
+    TEST_ASSERT_EQUAL( 7, gr_pop_into( &gr, &dst, 100 ) );
+    TEST_ASSERT_EQUAL( 12, gr_used( dst ) );
+    TEST_ASSERT_EQUAL( (gr_d)7, gr_last( dst ) );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    TEST_ASSERT_NULL( gr_first( gr ) );
+    TEST_ASSERT_EQUAL( 0, gr_pop_n( &gr, buf, 8 ) );
+
+    /* Drain hands over storage and leaves same size. */
+    out = gr_drain( &dst );
+    TEST_ASSERT_EQUAL( 12, gr_used( out ) );
+    TEST_ASSERT_EQUAL( (gr_d)8, gr_first( out ) );
+    TEST_ASSERT_EQUAL( 0, gr_used( dst ) );
+    TEST_ASSERT_EQUAL( gr_size( out ), gr_size( dst ) );
+    TEST_ASSERT_EQUAL( GR_UNINIT, gr_get_uninit( dst ) );
+    if ( !GR_UNINIT ) {
+        TEST_ASSERT_NULL( gr_data( dst )[ gr_size( dst ) - 1 ] );
+    }
+    gr_push( &dst, (gr_d)1 );
+    TEST_ASSERT_EQUAL( 1, gr_used( dst ) );
+    gr_destroy( &out );
+    gr_destroy( &dst );
+
+    /* Shared source is made private before popping. */
+    for ( uintptr_t i = 1; i <= 10; i++ )
+        gr_push( &gr, (gr_d)i );
+    out = gr_duplicate_cow( gr );
+    TEST_ASSERT_EQUAL( 5, gr_pop_into( &out, &dst, 5 ) );
+    TEST_ASSERT_EQUAL( 5, gr_used( out ) );
+    TEST_ASSERT_EQUAL( 10, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 5, gr_used( dst ) );
+    TEST_ASSERT_EQUAL( (gr_d)6, gr_first( dst ) );
+    TEST_ASSERT_EQUAL( (gr_d)10, gr_last( dst ) );
+    gr_destroy( &out );
+    gr_destroy( &dst );
+
+    /* Frozen source asserts, or pops nothing. */
+    gr_freeze( &gr, 0 );
+    pid = fork();
+    if ( pid == 0 ) {
+        close( STDERR_FILENO );
+        count = gr_pop_into( &gr, &dst, 5 );
+        _exit( count == 0 && gr_used( dst ) == 0 && gr_used( gr ) == 10 ? 0 : 1 );
+    }
+    waitpid( pid, &status, 0 );
+    TEST_ASSERT_FALSE( WIFEXITED( status ) && WEXITSTATUS( status ) == 1 );
+    gr_destroy( &gr );
+
+    /* Local Gromer is copied. */
+    gr_local_use( gr, lbuf, 16 );
+    gr_push( &gr, (gr_d)1 );
+    out = gr_drain( &gr );
+    TEST_ASSERT_EQUAL( 1, gr_used( out ) );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 1, gr_get_local( gr ) );
+    gr_destroy( &out );
+}
+
+
+void test_freeze( void )
+{
+    gr_t  gr;
+    gr_t  dup;
+    pid_t pid;
+    int   status;
+
+    gr = gr_new();
+    for ( uintptr_t i = 1; i <= 21; i++ )
+        gr_push( &gr, (gr_d)i );
+    TEST_ASSERT_EQUAL( 32, gr_size( gr ) );
+
+    /* Exact size (even). */
+    TEST_ASSERT_EQUAL( 0, gr_freeze( &gr, 0 ) );
+    TEST_ASSERT_EQUAL( 1, gr_is_frozen( gr ) );
+    TEST_ASSERT_EQUAL( 22, gr_size( gr ) );
+    TEST_ASSERT_EQUAL( 21, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)21, gr_last( gr ) );
+    TEST_ASSERT_EQUAL( 20, gr_find( gr, (gr_d)21 ) );
+
+    /* Mutation asserts, or leaves Gromer unchanged. */
+    pid = fork();
+    if ( pid == 0 ) {
+        close( STDERR_FILENO );
+        gr_push( &gr, (gr_d)22 );
+        gr_insert_at( &gr, 0, (gr_d)22 );
+        _exit( gr_used( gr ) == 21 && gr_size( gr ) == 22 && gr_last( gr ) == (gr_d)21 ? 0 : 1 );
+    }
+    waitpid( pid, &status, 0 );
+    TEST_ASSERT_FALSE( WIFEXITED( status ) && WEXITSTATUS( status ) == 1 );
+
+    /* Duplicate is a mutable copy. */
+    dup = gr_duplicate_cow( gr );
+    TEST_ASSERT_TRUE( dup != gr );
+    TEST_ASSERT_EQUAL( 0, gr_is_frozen( dup ) );
+    gr_push( &dup, (gr_d)22 );
+    TEST_ASSERT_EQUAL( 22, gr_used( dup ) );
+    gr_destroy( &dup );
+    gr_destroy( &gr );
+
+    /* Protected, shared storage is made private. */
+    gr = gr_new();
+    for ( uintptr_t i = 1; i <= 1000; i++ )
+        gr_push( &gr, (gr_d)i );
+    dup = gr_duplicate_cow( gr );
+    TEST_ASSERT_EQUAL( 1, gr_freeze( &gr, 1 ) );
+    TEST_ASSERT_EQUAL( 0, gr_is_shared( dup ) );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gr % gr_alloc_pages( 0, NULL ) );
+    TEST_ASSERT_EQUAL( 1000, gr_size( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)500, gr_nth( gr, 499 ) );
+    TEST_ASSERT_EQUAL( 1, gr_freeze( &gr, 1 ) );
+    TEST_ASSERT_EQUAL( 1, gr_is_frozen( gr ) );
+
+    /* Forked reader sees the items, and writes fault. */
+    pid = fork();
+    if ( pid == 0 )
+        _exit( gr_nth( gr, 999 ) == (gr_d)1000 ? 0 : 1 );
+    waitpid( pid, &status, 0 );
+    TEST_ASSERT_TRUE( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+
+    pid = fork();
+    if ( pid == 0 ) {
+        close( STDERR_FILENO );
+        signal( SIGSEGV, SIG_DFL );
+        ( (volatile gr_t)gr )->data[ 0 ] = NULL;
+        _exit( 0 );
+    }
+    waitpid( pid, &status, 0 );
+    TEST_ASSERT_FALSE( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+
+    gr_destroy( &gr );
+    gr_destroy( &dup );
+}
+
+
 void test_random_access( void )
 {
     gr_t     gr;
@@ -97,8 +636,8 @@ void test_random_access( void )
     TEST_ASSERT_EQUAL( NULL, gr_data( gr )[ 0 ] );
     TEST_ASSERT_EQUAL( text, gr_last( gr ) );
 
-    tmp = gr_swap( gr, 0, text );
-    gr_swap( gr, 1, tmp );
+    tmp = gr_swap( &gr, 0, text );
+    gr_swap( &gr, 1, tmp );
     TEST_ASSERT_EQUAL( text, gr_first( gr ) );
     TEST_ASSERT_EQUAL( NULL, gr_last( gr ) );
 
@@ -122,18 +661,18 @@ void test_random_access( void )
     TEST_ASSERT_EQUAL( 2 * GR_DEFAULT_SIZE, gr_size( gr ) );
 
     for ( int i = 0; i < GR_DEFAULT_SIZE; i++ ) {
-        gr_insert_if( gr, gr_used( gr ) - 1, text );
+        gr_insert_if( &gr, gr_used( gr ) - 1, text );
     }
 
     TEST_ASSERT_EQUAL( 2 * GR_DEFAULT_SIZE, gr_size( gr ) );
 
     for ( int i = 0; i < GR_DEFAULT_SIZE / 2; i++ ) {
-        tmp = gr_delete_at( gr, 0 );
+        tmp = gr_delete_at( &gr, 0 );
         TEST_ASSERT_EQUAL( text, tmp );
     }
 
     for ( int i = 0; i < GR_DEFAULT_SIZE / 2; i++ ) {
-        gr_delete_at( gr, gr_used( gr ) - 1 );
+        gr_delete_at( &gr, gr_used( gr ) - 1 );
     }
 
     TEST_ASSERT_EQUAL( text, gr_first( gr ) );
@@ -151,24 +690,24 @@ void test_random_access( void )
     }
 
     for ( int i = 0; i < 2 * GR_DEFAULT_SIZE; i++ ) {
-        gr_pop( gr );
+        gr_pop( &gr );
     }
 
     TEST_ASSERT_EQUAL( NULL, gr_first( gr ) );
     TEST_ASSERT_EQUAL( NULL, gr_last( gr ) );
     TEST_ASSERT_EQUAL( NULL, gr_nth( gr, 0 ) );
 
-    gr_swap( gr, 0, NULL );
-    gr_insert_if( gr, 0, text );
-    gr_delete_at( gr, 0 );
-    gr_delete_at( gr, 0 );
+    gr_swap( &gr, 0, NULL );
+    gr_insert_if( &gr, 0, text );
+    gr_delete_at( &gr, 0 );
+    gr_delete_at( &gr, 0 );
 
     TEST_ASSERT_EQUAL( GR_NOT_INDEX, gr_find( gr, text ) );
     TEST_ASSERT_EQUAL( GR_NOT_INDEX, gr_find_with( gr, gr_compare_fn, text ) );
 
     gr_destroy( &gr );
     gr_remove( &gr );
-    gr_swap( gr, 0, NULL );
+    gr_swap( &gr, 0, NULL );
 
     TEST_ASSERT_EQUAL( 0, gr_is_empty( gr ) );
     TEST_ASSERT_EQUAL( 0, gr_is_full( gr ) );
@@ -179,6 +718,54 @@ void test_random_access( void )
 }
 
 
+void test_prefetch( void )
+{
+    struct obj_s
+    {
+        char     name[ 12 ];
+        uint32_t value;
+    };
+
+    struct obj_s  objs[ 20 ];
+    struct obj_s* obj;
+    uint32_t      buf[ 20 ];
+    gr_t          gr;
+    gr_size_t     cnt;
+
+    gr = gr_new();
+    for ( uint32_t i = 0; i < 20; i++ ) {
+        objs[ i ].value = i * 3;
+        gr_push( &gr, &objs[ i ] );
+    }
+
+    cnt = 0;
+    gr_each_prefetch( gr, obj, struct obj_s*, 4 )
+    {
+        TEST_ASSERT_EQUAL( cnt * 3, obj->value );
+        cnt++;
+    }
+    TEST_ASSERT_EQUAL( 20, cnt );
+
+    cnt = gr_gather( gr, 0, 20, offsetof( struct obj_s, value ), sizeof( uint32_t ), buf );
+    TEST_ASSERT_EQUAL( 20, cnt );
+    for ( uint32_t i = 0; i < 20; i++ ) {
+        TEST_ASSERT_EQUAL( i * 3, buf[ i ] );
+    }
+
+    /* Saturated count and NULL item. */
+    gr_swap( &gr, 18, NULL );
+    cnt = gr_gather( gr, 15, 10, offsetof( struct obj_s, value ), sizeof( uint32_t ), buf );
+    TEST_ASSERT_EQUAL( 5, cnt );
+    TEST_ASSERT_EQUAL( 45, buf[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, buf[ 3 ] );
+    TEST_ASSERT_EQUAL( 57, buf[ 4 ] );
+
+    TEST_ASSERT_EQUAL( 0, gr_gather( gr, 20, 1, 0, 1, buf ) );
+
+    gr_destroy( &gr );
+}
+
+
 int gr_sort_compare( const gr_d a, const gr_d b )
 {
     char* sa = *((char**)a);
@@ -204,7 +791,7 @@ void test_sorting( void )
     TEST_ASSERT_EQUAL_STRING( gr_item( gr, 1, char* ), str1 );
     TEST_ASSERT_EQUAL_STRING( gr_item( gr, 2, char* ), str2 );
 
-    gr_sort( gr, gr_sort_compare );
+    gr_sort( &gr, gr_sort_compare );
 
     TEST_ASSERT_EQUAL_STRING( gr_item( gr, 0, char* ), str1 );
     TEST_ASSERT_EQUAL_STRING( gr_item( gr, 1, char* ), str2 );
@@ -252,6 +839,284 @@ void test_static( void )
 
 
 
+int gr_heap_compare( const gr_d a, const gr_d b )
+{
+    return ( (uintptr_t)a > (uintptr_t)b ) - ( (uintptr_t)a < (uintptr_t)b );
+}
+
+
+gr_size_t gr_heap_key( const gr_d item )
+{
+    return *(gr_size_t*)item;
+}
+
+
+void test_heap( void )
+{
+    gr_t      gr;
+    gr_size_t keys[ 100 ];
+    gr_size_t extra;
+    gr_size_t prev;
+    gr_size_t pos;
+
+    /* Compare variant. */
+    gr = gr_new();
+    TEST_ASSERT_NULL( gr_heap_peek( gr ) );
+    TEST_ASSERT_NULL( gr_heap_pop( &gr, gr_heap_compare ) );
+    for ( uintptr_t i = 0; i < 100; i++ )
+        gr_heap_push( &gr, (gr_d)( ( i * 37 ) % 101 + 1 ), gr_heap_compare );
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gr_heap_peek( gr ) );
+
+    prev = 0;
+    for ( int i = 0; i < 100; i++ ) {
+        uintptr_t cur = (uintptr_t)gr_heap_pop( &gr, gr_heap_compare );
+        TEST_ASSERT_TRUE( cur > prev );
+        prev = cur;
+    }
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+
+    for ( uintptr_t i = 50; i > 0; i-- )
+        gr_push( &gr, (gr_d)i );
+    gr_heapify( &gr, gr_heap_compare );
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gr_heap_pop( &gr, gr_heap_compare ) );
+    TEST_ASSERT_EQUAL( 2, (uintptr_t)gr_heap_pop( &gr, gr_heap_compare ) );
+    gr_swap( &gr, -1, (gr_d)0 );
+    pos = gr_heap_decrease( &gr, -1, gr_heap_compare );
+    TEST_ASSERT_EQUAL( 0, pos );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gr_heap_peek( gr ) );
+    gr_destroy( &gr );
+
+    /* Key variant. */
+    for ( gr_size_t i = 0; i < 100; i++ ) {
+        keys[ i ] = ( i * 53 ) % 100;
+        gr_add( &gr, &keys[ i ] );
+    }
+    gr_heapify_by( &gr, gr_heap_key );
+    extra = 1000;
+    gr_heap_push_by( &gr, &extra, gr_heap_key );
+    extra = 0;
+    pos = gr_heap_decrease_by( &gr, gr_find( gr, &extra ), gr_heap_key );
+    TEST_ASSERT_TRUE( pos < GR_HEAP_ARITY + 1 );
+
+    prev = 0;
+    for ( int i = 0; i < 101; i++ ) {
+        gr_size_t cur = *(gr_size_t*)gr_heap_pop_by( &gr, gr_heap_key );
+        TEST_ASSERT_TRUE( cur >= prev );
+        prev = cur;
+    }
+    TEST_ASSERT_EQUAL( 99, prev );
+    gr_destroy( &gr );
+}
+
+
+void test_select( void )
+{
+    gr_t      gr;
+    gr_t      top;
+    gr_size_t keys[ 1000 ];
+    gr_d      out;
+
+    gr = gr_new();
+    for ( uintptr_t i = 0; i < 1000; i++ )
+        gr_push( &gr, (gr_d)( ( i * 7919 ) % 1000 ) );
+
+    gr_select( &gr, 500, gr_heap_compare );
+    TEST_ASSERT_EQUAL( 500, (uintptr_t)gr_nth( gr, 500 ) );
+    for ( gr_size_t i = 0; i < 500; i++ ) {
+        TEST_ASSERT_TRUE( (uintptr_t)gr_nth( gr, i ) < 500 );
+    }
+
+    gr_partial_sort( &gr, 100, gr_heap_compare );
+    for ( uintptr_t i = 0; i < 100; i++ ) {
+        TEST_ASSERT_EQUAL( i, (uintptr_t)gr_nth( gr, i ) );
+    }
+
+    gr_partial_sort( &gr, 2000, gr_heap_compare );
+    for ( uintptr_t i = 0; i < 1000; i++ ) {
+        TEST_ASSERT_EQUAL( i, (uintptr_t)gr_nth( gr, i ) );
+    }
+
+    /* Streaming top-k. */
+    top = NULL;
+    for ( uintptr_t i = 0; i < 1000; i++ ) {
+        out = gr_topk_push( &top, 10, (gr_d)( ( i * 7919 ) % 1000 ), gr_heap_compare );
+        if ( i < 10 )
+            TEST_ASSERT_NULL( out );
+    }
+    TEST_ASSERT_EQUAL( 10, gr_used( top ) );
+    TEST_ASSERT_EQUAL( 9, (uintptr_t)gr_first( top ) );
+    TEST_ASSERT_EQUAL_PTR( (gr_d)500, gr_topk_push( &top, 10, (gr_d)500, gr_heap_compare ) );
+    gr_topk_sort( &top, gr_heap_compare );
+    for ( uintptr_t i = 0; i < 10; i++ ) {
+        TEST_ASSERT_EQUAL( i, (uintptr_t)gr_nth( top, i ) );
+    }
+    gr_destroy( &top );
+    gr_destroy( &gr );
+
+    /* Key variants. */
+    for ( gr_size_t i = 0; i < 1000; i++ ) {
+        keys[ i ] = ( i * 7919 ) % 1000;
+        gr_add( &gr, &keys[ i ] );
+        gr_topk_push_by( &top, 5, &keys[ i ], gr_heap_key );
+    }
+    gr_select_by( &gr, 10, gr_heap_key );
+    TEST_ASSERT_EQUAL( 10, *(gr_size_t*)gr_nth( gr, 10 ) );
+    gr_partial_sort_by( &gr, 3, gr_heap_key );
+    TEST_ASSERT_EQUAL( 2, *(gr_size_t*)gr_nth( gr, 2 ) );
+    gr_topk_sort_by( &top, gr_heap_key );
+    TEST_ASSERT_EQUAL( 0, *(gr_size_t*)gr_first( top ) );
+    TEST_ASSERT_EQUAL( 4, *(gr_size_t*)gr_last( top ) );
+
+    gr_destroy( &top );
+    gr_destroy( &gr );
+}
+
+
+void test_merge( void )
+{
+    gr_t      grs[ 5 ];
+    gr_t      gr;
+    gr_size_t total = 0;
+
+    for ( uintptr_t i = 0; i < 5; i++ ) {
+        grs[ i ] = gr_new();
+        /* Input "i" has multiples of "i + 1". */
+        for ( uintptr_t v = i + 1; v <= 60; v += i + 1 ) {
+            gr_push( &grs[ i ], (gr_d)v );
+            total++;
+        }
+    }
+
+    gr = gr_merge( grs, 5, gr_heap_compare, 0 );
+    TEST_ASSERT_EQUAL( total, gr_used( gr ) );
+    TEST_ASSERT_TRUE( gr_size( gr ) <= total + 1 );
+    for ( gr_size_t i = 1; i < gr_used( gr ); i++ ) {
+        TEST_ASSERT_TRUE( (uintptr_t)gr_nth( gr, i - 1 ) <= (uintptr_t)gr_nth( gr, i ) );
+    }
+    gr_destroy( &gr );
+
+    gr = gr_merge( grs, 5, gr_heap_compare, 1 );
+    TEST_ASSERT_EQUAL( 60, gr_used( gr ) );
+    for ( uintptr_t i = 0; i < 60; i++ ) {
+        TEST_ASSERT_EQUAL( i + 1, (uintptr_t)gr_nth( gr, i ) );
+    }
+    TEST_ASSERT_EQUAL( GR_UNINIT, gr_get_uninit( gr ) );
+    if ( !GR_UNINIT ) {
+        /* Slots left by dropped duplicates are zero. */
+        for ( gr_size_t i = gr_used( gr ); i < gr_size( gr ); i++ )
+            TEST_ASSERT_NULL( gr_data( gr )[ i ] );
+    }
+    gr_destroy( &gr );
+
+    gr = gr_merge( &grs[ 3 ], 1, gr_heap_compare, 0 );
+    TEST_ASSERT_EQUAL( 15, gr_used( gr ) );
+    gr_destroy( &gr );
+
+    gr = gr_merge( grs, 0, gr_heap_compare, 0 );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    gr_destroy( &gr );
+
+    for ( int i = 0; i < 5; i++ )
+        gr_destroy( &grs[ i ] );
+}
+
+
+typedef struct
+{
+    uint64_t key;
+    uint64_t val;
+} rec_t;
+
+
+int gv_rec_compare( const gr_d a, const gr_d b )
+{
+    const rec_t* ra = (const rec_t*)a;
+    const rec_t* rb = (const rec_t*)b;
+
+    return ( ra->key > rb->key ) - ( ra->key < rb->key );
+}
+
+
+void test_value( void )
+{
+    gv_t   gv;
+    rec_t  rec;
+    rec_t* ptr;
+
+    gv = gv_new_for( rec_t );
+    TEST_ASSERT_EQUAL( sizeof( rec_t ), gv_unit( gv ) );
+    TEST_ASSERT_EQUAL( GR_DEFAULT_SIZE, gv_size( gv ) );
+
+    for ( uint64_t i = 0; i < 20; i++ ) {
+        rec.key = 20 - i;
+        rec.val = i;
+        gv_push( &gv, &rec );
+    }
+    TEST_ASSERT_EQUAL( 2 * GR_DEFAULT_SIZE, gv_size( gv ) );
+    TEST_ASSERT_EQUAL( 20, gv_used( gv ) );
+    TEST_ASSERT_EQUAL( 1, gv_item( gv, 19, rec_t ).key );
+    TEST_ASSERT_EQUAL( 20, ( (rec_t*)gv_nth( gv, 0 ) )->key );
+    TEST_ASSERT_EQUAL( 1, ( (rec_t*)gv_nth( gv, -1 ) )->key );
+
+    rec.key = 100;
+    gv_insert_at( &gv, 1, &rec );
+    TEST_ASSERT_EQUAL( 100, gv_item( gv, 1, rec_t ).key );
+    TEST_ASSERT_EQUAL( 19, gv_item( gv, 2, rec_t ).key );
+
+    TEST_ASSERT_TRUE( gv_delete_at( gv, 0, &rec ) );
+    TEST_ASSERT_EQUAL( 20, rec.key );
+    TEST_ASSERT_EQUAL( 100, gv_item( gv, 0, rec_t ).key );
+    TEST_ASSERT_EQUAL( 20, gv_used( gv ) );
+
+    gv_sort( gv, gv_rec_compare );
+    uint64_t prev = 0;
+    gv_each( gv, ptr, rec_t )
+    {
+        TEST_ASSERT_TRUE( ptr->key > prev );
+        prev = ptr->key;
+    }
+
+    ptr = gv_pop( gv );
+    TEST_ASSERT_EQUAL( 100, ptr->key );
+    TEST_ASSERT_EQUAL( 19, gv_used( gv ) );
+
+    gv_reset( gv );
+    TEST_ASSERT_NULL( gv_pop( gv ) );
+    TEST_ASSERT_NULL( gv_nth( gv, 0 ) );
+    TEST_ASSERT_FALSE( gv_delete_at( gv, 0, NULL ) );
+    gv_destroy( &gv );
+    TEST_ASSERT_NULL( gv );
+
+    /* Data is aligned for any type. */
+    gv = gv_new_for( long double );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gv->data % GV_ALIGN );
+    TEST_ASSERT_TRUE( GV_ALIGN >= __alignof__( long double ) );
+    for ( int i = 0; i < 20; i++ ) {
+        long double v = i / 4.0L;
+        gv_push( &gv, &v );
+    }
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gv->data % GV_ALIGN );
+    TEST_ASSERT_TRUE( gv_item( gv, 10, long double ) == 2.5L );
+    gv_destroy( &gv );
+
+    /* Local storage. */
+    gv_local_use( gv, buf, 4, sizeof( rec_t ) );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gv->data % GV_ALIGN );
+    TEST_ASSERT_TRUE( gv_get_local( gv ) );
+    TEST_ASSERT_EQUAL( 4, gv_size( gv ) );
+    for ( uint64_t i = 0; i < 5; i++ ) {
+        rec.key = i;
+        gv_push( &gv, &rec );
+    }
+    TEST_ASSERT_FALSE( gv_get_local( gv ) );
+    TEST_ASSERT_EQUAL( 5, gv_used( gv ) );
+    TEST_ASSERT_EQUAL( 3, gv_item( gv, 3, rec_t ).key );
+    gv_resize( &gv, 64 );
+    TEST_ASSERT_EQUAL( 64, gv_size( gv ) );
+    gv_destroy( &gv );
+}
+
+
 void test_alloc( void )
 {
     gr_t      gr;
@@ -263,26 +1128,26 @@ void test_alloc( void )
     bytes = gr_alloc_pages( 0, NULL );
     TEST_ASSERT_TRUE( gr_total_size( gr ) == ( 2 * bytes ) );
 
-    gd = gr_alloc( gr, 1 );
+    gd = gr_alloc( &gr, 1 );
     TEST_ASSERT_TRUE( gd != NULL );
     TEST_ASSERT_TRUE( gr->used == 1 );
 
-    gd = gr_alloc( gr, 2 );
+    gd = gr_alloc( &gr, 2 );
     TEST_ASSERT_TRUE( gd != NULL );
     TEST_ASSERT_TRUE( gr->used == 2 );
 
-    gd = gr_alloc( gr, 8 );
+    gd = gr_alloc( &gr, 8 );
     TEST_ASSERT_TRUE( gd != NULL );
     TEST_ASSERT_TRUE( gr->used == 3 );
 
-    gd = gr_alloc( gr, 9 );
+    gd = gr_alloc( &gr, 9 );
     TEST_ASSERT_TRUE( gd != NULL );
     TEST_ASSERT_TRUE( gr->used == 5 );
 
-    gd = gr_alloc( gr, ( gr_size( gr ) - gr->used ) * sizeof( gr_d ) );
+    gd = gr_alloc( &gr, ( gr_size( gr ) - gr->used ) * sizeof( gr_d ) );
     TEST_ASSERT_TRUE( gd != NULL );
 
-    gd = gr_alloc( gr, 1 );
+    gd = gr_alloc( &gr, 1 );
     TEST_ASSERT_TRUE( gd == NULL );
 
     gr_free( gr );
@@ -0,0 +1,61 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_bloom.h"
+
+
+void test_bloom_basics( void )
+{
+    gf_t      gf;
+    gr_size_t found;
+
+    gf = gf_new();
+    TEST_ASSERT_EQUAL( 0, gf_used( gf ) );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, gf_find( gf, (gr_d)1 ) );
+    TEST_ASSERT_NULL( gf_pop( gf ) );
+    TEST_ASSERT_NULL( gf_delete_at( gf, 0 ) );
+
+    for ( uintptr_t i = 1; i <= 10000; i++ )
+        gf_push( gf, (gr_d)( i * 8 ) );
+    gf_insert_at( gf, 0, (gr_d)3 );
+    TEST_ASSERT_EQUAL( 10001, gf_used( gf ) );
+    TEST_ASSERT_EQUAL( (gr_d)8, gf_nth( gf, 1 ) );
+
+    /* No false negatives. */
+    for ( uintptr_t i = 1; i <= 10000; i++ )
+        TEST_ASSERT_EQUAL( i, gf_find( gf, (gr_d)( i * 8 ) ) );
+    TEST_ASSERT_EQUAL( 0, gf_find( gf, (gr_d)3 ) );
+    TEST_ASSERT_EQUAL( 1, gf->misses );
+
+    /* Misses are mostly rejected by filter. */
+    for ( uintptr_t i = 1; i <= 10000; i++ )
+        TEST_ASSERT_EQUAL( GR_NOT_INDEX, gf_find( gf, (gr_d)( i * 8 + 1 ) ) );
+    TEST_ASSERT_EQUAL( 10001, gf->misses + gf->false_hits );
+    TEST_ASSERT_TRUE( gf->false_hits < 500 );
+    TEST_ASSERT_TRUE( gf_fpr( gf ) > 0.0 && gf_fpr( gf ) < 0.05 );
+
+    /* Deleted items are rebuilt away. */
+    TEST_ASSERT_EQUAL( (gr_d)3, gf_delete_at( gf, 0 ) );
+    while ( gf_used( gf ) > 5000 )
+        gf_pop( gf );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, gf_find( gf, (gr_d)3 ) );
+    TEST_ASSERT_EQUAL( 0, gf->deleted );
+    found = 0;
+    for ( uintptr_t i = 1; i <= 10000; i++ )
+        found += ( gf_find( gf, (gr_d)( i * 8 ) ) != GR_NOT_INDEX );
+    TEST_ASSERT_EQUAL( 5000, found );
+
+    /* Direct modification and rebuild. */
+    gr_push( &gf->gr, (gr_d)77 );
+    gf_rebuild( gf );
+    TEST_ASSERT_EQUAL( 5000, gf_find( gf, (gr_d)77 ) );
+
+    gf_destroy( &gf );
+    TEST_ASSERT_NULL( gf );
+
+    /* More bits, fewer false positives. */
+    gf = gf_new_sized( 1000, 16 );
+    for ( uintptr_t i = 1; i <= 1000; i++ )
+        gf_push( gf, (gr_d)i );
+    TEST_ASSERT_TRUE( gf_fpr( gf ) < 0.005 );
+    gf_destroy( &gf );
+}
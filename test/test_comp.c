@@ -0,0 +1,82 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_comp.h"
+
+
+void test_comp_basics( void )
+{
+    gr_t      arena;
+    gz_t      gz;
+    gr_d      obj[ 1000 ];
+    gr_d      item;
+    gr_size_t cnt;
+
+    arena = gr_new_page( 4 );
+    gz = gz_new( arena->data, 3 );
+    TEST_ASSERT_EQUAL( 0, gz_used( gz ) );
+    TEST_ASSERT_NULL( gz_pop( gz ) );
+
+    /* Objects in arena, pushed in reverse address order. */
+    for ( int i = 0; i < 1000; i++ ) {
+        obj[ i ] = gr_alloc( &arena, 16 );
+        TEST_ASSERT_NOT_NULL( obj[ i ] );
+    }
+    for ( int i = 999; i >= 0; i-- )
+        gz_push( &gz, obj[ i ] );
+    gz_push( &gz, NULL );
+    TEST_ASSERT_EQUAL( 1001, gz_used( gz ) );
+    TEST_ASSERT_TRUE( gz_size( gz ) >= 1001 );
+    TEST_ASSERT_EQUAL( 2, gz->data[ 998 ] );
+
+    TEST_ASSERT_EQUAL_PTR( obj[ 999 ], gz_nth( gz, 0 ) );
+    TEST_ASSERT_EQUAL_PTR( obj[ 0 ], gz_nth( gz, -2 ) );
+    TEST_ASSERT_NULL( gz_nth( gz, -1 ) );
+
+    TEST_ASSERT_EQUAL( 0, gz_find( gz, obj[ 999 ] ) );
+    TEST_ASSERT_EQUAL( 997, gz_find( gz, obj[ 2 ] ) );
+    TEST_ASSERT_EQUAL( 999, gz_find( gz, obj[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 1000, gz_find( gz, NULL ) );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, gz_find( gz, &arena->data[ 2001 ] ) );
+
+    /* Address order, NULL last. */
+    gz_sort( gz );
+    for ( int i = 0; i < 1000; i++ )
+        TEST_ASSERT_EQUAL_PTR( obj[ i ], gz_nth( gz, i ) );
+    TEST_ASSERT_NULL( gz_pop( gz ) );
+
+    cnt = 0;
+    gz_each( gz, item, gr_d )
+    {
+        TEST_ASSERT_EQUAL_PTR( obj[ cnt ], item );
+        cnt++;
+    }
+    TEST_ASSERT_EQUAL( 1000, cnt );
+
+    TEST_ASSERT_EQUAL_PTR( obj[ 999 ], gz_pop( gz ) );
+    TEST_ASSERT_EQUAL( 999, gz_used( gz ) );
+
+    gz_destroy( &gz );
+    TEST_ASSERT_NULL( gz );
+    gr_destroy( &arena );
+}
+
+
+void test_comp_sort( void )
+{
+    gz_t     gz;
+    uint8_t* base = (uint8_t*)0x10000000;
+    uint32_t seed = 1;
+
+    /* Offsets span all radix digits. */
+    gz = gz_new_sized( base, 0, 10 );
+    for ( int i = 0; i < 5000; i++ ) {
+        seed = seed * 1103515245 + 12345;
+        gz_push( &gz, base + ( seed & 0x7FFFFFFF ) );
+    }
+    gz_sort( gz );
+    for ( int i = 1; i < 5000; i++ )
+        TEST_ASSERT_TRUE( gz->data[ i - 1 ] <= gz->data[ i ] );
+    TEST_ASSERT_EQUAL_PTR( base + gz->data[ 10 ], gz_nth( gz, 10 ) );
+
+    gz_destroy( &gz );
+}
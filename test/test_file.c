@@ -0,0 +1,162 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_file.h"
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+static int file_compare( const gr_d a, const gr_d b )
+{
+    uintptr_t ia = *( (uintptr_t*)a );
+    uintptr_t ib = *( (uintptr_t*)b );
+    return ( ia > ib ) - ( ia < ib );
+}
+
+
+void test_file_basics( void )
+{
+    gr_t gr;
+    char path[ 64 ];
+
+    snprintf( path, sizeof( path ), "/tmp/gromer_file_%d.grf", (int)getpid() );
+    unlink( path );
+
+    gr = gr_file_open( path, 16 );
+    TEST_ASSERT_NOT_NULL( gr );
+    TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+    TEST_ASSERT_TRUE( gr_size( gr ) >= 16 );
+    TEST_ASSERT_NOT_NULL( gr_get_external( gr ) );
+
+    /* Growth extends and remaps the file. */
+    for ( uintptr_t i = 0; i < 100000; i++ )
+        gr_push( &gr, (gr_d)( ( i * 7919 ) % 100000 ) );
+    TEST_ASSERT_EQUAL( 100000, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( 1, gr_find( gr, (gr_d)7919 ) );
+
+    gr_sort( &gr, file_compare );
+    TEST_ASSERT_EQUAL( (gr_d)0, gr_first( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)99999, gr_pop( &gr ) );
+    TEST_ASSERT_EQUAL( 0, gr_file_sync( gr ) );
+    gr_destroy( &gr );
+    TEST_ASSERT_NULL( gr );
+
+    /* Reopen with existing items. */
+    gr = gr_file_open( path, 16 );
+    TEST_ASSERT_NOT_NULL( gr );
+    TEST_ASSERT_EQUAL( 99999, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)500, gr_nth( gr, 500 ) );
+    gr_push( &gr, (gr_d)99999 );
+    TEST_ASSERT_EQUAL( 100000, gr_used( gr ) );
+
+    /* Shrink. */
+    gr_drop( &gr, 99000 );
+    gr_resize( &gr, 1000 );
+    TEST_ASSERT_TRUE( gr_size( gr ) < 2000 );
+    TEST_ASSERT_EQUAL( (gr_d)999, gr_last( gr ) );
+
+    /* Freeze keeps the file mapping. */
+    TEST_ASSERT_EQUAL( 0, gr_freeze( &gr, 1 ) );
+    TEST_ASSERT_EQUAL( 1, gr_is_frozen( gr ) );
+    TEST_ASSERT_NOT_NULL( gr_get_external( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)999, gr_last( gr ) );
+    TEST_ASSERT_EQUAL( 0, gr_file_sync( gr ) );
+    gr_destroy( &gr );
+
+    unlink( path );
+
+    /* Not a File Gromer. */
+    snprintf( path, sizeof( path ), "/tmp/gromer_file_%d.txt", (int)getpid() );
+    FILE* fh = fopen( path, "w" );
+    for ( int i = 0; i < 1000; i++ )
+        fputs( "text", fh );
+    fclose( fh );
+    TEST_ASSERT_NULL( gr_file_open( path, 16 ) );
+    unlink( path );
+}
+
+
+void test_file_arena( void )
+{
+    gr_t      arena;
+    gr_t      index;
+    char      apath[ 64 ];
+    char      ipath[ 64 ];
+    char      text[ 32 ];
+    gr_size_t off;
+
+    snprintf( apath, sizeof( apath ), "/tmp/gromer_arena_%d.grf", (int)getpid() );
+    snprintf( ipath, sizeof( ipath ), "/tmp/gromer_index_%d.grf", (int)getpid() );
+    unlink( apath );
+    unlink( ipath );
+
+    arena = gr_file_open( apath, 0 );
+    index = gr_file_open( ipath, 0 );
+
+    /* Index holds arena offsets of strings. */
+    for ( int i = 0; i < 10000; i++ ) {
+        snprintf( text, sizeof( text ), "item-%d", i );
+        off = gr_file_alloc( &arena, strlen( text ) + 1 );
+        strcpy( (char*)gr_file_ptr( arena, off ), text );
+        gr_push( &index, (gr_d)off );
+    }
+    gr_destroy( &arena );
+    gr_destroy( &index );
+
+    arena = gr_file_open( apath, 0 );
+    index = gr_file_open( ipath, 0 );
+    TEST_ASSERT_EQUAL( 10000, gr_used( index ) );
+    TEST_ASSERT_EQUAL_STRING( "item-0",
+                              gr_file_ptr( arena, (gr_size_t)gr_first( index ) ) );
+    TEST_ASSERT_EQUAL_STRING( "item-9999",
+                              gr_file_ptr( arena, (gr_size_t)gr_last( index ) ) );
+    gr_destroy( &arena );
+    gr_destroy( &index );
+
+    unlink( apath );
+    unlink( ipath );
+}
+
+
+void test_file_failure( void )
+{
+    gr_t  gr;
+    char  path[ 64 ];
+    pid_t pid;
+    int   status;
+
+    snprintf( path, sizeof( path ), "/tmp/gromer_fail_%d.grf", (int)getpid() );
+    unlink( path );
+
+    gr = gr_file_open( path, 16 );
+    while ( !gr_is_full( gr ) )
+        gr_push( &gr, (gr_d)7 );
+
+    /* Failed growth asserts, or keeps the storage. */
+    pid = fork();
+    if ( pid == 0 ) {
+        struct stat   st;
+        struct rlimit lim;
+        gr_size_t     used = gr_used( gr );
+
+        close( STDERR_FILENO );
+        signal( SIGXFSZ, SIG_IGN );
+        stat( path, &st );
+        lim.rlim_cur = lim.rlim_max = st.st_size;
+        setrlimit( RLIMIT_FSIZE, &lim );
+        gr_push( &gr, (gr_d)8 );
+        _exit( gr_used( gr ) == used && gr_last( gr ) == (gr_d)7 ? 0 : 1 );
+    }
+    waitpid( pid, &status, 0 );
+    TEST_ASSERT_FALSE( WIFEXITED( status ) && WEXITSTATUS( status ) == 1 );
+
+    gr_push( &gr, (gr_d)8 );
+    TEST_ASSERT_EQUAL( (gr_d)8, gr_last( gr ) );
+    gr_destroy( &gr );
+
+    unlink( path );
+}
@@ -0,0 +1,98 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_gap.h"
+#include <string.h>
+
+
+static int gap_compare( const gr_d a, const gr_d b )
+{
+    uintptr_t ia = *( (uintptr_t*)a );
+    uintptr_t ib = *( (uintptr_t*)b );
+    return ( ia > ib ) - ( ia < ib );
+}
+
+
+void test_gap_basics( void )
+{
+    gb_t      gb;
+    gr_t      ref;
+    gr_t      gr;
+    gr_d      item;
+    gr_size_t cnt;
+    uint32_t  seed = 1;
+
+    gb = gb_new_sized( 4 );
+    TEST_ASSERT_EQUAL( 0, gb_used( gb ) );
+    TEST_ASSERT_NULL( gb_nth( gb, 0 ) );
+    TEST_ASSERT_NULL( gb_pop( gb ) );
+    TEST_ASSERT_NULL( gb_delete_at( gb, 0 ) );
+
+    for ( uintptr_t i = 0; i < 10; i++ )
+        gb_push( gb, (gr_d)i );
+    TEST_ASSERT_EQUAL( 10, gb_cursor( gb ) );
+
+    /* Edits near cursor. */
+    gb_insert_at( gb, 5, (gr_d)100 );
+    TEST_ASSERT_EQUAL( 6, gb_cursor( gb ) );
+    gb_insert_at( gb, 6, (gr_d)101 );
+    TEST_ASSERT_EQUAL( (gr_d)5, gb_delete_at( gb, 7 ) );
+    TEST_ASSERT_EQUAL( 7, gb_cursor( gb ) );
+    TEST_ASSERT_EQUAL( 11, gb_used( gb ) );
+    TEST_ASSERT_EQUAL( (gr_d)4, gb_nth( gb, 4 ) );
+    TEST_ASSERT_EQUAL( (gr_d)100, gb_nth( gb, 5 ) );
+    TEST_ASSERT_EQUAL( (gr_d)101, gb_nth( gb, 6 ) );
+    TEST_ASSERT_EQUAL( (gr_d)6, gb_nth( gb, 7 ) );
+    TEST_ASSERT_EQUAL( (gr_d)9, gb_nth( gb, -1 ) );
+
+    gb_move( gb, 0 );
+    TEST_ASSERT_EQUAL( 0, gb_cursor( gb ) );
+    TEST_ASSERT_EQUAL( (gr_d)9, gb_pop( gb ) );
+    TEST_ASSERT_EQUAL( (gr_d)0, gb_delete_at( gb, 0 ) );
+    TEST_ASSERT_EQUAL( (gr_d)1, gb_nth( gb, 0 ) );
+
+    cnt = 0;
+    gb_each( gb, item, gr_d )
+    {
+        TEST_ASSERT_EQUAL( gb_nth( gb, cnt ), item );
+        cnt++;
+    }
+    TEST_ASSERT_EQUAL( 9, cnt );
+
+    /* Gap closes. */
+    gb_move( gb, 3 );
+    gr = gb_gromer( gb );
+    TEST_ASSERT_EQUAL( 9, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)1, gr_first( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)8, gr_last( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)100, gb_data( gb )[ 4 ] );
+
+    gb_sort( gb, gap_compare );
+    TEST_ASSERT_EQUAL( (gr_d)101, gb_nth( gb, -1 ) );
+    TEST_ASSERT_EQUAL( (gr_d)1, gb_nth( gb, 0 ) );
+    gb_destroy( &gb );
+    TEST_ASSERT_NULL( gb );
+
+    /* Random edits against plain Gromer. */
+    gb = gb_new();
+    ref = gr_new();
+    for ( uintptr_t i = 0; i < 5000; i++ ) {
+        gr_size_t pos;
+        seed = seed * 1103515245 + 12345;
+        pos = ( seed >> 8 ) % ( gr_used( ref ) + 1 );
+        if ( ( seed >> 4 ) % 4 == 0 && gr_used( ref ) > 0 ) {
+            pos = pos % gr_used( ref );
+            TEST_ASSERT_EQUAL( gr_nth( ref, pos ), gb_delete_at( gb, pos ) );
+            gr_delete_at( &ref, pos );
+        } else {
+            gb_insert_at( gb, pos, (gr_d)i );
+            gr_insert_at( &ref, pos, (gr_d)i );
+        }
+    }
+    TEST_ASSERT_EQUAL( gr_used( ref ), gb_used( gb ) );
+    for ( gr_size_t i = 0; i < gr_used( ref ); i++ )
+        TEST_ASSERT_EQUAL( gr_nth( ref, i ), gb_nth( gb, i ) );
+    TEST_ASSERT_EQUAL( 0, memcmp( gr_data( ref ), gb_data( gb ), gr_used( ref ) * sizeof( gr_d ) ) );
+
+    gr_destroy( &ref );
+    gb_destroy( &gb );
+}
@@ -0,0 +1,88 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_host.h"
+
+
+void test_host_basics( void )
+{
+    gh_t      gh;
+    gr_t      grs[ 1000 ];
+    gr_t      gr;
+    gr_size_t live;
+    gh_csr_t  csr;
+    gr_d      item;
+    gr_size_t cnt;
+
+    gh = gh_new( 0 );
+    TEST_ASSERT_EQUAL( 0, gh_blocks( gh ) );
+
+    for ( uintptr_t i = 0; i < 1000; i++ ) {
+        grs[ i ] = gh_gromer( gh, 2 );
+        TEST_ASSERT_NOT_NULL( gr_get_external( grs[ i ] ) );
+    }
+    TEST_ASSERT_EQUAL( 1, gh_blocks( gh ) );
+
+    /* Back-to-back slots. */
+    TEST_ASSERT_EQUAL( sizeof( gr_ext_s ) + gr_struct_size( 2 ),
+                       (uint8_t*)grs[ 1 ] - (uint8_t*)grs[ 0 ] );
+
+    /* Growth relocates within host. */
+    for ( uintptr_t i = 0; i < 1000; i++ ) {
+        for ( uintptr_t j = 0; j < i % 17; j++ )
+            gr_push( &grs[ i ], (gr_d)( i * 100 + j ) );
+    }
+    for ( uintptr_t i = 0; i < 1000; i++ ) {
+        TEST_ASSERT_EQUAL( i % 17, gr_used( grs[ i ] ) );
+        if ( i % 17 > 0 )
+            TEST_ASSERT_EQUAL( (gr_d)( i * 100 + i % 17 - 1 ), gr_last( grs[ i ] ) );
+    }
+    TEST_ASSERT_TRUE( gh_dead( gh ) > 0 );
+
+    /* Release some. */
+    for ( uintptr_t i = 0; i < 1000; i += 2 )
+        gr_destroy( &grs[ i ] );
+    TEST_ASSERT_NULL( grs[ 0 ] );
+
+    /* Compact. */
+    live = gh_live( gh );
+    gh_compact( gh, grs, 1000 );
+    TEST_ASSERT_EQUAL( 0, gh_dead( gh ) );
+    TEST_ASSERT_EQUAL( live, gh_live( gh ) );
+    TEST_ASSERT_EQUAL( 1, gh_blocks( gh ) );
+    for ( uintptr_t i = 1; i < 1000; i += 2 ) {
+        TEST_ASSERT_EQUAL( i % 17, gr_used( grs[ i ] ) );
+        if ( i % 17 > 0 )
+            TEST_ASSERT_EQUAL( (gr_d)( i * 100 ), gr_first( grs[ i ] ) );
+    }
+    gr_push( &grs[ 1 ], (gr_d)7 );
+    TEST_ASSERT_EQUAL( (gr_d)7, gr_nth( grs[ 1 ], 1 ) );
+
+    /* Freeze. */
+    csr = gh_freeze( grs, 1000 );
+    TEST_ASSERT_EQUAL( 1000, csr->count );
+    TEST_ASSERT_EQUAL( 0, gh_csr_used( csr, 0 ) );
+    TEST_ASSERT_EQUAL( 2, gh_csr_used( csr, 1 ) );
+    TEST_ASSERT_EQUAL( (gr_d)7, gh_csr_row( csr, 1 )[ 1 ] );
+    for ( uintptr_t i = 3; i < 1000; i += 2 ) {
+        TEST_ASSERT_EQUAL( i % 17, gh_csr_used( csr, i ) );
+        cnt = 0;
+        gh_csr_each( csr, i, item, gr_d )
+        {
+            TEST_ASSERT_EQUAL( gr_nth( grs[ i ], cnt ), item );
+            cnt++;
+        }
+        TEST_ASSERT_EQUAL( i % 17, cnt );
+    }
+    gh_csr_destroy( &csr );
+    TEST_ASSERT_NULL( csr );
+
+    /* Gromer larger than block. */
+    gr = gh_gromer( gh, 10 );
+    for ( uintptr_t i = 0; i < 100000; i++ )
+        gr_push( &gr, (gr_d)i );
+    TEST_ASSERT_EQUAL( (gr_d)99999, gr_last( gr ) );
+    TEST_ASSERT_TRUE( gh_blocks( gh ) > 1 );
+
+    gh_destroy( &gh );
+    TEST_ASSERT_NULL( gh );
+}
@@ -0,0 +1,424 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_par.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+static gr_d par_double( gr_d item, gr_d arg )
+{
+    (void)arg;
+    return (gr_d)( (uintptr_t)item * 2 );
+}
+
+
+static gr_d par_sum( gr_d acc, gr_d item, gr_d arg )
+{
+    (void)arg;
+    return (gr_d)( (uintptr_t)acc + (uintptr_t)item );
+}
+
+
+static void par_count( gr_d item, gr_d arg )
+{
+    __atomic_add_fetch( (uint64_t*)arg, (uintptr_t)item, __ATOMIC_RELAXED );
+}
+
+
+static void par_serial_exec( gr_d state, gr_task_fn_p fn, gr_d ctx, gr_size_t count )
+{
+    *(int*)state += 1;
+    for ( gr_size_t i = 0; i < count; i++ )
+        fn( ctx, i );
+}
+
+
+static gr_t par_fill( gr_size_t count )
+{
+    gr_t gr;
+
+    gr = gr_new_sized( count );
+    for ( gr_size_t i = 1; i <= count; i++ )
+        gr_push( &gr, (gr_d)i );
+
+    return gr;
+}
+
+
+void test_par_pool( void )
+{
+    gr_pool_t pool;
+    gr_t      gr;
+    gr_t      map;
+    uint64_t  sum;
+    gr_size_t cnt = 100003;
+    uint64_t  ref = cnt * ( cnt + 1 ) / 2;
+
+    gr = par_fill( cnt );
+
+    pool = gr_pool_new( 4 );
+    TEST_ASSERT_EQUAL( 4, gr_pool_threads( pool ) );
+    gr_pool_set_threshold( pool, 64 );
+
+    sum = 0;
+    gr_par_for_each( gr, pool, par_count, &sum );
+    TEST_ASSERT_EQUAL( ref, sum );
+
+    map = gr_par_map( gr, pool, par_double, NULL );
+    TEST_ASSERT_EQUAL( cnt, gr_used( map ) );
+    for ( gr_size_t i = 0; i < cnt; i++ ) {
+        TEST_ASSERT_EQUAL( 2 * ( i + 1 ), (uintptr_t)gr_nth( map, i ) );
+    }
+    gr_destroy( &map );
+
+    TEST_ASSERT_EQUAL( ref, (uintptr_t)gr_par_reduce( gr, pool, par_sum, NULL, NULL, 0 ) );
+    TEST_ASSERT_EQUAL( ref, (uintptr_t)gr_par_reduce( gr, pool, par_sum, NULL, NULL, 1 ) );
+
+    /* Serial fallback. */
+    gr_pool_set_threshold( pool, 2 * cnt );
+    TEST_ASSERT_EQUAL( ref, (uintptr_t)gr_par_reduce( gr, pool, par_sum, NULL, NULL, 0 ) );
+    map = gr_par_map( gr, pool, par_double, NULL );
+    TEST_ASSERT_EQUAL( 2 * cnt, (uintptr_t)gr_last( map ) );
+    gr_destroy( &map );
+    sum = 0;
+    gr_par_for_each( gr, pool, par_count, &sum );
+    TEST_ASSERT_EQUAL( ref, sum );
+
+    gr_pool_destroy( &pool );
+    TEST_ASSERT_NULL( pool );
+
+    /* Default pool. */
+    TEST_ASSERT_EQUAL( ref, (uintptr_t)gr_par_reduce( gr, NULL, par_sum, NULL, NULL, 1 ) );
+
+    gr_destroy( &gr );
+}
+
+
+void test_par_executor( void )
+{
+    gr_pool_t pool;
+    gr_t      gr;
+    gr_t      map;
+    int       calls = 0;
+    gr_size_t cnt = 1000;
+
+    gr = par_fill( cnt );
+
+    pool = gr_pool_use( par_serial_exec, &calls, 2 );
+    gr_pool_set_threshold( pool, 10 );
+
+    map = gr_par_map( gr, pool, par_double, NULL );
+    TEST_ASSERT_EQUAL( 1, calls );
+    TEST_ASSERT_EQUAL( cnt, gr_used( map ) );
+    TEST_ASSERT_EQUAL( 2, (uintptr_t)gr_first( map ) );
+    TEST_ASSERT_EQUAL( 2 * cnt, (uintptr_t)gr_last( map ) );
+
+    TEST_ASSERT_EQUAL( cnt * ( cnt + 1 ) / 2,
+                       (uintptr_t)gr_par_reduce( gr, pool, par_sum, NULL, NULL, 0 ) );
+    TEST_ASSERT_EQUAL( 2, calls );
+
+    gr_destroy( &map );
+    gr_pool_destroy( &pool );
+    gr_destroy( &gr );
+}
+
+
+typedef struct
+{
+    gr_pool_t pool;
+    gr_t      gr;
+    uintptr_t res[ 8 ];
+} par_nest_t;
+
+
+static void par_nest_task( gr_d ctx, gr_size_t idx )
+{
+    par_nest_t* nest = (par_nest_t*)ctx;
+
+    nest->res[ idx ] = (uintptr_t)gr_par_reduce( nest->gr, nest->pool, par_sum, NULL, NULL, idx & 1 );
+}
+
+
+void test_par_nested( void )
+{
+    par_nest_t nest;
+    gr_size_t  cnt = 1000;
+
+    nest.pool = gr_pool_new( 4 );
+    gr_pool_set_threshold( nest.pool, 64 );
+    nest.gr = par_fill( cnt );
+
+    /* Tasks run algorithms with the same pool. */
+    gr_pool_run( nest.pool, par_nest_task, &nest, 8 );
+    for ( int i = 0; i < 8; i++ ) {
+        TEST_ASSERT_EQUAL( cnt * ( cnt + 1 ) / 2, nest.res[ i ] );
+    }
+
+    gr_destroy( &nest.gr );
+    gr_pool_destroy( &nest.pool );
+}
+
+
+static gr_d par_fsum( gr_d acc, gr_d item, gr_d arg )
+{
+    double a, b;
+
+    (void)arg;
+    memcpy( &a, &acc, sizeof( a ) );
+    memcpy( &b, &item, sizeof( b ) );
+    a += b;
+    memcpy( &acc, &a, sizeof( a ) );
+
+    return acc;
+}
+
+
+void test_par_deterministic( void )
+{
+    gr_pool_t pool;
+    gr_t      grs[ 2 ];
+    gr_d      res[ 3 ];
+    uint8_t*  mem;
+    gr_size_t cnt = 100000;
+    double    val;
+
+    /* Same items in storages of different cache line offset. */
+    mem = (uint8_t*)gr_malloc( gr_struct_size( cnt ) + GR_CACHE_LINE + 24 );
+    grs[ 0 ] = gr_new_sized( cnt );
+    grs[ 1 ] = gr_use( mem + 24 - ( (uintptr_t)mem % GR_CACHE_LINE ) + GR_CACHE_LINE,
+                       gr_struct_size( cnt ) );
+    TEST_ASSERT_TRUE( (uintptr_t)grs[ 0 ]->data % GR_CACHE_LINE
+                      != (uintptr_t)grs[ 1 ]->data % GR_CACHE_LINE );
+
+    for ( gr_size_t i = 0; i < cnt; i++ ) {
+        gr_d item;
+        val = ( i % 3 == 0 ) ? 1e16 * ( ( i & 1 ) ? -1.0 : 1.0 ) : 0.1 * i;
+        memcpy( &item, &val, sizeof( val ) );
+        gr_push( &grs[ 0 ], item );
+        gr_push( &grs[ 1 ], item );
+    }
+
+    pool = gr_pool_new( 4 );
+    gr_pool_set_threshold( pool, 64 );
+    res[ 0 ] = gr_par_reduce( grs[ 0 ], pool, par_fsum, NULL, NULL, 1 );
+    res[ 1 ] = gr_par_reduce( grs[ 1 ], pool, par_fsum, NULL, NULL, 1 );
+    TEST_ASSERT_EQUAL_PTR( res[ 0 ], res[ 1 ] );
+
+    /* Serial reduction gives the same result. */
+    gr_pool_set_threshold( pool, 2 * cnt );
+    res[ 2 ] = gr_par_reduce( grs[ 1 ], pool, par_fsum, NULL, NULL, 1 );
+    TEST_ASSERT_EQUAL_PTR( res[ 0 ], res[ 2 ] );
+
+    gr_pool_destroy( &pool );
+    gr_destroy( &grs[ 0 ] );
+    gr_free( mem );
+}
+
+
+static int par_compare( const gr_d a, const gr_d b )
+{
+    return ( (uintptr_t)a > (uintptr_t)b ) - ( (uintptr_t)a < (uintptr_t)b );
+}
+
+
+void test_par_merge( void )
+{
+    gr_pool_t pool;
+    gr_t      grs[ 7 ];
+    gr_t      ref;
+    gr_t      gr;
+
+    for ( uintptr_t i = 0; i < 7; i++ ) {
+        grs[ i ] = gr_new();
+        for ( uintptr_t v = i; v < 20000; v += i + 1 )
+            gr_push( &grs[ i ], (gr_d)v );
+    }
+
+    pool = gr_pool_new( 4 );
+    gr_pool_set_threshold( pool, 100 );
+
+    for ( int dedup = 0; dedup < 2; dedup++ ) {
+        ref = gr_merge( grs, 7, par_compare, dedup );
+        gr = gr_par_merge( grs, 7, pool, par_compare, dedup );
+        TEST_ASSERT_EQUAL( gr_used( ref ), gr_used( gr ) );
+        for ( gr_size_t i = 0; i < gr_used( ref ); i++ ) {
+            TEST_ASSERT_EQUAL_PTR( gr_nth( ref, i ), gr_nth( gr, i ) );
+        }
+        TEST_ASSERT_EQUAL( GR_UNINIT, gr_get_uninit( gr ) );
+        if ( !GR_UNINIT ) {
+            for ( gr_size_t i = gr_used( gr ); i < gr_size( gr ); i++ )
+                TEST_ASSERT_NULL( gr_data( gr )[ i ] );
+        }
+        gr_destroy( &ref );
+        gr_destroy( &gr );
+    }
+
+    /* Serial fallback. */
+    gr = gr_par_merge( grs, 2, NULL, par_compare, 1 );
+    TEST_ASSERT_EQUAL( 20000, gr_used( gr ) );
+    gr_destroy( &gr );
+
+    gr_pool_destroy( &pool );
+    for ( int i = 0; i < 7; i++ )
+        gr_destroy( &grs[ i ] );
+}
+
+
+/* Return numa_maps line of the mapping that contains "addr". */
+static int par_numa_maps( gr_d addr, char* line, int len )
+{
+    FILE*     fh;
+    char      buf[ 1024 ];
+    uintptr_t best = 0;
+    uintptr_t start;
+
+    fh = fopen( "/proc/self/numa_maps", "r" );
+    if ( fh == NULL )
+        return 0;
+
+    while ( fgets( buf, sizeof( buf ), fh ) ) {
+        start = strtoull( buf, NULL, 16 );
+        if ( start <= (uintptr_t)addr && start >= best ) {
+            best = start;
+            snprintf( line, len, "%s", buf );
+        }
+    }
+    fclose( fh );
+
+    return best != 0;
+}
+
+
+/* Return node of the CPU that runs the caller. */
+static int par_cpu_node( void )
+{
+    unsigned cpu = 0;
+    unsigned node = 0;
+
+    syscall( SYS_getcpu, &cpu, &node, NULL );
+
+    return node;
+}
+
+
+typedef struct
+{
+    pthread_t thread[ 8 ];
+} par_map_t;
+
+
+static void par_thread_task( gr_d ctx, gr_size_t idx )
+{
+    ( (par_map_t*)ctx )->thread[ idx ] = pthread_self();
+}
+
+
+static gr_size_t par_pages;
+
+
+static void par_observer( int kind, gr_size_t bytes, int moved, uint64_t ns )
+{
+    (void)moved;
+    (void)ns;
+    if ( kind == GR_ALLOC_PAGES )
+        par_pages += bytes;
+}
+
+
+void test_par_affinity( void )
+{
+    gr_pool_t pool;
+    par_map_t a;
+    par_map_t b;
+    gr_t      gr;
+
+    pool = gr_pool_new( 4 );
+
+    /* Task "i" runs on thread "i", and caller is thread 0. */
+    gr_pool_run( pool, par_thread_task, &a, 4 );
+    gr_pool_run( pool, par_thread_task, &b, 4 );
+    TEST_ASSERT_TRUE( pthread_equal( a.thread[ 0 ], pthread_self() ) );
+    for ( int i = 0; i < 4; i++ ) {
+        TEST_ASSERT_TRUE( pthread_equal( a.thread[ i ], b.thread[ i ] ) );
+        for ( int j = 0; j < i; j++ )
+            TEST_ASSERT_FALSE( pthread_equal( a.thread[ i ], a.thread[ j ] ) );
+    }
+
+    /* Tasks are assigned in blocks. */
+    gr_pool_run( pool, par_thread_task, &b, 8 );
+    for ( int i = 0; i < 8; i++ )
+        TEST_ASSERT_TRUE( pthread_equal( a.thread[ i / 2 ], b.thread[ i ] ) );
+
+    /* Allocation is observed. */
+    par_pages = 0;
+    gr_set_observer( par_observer );
+    gr = gr_new_numa( 1 << 12, pool, GR_NUMA_DEFAULT, 0 );
+    gr_set_observer( NULL );
+    TEST_ASSERT_EQUAL( gr_total_size( gr ), par_pages );
+    gr_destroy( &gr );
+
+    gr_pool_destroy( &pool );
+}
+
+
+void test_par_numa( void )
+{
+    gr_pool_t pool;
+    gr_t      gr;
+    gr_size_t page = gr_alloc_pages( 0, NULL );
+    int       nodes = gr_numa_nodes();
+    int       policies[] = { GR_NUMA_DEFAULT, GR_NUMA_INTERLEAVE, GR_NUMA_NODE };
+    char      line[ 1024 ];
+
+    TEST_ASSERT_TRUE( nodes >= 1 );
+
+    pool = gr_pool_new( 4 );
+    gr_pool_set_threshold( pool, 64 );
+
+    for ( int p = 0; p < 3; p++ ) {
+        gr = gr_new_numa( 1 << 16, pool, policies[ p ], 0 );
+        TEST_ASSERT_EQUAL( 0, (uintptr_t)gr % page );
+        TEST_ASSERT_EQUAL( 0, gr_used( gr ) );
+        TEST_ASSERT_TRUE( gr_size( gr ) >= ( 1 << 16 ) );
+        TEST_ASSERT_EQUAL( 0, ( gr_total_size( gr ) % page ) );
+
+        /* All pages are touched and placed to online nodes. */
+        int seen = 0;
+        for ( gr_size_t off = 0; off < gr_total_size( gr ); off += page ) {
+            int node = gr_numa_node_of( (uint8_t*)gr + off );
+            TEST_ASSERT_TRUE( node >= 0 );
+            seen |= 1 << node;
+            if ( policies[ p ] == GR_NUMA_NODE || nodes == 1 ) {
+                TEST_ASSERT_EQUAL( 0, node );
+            }
+        }
+        if ( policies[ p ] == GR_NUMA_INTERLEAVE && nodes > 1 ) {
+            TEST_ASSERT_TRUE( seen & ~1 );
+            TEST_ASSERT_TRUE( par_numa_maps( gr, line, sizeof( line ) ) );
+            TEST_ASSERT_NOT_NULL( strstr( line, "interleave" ) );
+        } else if ( ( policies[ p ] == GR_NUMA_NODE || nodes == 1 )
+                    && par_numa_maps( gr, line, sizeof( line ) ) ) {
+            TEST_ASSERT_NOT_NULL( strstr( line, "N0=" ) );
+        }
+
+        for ( uintptr_t i = 1; i <= 1000; i++ )
+            gr_push( &gr, (gr_d)i );
+        TEST_ASSERT_EQUAL( 1000, (uintptr_t)gr_last( gr ) );
+        gr_destroy( &gr );
+    }
+
+    /* Serial touch, i.e. on the node of the caller (which may
+     * migrate in between). */
+    int before = par_cpu_node();
+    gr = gr_new_numa( 10, NULL, GR_NUMA_DEFAULT, 0 );
+    int after = par_cpu_node();
+    int node = gr_numa_node_of( gr );
+    TEST_ASSERT_TRUE( node == before || node == after );
+    TEST_ASSERT_NULL( gr_first( gr ) );
+    gr_destroy( &gr );
+
+    gr_pool_destroy( &pool );
+}
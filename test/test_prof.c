@@ -0,0 +1,105 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_host.h"
+#include "gromer_prof.h"
+#include <stdio.h>
+#include <string.h>
+
+
+void test_prof_basics( void )
+{
+    gr_prof_stat_t st;
+    gr_t           gr;
+    gr_t           pg;
+    gr_t           cp;
+    char           buf[ 4096 ];
+    FILE*          fh;
+    const char*    old;
+    char           tag[ 16 ];
+
+    gr_prof_reset();
+
+    /* Nothing recorded before start. */
+    gr = gr_new();
+    gr_destroy( &gr );
+    TEST_ASSERT_FALSE( gr_prof_get( NULL, GR_ALLOC_NEW, &st ) );
+    TEST_ASSERT_EQUAL( 0, st.count );
+
+    gr_prof_start();
+
+    old = gr_prof_tag( "grow" );
+    TEST_ASSERT_NULL( old );
+    gr = gr_new_sized( 16 );
+    for ( uintptr_t i = 0; i < 1000; i++ )
+        gr_push( &gr, (gr_d)i );
+    pg = gr_new_page( 2 );
+    cp = gr_duplicate_cow( gr );
+    gr_push( &cp, (gr_d)1 );
+    TEST_ASSERT_EQUAL_STRING( "grow", gr_prof_tag( NULL ) );
+
+    gr_destroy( &cp );
+    cp = gr_new_sized( 100 );
+    gr_destroy( &cp );
+
+    gr_prof_stop();
+    gr_destroy( &gr );
+    gr_destroy( &pg );
+
+    /* Tag is compared as string. */
+    strcpy( tag, "grow" );
+    TEST_ASSERT_TRUE( gr_prof_get( tag, GR_ALLOC_NEW, &st ) );
+    TEST_ASSERT_EQUAL( 1, st.count );
+    TEST_ASSERT_EQUAL( gr_struct_size( 16 ), st.bytes );
+    TEST_ASSERT_EQUAL( 1, st.hist[ 63 - __builtin_clzll( gr_struct_size( 16 ) ) ] );
+
+    TEST_ASSERT_TRUE( gr_prof_get( "grow", GR_ALLOC_RESIZE, &st ) );
+    TEST_ASSERT_TRUE( st.count >= 6 );
+    TEST_ASSERT_EQUAL( st.count, st.in_place + st.moved );
+    TEST_ASSERT_TRUE( st.moved >= 1 );
+    TEST_ASSERT_TRUE( st.bytes > 8000 );
+
+    TEST_ASSERT_TRUE( gr_prof_get( "grow", GR_ALLOC_PAGES, &st ) );
+    TEST_ASSERT_EQUAL( 1, st.count );
+    TEST_ASSERT_EQUAL( 2 * gr_alloc_pages( 0, NULL ), st.bytes );
+
+    TEST_ASSERT_TRUE( gr_prof_get( NULL, GR_ALLOC_NEW, &st ) );
+    TEST_ASSERT_EQUAL( 1, st.count );
+    TEST_ASSERT_FALSE( gr_prof_get( "other", GR_ALLOC_NEW, &st ) );
+
+    fh = fmemopen( buf, sizeof( buf ), "w" );
+    gr_prof_dump( fh );
+    fclose( fh );
+    TEST_ASSERT_NOT_NULL( strstr( buf, "grow new: count 1" ) );
+    TEST_ASSERT_NOT_NULL( strstr( buf, "grow resize:" ) );
+    TEST_ASSERT_NOT_NULL( strstr( buf, "- new: count 1" ) );
+
+    gr_prof_reset();
+    TEST_ASSERT_FALSE( gr_prof_get( "grow", GR_ALLOC_NEW, &st ) );
+}
+
+
+void test_prof_external( void )
+{
+    gr_prof_stat_t st;
+    gh_t           gh;
+    gr_t           gr;
+
+    gr_prof_reset();
+    gh = gh_new( 0 );
+    gr = gh_gromer( gh, 2 );
+
+    /* Resize of host Gromer is reported (and moves). */
+    gr_prof_start();
+    gr_prof_tag( "host" );
+    for ( uintptr_t i = 0; i < 100; i++ )
+        gr_push( &gr, (gr_d)i );
+    gr_prof_tag( NULL );
+    gr_prof_stop();
+
+    TEST_ASSERT_TRUE( gr_prof_get( "host", GR_ALLOC_RESIZE, &st ) );
+    TEST_ASSERT_TRUE( st.count >= 1 );
+    TEST_ASSERT_EQUAL( st.count, st.moved );
+
+    gh_destroy( &gh );
+    gr_prof_reset();
+}
@@ -0,0 +1,135 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_rcu.h"
+#include <pthread.h>
+
+
+#define RCU_READERS 4
+#define RCU_ITEMS   200000
+
+
+typedef struct
+{
+    gc_t      gc;
+    int       stop;
+    gr_size_t reads;
+    int       errors;
+} rcu_state_t;
+
+
+static void* rcu_reader( void* arg )
+{
+    rcu_state_t* st = (rcu_state_t*)arg;
+    gr_pos_t     id;
+    gr_t         gr;
+    uintptr_t    item;
+    gr_size_t    last = 0;
+    gr_size_t    reads = 0;
+
+    id = gc_register( st->gc );
+    if ( id == GR_NOT_INDEX ) {
+        __atomic_add_fetch( &st->errors, 1, __ATOMIC_RELAXED );
+        return NULL;
+    }
+
+    do {
+        gr = gc_enter( st->gc, id );
+
+        /* Usage grows monotonically and items are their positions. */
+        if ( gc_used( gr ) < last )
+            __atomic_add_fetch( &st->errors, 1, __ATOMIC_RELAXED );
+        last = gc_used( gr );
+
+        gc_each( gr, item, uintptr_t )
+        {
+            if ( item != gr_idx + 1 )
+                __atomic_add_fetch( &st->errors, 1, __ATOMIC_RELAXED );
+        }
+
+        gc_leave( st->gc, id );
+        reads++;
+    } while ( !__atomic_load_n( &st->stop, __ATOMIC_ACQUIRE ) );
+
+    gc_unregister( st->gc, id );
+    __atomic_add_fetch( &st->reads, reads, __ATOMIC_RELAXED );
+
+    return NULL;
+}
+
+
+void test_rcu_basics( void )
+{
+    gc_t     gc;
+    gr_t     gr;
+    gr_t     old;
+    gr_pos_t id;
+
+    gc = gc_new_sized( 4 );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)&gc->slot[ 0 ] % GR_CACHE_LINE );
+    TEST_ASSERT_TRUE( (uint8_t*)&gc->slot[ 0 ] - (uint8_t*)gc >= GR_CACHE_LINE );
+    id = gc_register( gc );
+    TEST_ASSERT_EQUAL( 0, id );
+
+    for ( uintptr_t i = 1; i <= 4; i++ )
+        gc_push( gc, (gr_d)i );
+
+    /* Snapshot survives growth while reader is inside. */
+    old = gc_enter( gc, id );
+    gc_push( gc, (gr_d)5 );
+    gr = gc_gromer( gc );
+    TEST_ASSERT_TRUE( gr != old );
+    TEST_ASSERT_EQUAL( 4, gc_used( old ) );
+    TEST_ASSERT_EQUAL( (gr_d)4, gc_nth( old, 3 ) );
+    TEST_ASSERT_EQUAL( 5, gc_used( gr ) );
+    TEST_ASSERT_EQUAL( 1, gc_reclaim( gc ) );
+    gc_leave( gc, id );
+    TEST_ASSERT_EQUAL( 0, gc_reclaim( gc ) );
+
+    TEST_ASSERT_EQUAL( (gr_d)3, gc_swap( gc, 2, (gr_d)30 ) );
+    gr = gc_enter( gc, id );
+    TEST_ASSERT_EQUAL( (gr_d)30, gc_nth( gr, 2 ) );
+    gc_leave( gc, id );
+
+    TEST_ASSERT_EQUAL( (gr_d)5, gc_pop( gc ) );
+    TEST_ASSERT_EQUAL( 4, gr_used( gc_gromer( gc ) ) );
+    while ( gc_pop( gc ) )
+        ;
+    TEST_ASSERT_NULL( gc_pop( gc ) );
+
+    /* All slots taken. */
+    for ( int i = 1; i < GC_MAX_READERS; i++ ) {
+        TEST_ASSERT_EQUAL( i, gc_register( gc ) );
+    }
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, gc_register( gc ) );
+    gc_unregister( gc, 7 );
+    TEST_ASSERT_EQUAL( 7, gc_register( gc ) );
+
+    gc_destroy( &gc );
+    TEST_ASSERT_NULL( gc );
+}
+
+
+void test_rcu_stress( void )
+{
+    rcu_state_t st = { 0 };
+    pthread_t   th[ RCU_READERS ];
+
+    st.gc = gc_new_sized( 2 );
+
+    for ( int i = 0; i < RCU_READERS; i++ )
+        pthread_create( &th[ i ], NULL, rcu_reader, &st );
+
+    for ( uintptr_t i = 1; i <= RCU_ITEMS; i++ )
+        gc_push( st.gc, (gr_d)i );
+
+    __atomic_store_n( &st.stop, 1, __ATOMIC_RELEASE );
+    for ( int i = 0; i < RCU_READERS; i++ )
+        pthread_join( th[ i ], NULL );
+
+    TEST_ASSERT_EQUAL( 0, st.errors );
+    TEST_ASSERT_TRUE( st.reads >= RCU_READERS );
+    TEST_ASSERT_EQUAL( RCU_ITEMS, gr_used( gc_gromer( st.gc ) ) );
+    TEST_ASSERT_EQUAL( 0, gc_reclaim( st.gc ) );
+
+    gc_destroy( &st.gc );
+}
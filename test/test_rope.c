@@ -0,0 +1,152 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_rope.h"
+
+
+/* Check rope against flat Gromer, including leaf links and totals. */
+static void rope_check( gk_t gk, gr_t ref )
+{
+    gr_size_t cnt = 0;
+    gr_d      item;
+
+    TEST_ASSERT_EQUAL( gr_used( ref ), gk_used( gk ) );
+    gk_each( gk, item, gr_d )
+    {
+        TEST_ASSERT_EQUAL( gr_nth( ref, cnt ), item );
+        cnt++;
+    }
+    TEST_ASSERT_EQUAL( gr_used( ref ), cnt );
+
+    for ( gr_size_t i = 0; i < gr_used( ref ); i += 7 )
+        TEST_ASSERT_EQUAL( gr_nth( ref, i ), gk_nth( gk, i ) );
+}
+
+
+void test_rope_basics( void )
+{
+    gk_t     gk;
+    gr_t     ref;
+    uint32_t seed = 1;
+
+    gk = gk_new();
+    TEST_ASSERT_EQUAL( 0, gk_used( gk ) );
+    TEST_ASSERT_EQUAL( 1, gk_depth( gk ) );
+    TEST_ASSERT_NULL( gk_first( gk ) );
+    TEST_ASSERT_NULL( gk_nth( gk, 0 ) );
+    TEST_ASSERT_NULL( gk_pop( gk ) );
+
+    for ( uintptr_t i = 0; i < 100000; i++ )
+        gk_push( gk, (gr_d)i );
+    TEST_ASSERT_EQUAL( 100000, gk_used( gk ) );
+    TEST_ASSERT_TRUE( gk_depth( gk ) <= 4 );
+    TEST_ASSERT_EQUAL( (gr_d)54321, gk_nth( gk, 54321 ) );
+    TEST_ASSERT_EQUAL( (gr_d)99999, gk_nth( gk, -1 ) );
+
+    /* Leaves are contiguous arrays. */
+    gr_size_t leaves = 0;
+    gk_each_leaf( gk, leaf )
+    {
+        TEST_ASSERT_TRUE( gr_used( leaf->gr ) <= GK_LEAF );
+        leaves++;
+    }
+    TEST_ASSERT_TRUE( leaves >= 100000 / GK_LEAF );
+
+    TEST_ASSERT_EQUAL( (gr_d)99999, gk_pop( gk ) );
+    TEST_ASSERT_EQUAL( (gr_d)0, gk_delete_at( gk, 0 ) );
+    gk_destroy( &gk );
+    TEST_ASSERT_NULL( gk );
+
+    /* Random edits against plain Gromer. */
+    gk = gk_new();
+    ref = gr_new();
+    for ( uintptr_t i = 0; i < 60000; i++ ) {
+        gr_size_t pos;
+        seed = seed * 1103515245 + 12345;
+        pos = ( seed >> 8 ) % ( gr_used( ref ) + 1 );
+        if ( ( ( seed >> 4 ) % 5 < 2 || i > 40000 ) && gr_used( ref ) > 0 ) {
+            pos = pos % gr_used( ref );
+            TEST_ASSERT_EQUAL( gr_nth( ref, pos ), gk_delete_at( gk, pos ) );
+            gr_delete_at( &ref, pos );
+        } else {
+            gk_insert_at( gk, pos, (gr_d)i );
+            gr_insert_at( &ref, pos, (gr_d)i );
+        }
+        if ( i % 10000 == 0 )
+            rope_check( gk, ref );
+    }
+    rope_check( gk, ref );
+
+    gr_destroy( &ref );
+    gk_destroy( &gk );
+}
+
+
+void test_rope_split_concat( void )
+{
+    gk_t     gk;
+    gk_t     tail;
+    gk_t     small;
+    gr_t     ref;
+    uint32_t seed = 7;
+
+    gk = gk_new();
+    ref = gr_new();
+    for ( uintptr_t i = 0; i < 50000; i++ ) {
+        gk_push( gk, (gr_d)i );
+        gr_push( &ref, (gr_d)i );
+    }
+
+    /* Split and concat back at random positions. */
+    for ( int round = 0; round < 50; round++ ) {
+        gr_size_t pos;
+        seed = seed * 1103515245 + 12345;
+        pos = ( seed >> 8 ) % ( gk_used( gk ) + 1 );
+
+        tail = gk_split( gk, pos );
+        TEST_ASSERT_EQUAL( pos, gk_used( gk ) );
+        TEST_ASSERT_EQUAL( gr_used( ref ) - pos, gk_used( tail ) );
+        if ( pos < gr_used( ref ) ) {
+            TEST_ASSERT_EQUAL( gr_nth( ref, pos ), gk_nth( tail, 0 ) );
+        }
+
+        /* Edit both parts. */
+        gk_push( gk, (gr_d)1000000 );
+        gr_insert_at( &ref, pos, (gr_d)1000000 );
+        gk_insert_at( tail, 0, (gr_d)2000000 );
+        gr_insert_at( &ref, pos + 1, (gr_d)2000000 );
+
+        gk_concat( gk, &tail );
+        TEST_ASSERT_NULL( tail );
+        rope_check( gk, ref );
+    }
+
+    /* Concat ropes of different depth, both ways. */
+    small = gk_new();
+    for ( uintptr_t i = 0; i < 10; i++ )
+        gk_push( small, (gr_d)i );
+    gk_concat( small, &gk );
+    for ( uintptr_t i = 0; i < 10; i++ )
+        gr_insert_at( &ref, i, (gr_d)i );
+    rope_check( small, ref );
+
+    tail = gk_split( small, -5 );
+    TEST_ASSERT_EQUAL( 5, gk_used( tail ) );
+    gk_concat( tail, &small );
+    gk_concat( small = gk_new(), &tail );
+    TEST_ASSERT_EQUAL( gr_used( ref ), gk_used( small ) );
+    /* Rotated by 5. */
+    TEST_ASSERT_EQUAL( gr_last( ref ), gk_nth( small, 4 ) );
+    TEST_ASSERT_EQUAL( (gr_d)0, gk_nth( small, 5 ) );
+
+    /* Empty parts. */
+    tail = gk_split( small, 0 );
+    TEST_ASSERT_EQUAL( 0, gk_used( small ) );
+    gk_concat( tail, &small );
+    small = gk_split( tail, gk_used( tail ) );
+    TEST_ASSERT_EQUAL( 0, gk_used( small ) );
+    gk_concat( tail, &small );
+    TEST_ASSERT_EQUAL( gr_used( ref ), gk_used( tail ) );
+
+    gr_destroy( &ref );
+    gk_destroy( &tail );
+}
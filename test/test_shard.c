@@ -0,0 +1,114 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_shard.h"
+#include <pthread.h>
+
+
+#define SHARD_THREADS 4
+#define SHARD_ITEMS   50000
+
+
+typedef struct
+{
+    gs_t      gs;
+    gr_size_t idx;
+} shard_arg_t;
+
+
+static void* shard_pusher( void* arg )
+{
+    shard_arg_t* sa = (shard_arg_t*)arg;
+
+    for ( uintptr_t i = 1; i <= SHARD_ITEMS; i++ )
+        gs_push( sa->gs, sa->idx, (gr_d)( sa->idx * SHARD_ITEMS + i ) );
+
+    return NULL;
+}
+
+
+void test_shard_basics( void )
+{
+    gs_t gs;
+    gr_t gr;
+
+    gs = gs_new( 0 );
+    TEST_ASSERT_TRUE( gs_count( gs ) >= 1 );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)&gs->shard[ 0 ] % GR_CACHE_LINE );
+    TEST_ASSERT_EQUAL( GR_CACHE_LINE, sizeof( gs_shard_t ) );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gs_shard( gs, 0 ) % GR_CACHE_LINE );
+    gs_destroy( &gs );
+    TEST_ASSERT_NULL( gs );
+
+    gs = gs_new_sized( 3, 2 );
+    gs_push( gs, 2, (gr_d)5 );
+    gs_push( gs, 0, (gr_d)1 );
+    gs_push( gs, 0, (gr_d)2 );
+    gs_push( gs, 2, (gr_d)6 );
+    gs_push( gs, 1, (gr_d)3 );
+    TEST_ASSERT_EQUAL( 5, gs_used( gs ) );
+    TEST_ASSERT_EQUAL( 2, gr_used( gs_shard( gs, 2 ) ) );
+
+    /* Shard storage stays line aligned when it grows. */
+    for ( uintptr_t i = 0; i < 100; i++ )
+        gs_push( gs, 1, (gr_d)( i + 10 ) );
+    TEST_ASSERT_EQUAL( 0, (uintptr_t)gs_shard( gs, 1 ) % GR_CACHE_LINE );
+    TEST_ASSERT_EQUAL( (gr_d)109, gs_pop( gs, 1 ) );
+    while ( gr_used( gs_shard( gs, 1 ) ) > 1 )
+        gs_pop( gs, 1 );
+
+    gr = gs_merge( gs );
+    TEST_ASSERT_EQUAL( 5, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)1, gr_nth( gr, 0 ) );
+    TEST_ASSERT_EQUAL( (gr_d)3, gr_nth( gr, 2 ) );
+    TEST_ASSERT_EQUAL( (gr_d)6, gr_nth( gr, 4 ) );
+    TEST_ASSERT_EQUAL( 5, gs_used( gs ) );
+
+    /* Per shard draining. */
+    TEST_ASSERT_EQUAL( (gr_d)6, gs_pop( gs, 2 ) );
+    TEST_ASSERT_EQUAL( (gr_d)3, gs_pop( gs, 1 ) );
+    TEST_ASSERT_NULL( gs_pop( gs, 1 ) );
+
+    /* Drain appends to existing Gromer. */
+    TEST_ASSERT_EQUAL( 3, gs_drain( gs, &gr ) );
+    TEST_ASSERT_EQUAL( 8, gr_used( gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)5, gr_last( gr ) );
+    TEST_ASSERT_EQUAL( 0, gs_used( gs ) );
+    TEST_ASSERT_EQUAL( 0, gs_drain( gs, &gr ) );
+    TEST_ASSERT_EQUAL( 8, gr_used( gr ) );
+    gr_destroy( &gr );
+
+    gs_push( gs, 1, (gr_d)7 );
+    TEST_ASSERT_EQUAL( 1, gs_drain( gs, &gr ) );
+    TEST_ASSERT_EQUAL( (gr_d)7, gr_first( gr ) );
+    gr_destroy( &gr );
+
+    gs_destroy( &gs );
+}
+
+
+void test_shard_threads( void )
+{
+    gs_t        gs;
+    gr_t        gr = NULL;
+    pthread_t   th[ SHARD_THREADS ];
+    shard_arg_t sa[ SHARD_THREADS ];
+
+    gs = gs_new( SHARD_THREADS );
+
+    for ( int i = 0; i < SHARD_THREADS; i++ ) {
+        sa[ i ].gs = gs;
+        sa[ i ].idx = i;
+        pthread_create( &th[ i ], NULL, shard_pusher, &sa[ i ] );
+    }
+    for ( int i = 0; i < SHARD_THREADS; i++ )
+        pthread_join( th[ i ], NULL );
+
+    TEST_ASSERT_EQUAL( SHARD_THREADS * SHARD_ITEMS, gs_drain( gs, &gr ) );
+    TEST_ASSERT_EQUAL( SHARD_THREADS * SHARD_ITEMS, gr_used( gr ) );
+    for ( gr_size_t i = 0; i < gr_used( gr ); i++ ) {
+        TEST_ASSERT_EQUAL( i + 1, (uintptr_t)gr_nth( gr, i ) );
+    }
+
+    gr_destroy( &gr );
+    gs_destroy( &gs );
+}
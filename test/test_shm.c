@@ -0,0 +1,158 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_shm.h"
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+void test_shm_basics( void )
+{
+    gr_shm_t  shm;
+    gr_shm_t  other;
+    gr_t      gr = NULL;
+    gr_size_t off;
+    char      name[ 64 ];
+    pid_t     pid;
+    int       status;
+
+    snprintf( name, sizeof( name ), "/gromer_shm_%d", (int)getpid() );
+    gr_shm_unlink( name );
+
+    shm = gr_shm_open( name, 100, 1000 );
+    TEST_ASSERT_NOT_NULL( shm );
+    TEST_ASSERT_EQUAL( 100, gr_shm_size( shm ) );
+    TEST_ASSERT_EQUAL( 0, gr_shm_used( shm ) );
+    TEST_ASSERT_NULL( gr_shm_pop( shm ) );
+
+    /* Items are arena offsets (non-zero). */
+    for ( int i = 0; i < 10; i++ ) {
+        off = gr_shm_alloc( shm, 8 );
+        TEST_ASSERT_TRUE( off > 0 );
+        strcpy( gr_shm_ptr( shm, off ), "str-0" );
+        ( (char*)gr_shm_ptr( shm, off ) )[ 4 ] += i;
+        TEST_ASSERT_EQUAL( 0, gr_shm_push( shm, (gr_d)off ) );
+    }
+    TEST_ASSERT_EQUAL( 10, gr_shm_used( shm ) );
+
+    /* Second mapping of the same segment. */
+    other = gr_shm_open( name, 0, 0 );
+    TEST_ASSERT_NOT_NULL( other );
+    TEST_ASSERT_TRUE( other != shm );
+    TEST_ASSERT_EQUAL( 10, gr_shm_used( other ) );
+    off = (gr_size_t)gr_shm_pop( other );
+    TEST_ASSERT_EQUAL_STRING( "str-9", gr_shm_ptr( other, off ) );
+    TEST_ASSERT_EQUAL( 2, gr_shm_pop_into( other, &gr, 2 ) );
+    TEST_ASSERT_EQUAL_STRING( "str-7", gr_shm_ptr( shm, (gr_size_t)gr_first( gr ) ) );
+    TEST_ASSERT_EQUAL_STRING( "str-8", gr_shm_ptr( shm, (gr_size_t)gr_last( gr ) ) );
+    TEST_ASSERT_EQUAL( 7, gr_shm_used( shm ) );
+    gr_destroy( &gr );
+
+    gr_shm_lock( other );
+    TEST_ASSERT_EQUAL( 7, gr_used( gr_shm_gromer( other ) ) );
+    gr_shm_unlock( other );
+    gr_shm_close( &other );
+    TEST_ASSERT_NULL( other );
+
+    /* Full Gromer and arena. */
+    while ( gr_shm_used( shm ) < 100 )
+        gr_shm_push( shm, (gr_d)1 );
+    TEST_ASSERT_EQUAL( -1, gr_shm_push( shm, (gr_d)1 ) );
+    TEST_ASSERT_EQUAL( 0, gr_shm_alloc( shm, 1 << 20 ) );
+
+    /* Lock is recovered when owner dies. */
+    pid = fork();
+    if ( pid == 0 ) {
+        gr_shm_lock( shm );
+        _exit( 0 );
+    }
+    waitpid( pid, &status, 0 );
+    TEST_ASSERT_EQUAL( (gr_d)1, gr_shm_pop( shm ) );
+    TEST_ASSERT_EQUAL( 99, gr_shm_used( shm ) );
+
+    gr_shm_close( &shm );
+    TEST_ASSERT_EQUAL( 0, gr_shm_unlink( name ) );
+
+    /* New segment after unlink. */
+    shm = gr_shm_open( name, 0, 0 );
+    TEST_ASSERT_NOT_NULL( shm );
+    TEST_ASSERT_EQUAL( 0, gr_shm_used( shm ) );
+    gr_shm_close( &shm );
+    gr_shm_unlink( name );
+}
+
+
+void test_shm_procs( void )
+{
+    gr_shm_t   shm;
+    gr_size_t  cnt_off;
+    uint64_t*  cnt;
+    char       name[ 64 ];
+    pid_t      pid[ 6 ];
+    int        status;
+    const int  producers = 4;
+    const int  consumers = 2;
+    const int  per = 5000;
+    const int  total = producers * per;
+
+    snprintf( name, sizeof( name ), "/gromer_shm_procs_%d", (int)getpid() );
+    gr_shm_unlink( name );
+
+    /* Small Gromer, hence producers see it full. */
+    shm = gr_shm_open( name, 256, ( total + 2 ) * sizeof( uint64_t ) );
+    TEST_ASSERT_NOT_NULL( shm );
+
+    /* Consumed count and sum. */
+    cnt_off = gr_shm_alloc( shm, 2 * sizeof( uint64_t ) );
+    cnt = gr_shm_ptr( shm, cnt_off );
+
+    for ( int p = 0; p < producers + consumers; p++ ) {
+        pid[ p ] = fork();
+        if ( pid[ p ] != 0 )
+            continue;
+
+        /* Child attaches by name. */
+        gr_shm_t  own = gr_shm_open( name, 0, 0 );
+        uint64_t* own_cnt = gr_shm_ptr( own, cnt_off );
+        gr_size_t off;
+        gr_d      item;
+
+        if ( p < producers ) {
+            for ( int i = 1; i <= per; i++ ) {
+                off = gr_shm_alloc( own, sizeof( uint64_t ) );
+                *(uint64_t*)gr_shm_ptr( own, off ) = p * per + i;
+                while ( gr_shm_push( own, (gr_d)off ) != 0 )
+                    sched_yield();
+            }
+        } else {
+            while ( __atomic_load_n( &own_cnt[ 0 ], __ATOMIC_RELAXED ) < (uint64_t)total ) {
+                item = gr_shm_pop( own );
+                if ( item == NULL ) {
+                    sched_yield();
+                    continue;
+                }
+                __atomic_add_fetch( &own_cnt[ 1 ],
+                                    *(uint64_t*)gr_shm_ptr( own, (gr_size_t)item ),
+                                    __ATOMIC_RELAXED );
+                __atomic_add_fetch( &own_cnt[ 0 ], 1, __ATOMIC_RELAXED );
+            }
+        }
+
+        gr_shm_close( &own );
+        _exit( 0 );
+    }
+
+    for ( int p = 0; p < producers + consumers; p++ ) {
+        waitpid( pid[ p ], &status, 0 );
+        TEST_ASSERT_TRUE( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+    }
+
+    TEST_ASSERT_EQUAL( total, cnt[ 0 ] );
+    TEST_ASSERT_EQUAL( (uint64_t)total * ( total + 1 ) / 2, cnt[ 1 ] );
+    TEST_ASSERT_EQUAL( 0, gr_shm_used( shm ) );
+
+    gr_shm_close( &shm );
+    gr_shm_unlink( name );
+}
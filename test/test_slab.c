@@ -0,0 +1,126 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_slab.h"
+#include <pthread.h>
+#include <string.h>
+
+
+static int slab_compare( const gr_d a, const gr_d b )
+{
+    uintptr_t ia = *( (uintptr_t*)a );
+    uintptr_t ib = *( (uintptr_t*)b );
+    return ( ia > ib ) - ( ia < ib );
+}
+
+
+void test_slab_basics( void )
+{
+    ga_t ga;
+    gr_t objs;
+    gr_d obj;
+
+    ga = ga_new( 20 );
+    TEST_ASSERT_EQUAL( 24, ga_size( ga ) );
+    TEST_ASSERT_EQUAL( 0, ga_blocks( ga ) );
+
+    objs = gr_new();
+    for ( int i = 0; i < 10000; i++ ) {
+        obj = ga_get( ga );
+        TEST_ASSERT_EQUAL( 0, (uintptr_t)obj % sizeof( gr_d ) );
+        memset( obj, 0xA5, 24 );
+        gr_push( &objs, obj );
+    }
+    TEST_ASSERT_EQUAL( 10000, ga_live( ga ) );
+    TEST_ASSERT_TRUE( ga_blocks( ga ) > 1 );
+
+    /* Objects do not overlap. */
+    gr_sort( &objs, slab_compare );
+    for ( gr_size_t i = 1; i < gr_used( objs ); i++ )
+        TEST_ASSERT_TRUE( (uint8_t*)gr_nth( objs, i ) - (uint8_t*)gr_nth( objs, i - 1 ) >= 24 );
+
+    /* Released objects are reused first (LIFO). */
+    obj = gr_nth( objs, 500 );
+    ga_put( ga, obj );
+    TEST_ASSERT_EQUAL( 9999, ga_live( ga ) );
+    TEST_ASSERT_EQUAL_PTR( obj, ga_get( ga ) );
+
+    /* Reset reuses blocks. */
+    gr_size_t blocks = ga_blocks( ga );
+    ga_reset( ga );
+    TEST_ASSERT_EQUAL( 0, ga_live( ga ) );
+    obj = ga_get( ga );
+    TEST_ASSERT_EQUAL_PTR( gr_first( objs ), obj );
+    for ( int i = 0; i < 10000; i++ )
+        ga_get( ga );
+    TEST_ASSERT_EQUAL( blocks, ga_blocks( ga ) );
+
+    gr_destroy( &objs );
+    ga_destroy( &ga );
+    TEST_ASSERT_NULL( ga );
+
+    /* Object larger than default block. */
+    ga = ga_new( GA_BLOCK_PAGES * 4096 * 2 );
+    obj = ga_get( ga );
+    memset( obj, 0, ga_size( ga ) );
+    ga_put( ga, obj );
+    TEST_ASSERT_EQUAL_PTR( obj, ga_get( ga ) );
+    ga_destroy( &ga );
+}
+
+
+static void* slab_worker( void* arg )
+{
+    ga_cache_t cache;
+    gr_d       held[ 100 ];
+
+    cache = ga_cache_new( (ga_t)arg );
+    for ( int round = 0; round < 200; round++ ) {
+        for ( int i = 0; i < 100; i++ ) {
+            held[ i ] = ga_cache_get( cache );
+            *(uintptr_t*)held[ i ] = (uintptr_t)&held[ i ];
+        }
+        for ( int i = 0; i < 100; i++ ) {
+            if ( *(uintptr_t*)held[ i ] != (uintptr_t)&held[ i ] )
+                return NULL;
+            ga_cache_put( cache, held[ i ] );
+        }
+    }
+    ga_cache_destroy( &cache );
+
+    return arg;
+}
+
+
+void test_slab_cache( void )
+{
+    ga_t       ga;
+    ga_cache_t cache;
+    pthread_t  th[ 4 ];
+    void*      ret;
+    gr_d       obj;
+
+    ga = ga_new( sizeof( uintptr_t ) );
+
+    cache = ga_cache_new( ga );
+    obj = ga_cache_get( cache );
+    TEST_ASSERT_EQUAL( GA_CACHE_BATCH, ga_live( ga ) );
+    ga_cache_put( cache, obj );
+    TEST_ASSERT_EQUAL_PTR( obj, ga_cache_get( cache ) );
+    ga_cache_put( cache, obj );
+    ga_cache_clear( cache );
+    TEST_ASSERT_EQUAL( 0, ga_live( ga ) );
+
+    for ( int i = 0; i < 4; i++ )
+        pthread_create( &th[ i ], NULL, slab_worker, ga );
+    for ( int i = 0; i < 4; i++ ) {
+        pthread_join( th[ i ], &ret );
+        TEST_ASSERT_EQUAL_PTR( ga, ret );
+    }
+    TEST_ASSERT_EQUAL( 0, ga_live( ga ) );
+
+    /* Objects were recycled, not carved per use. */
+    TEST_ASSERT_EQUAL( 1, ga_blocks( ga ) );
+
+    ga_cache_destroy( &cache );
+    ga_destroy( &ga );
+}
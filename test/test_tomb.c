@@ -0,0 +1,104 @@
+#include "unity.h"
+#include "gromer.h"
+#include "gromer_tomb.h"
+
+
+static int gt_compare_fn( const gr_d a, const gr_d b )
+{
+    return a == b;
+}
+
+
+void test_tomb_basics( void )
+{
+    gt_t      gt;
+    gr_d      item;
+    gr_size_t cnt;
+
+    gt = gt_new();
+    gt_set_limit( gt, 0 );
+
+    for ( uintptr_t i = 0; i < 200; i++ )
+        gt_push( gt, (gr_d)i );
+
+    /* Delete every third item. */
+    for ( uintptr_t i = 0; i < 200; i += 3 ) {
+        TEST_ASSERT_EQUAL( i, (uintptr_t)gt_delete_at( gt, i ) );
+    }
+    TEST_ASSERT_NULL( gt_delete_at( gt, 3 ) );
+    TEST_ASSERT_EQUAL( 67, gt_dead( gt ) );
+    TEST_ASSERT_EQUAL( 133, gt_used( gt ) );
+    TEST_ASSERT_TRUE( gt_is_dead( gt, 6 ) );
+    TEST_ASSERT_FALSE( gt_is_dead( gt, 7 ) );
+
+    cnt = 0;
+    gt_each( gt, item, gr_d )
+    {
+        TEST_ASSERT_TRUE( ( (uintptr_t)item % 3 ) != 0 );
+        TEST_ASSERT_EQUAL( (uintptr_t)item, gr_idx );
+        cnt++;
+    }
+    TEST_ASSERT_EQUAL( 133, cnt );
+
+    TEST_ASSERT_EQUAL( 1, (uintptr_t)gt_nth( gt, 0 ) );
+    TEST_ASSERT_EQUAL( 2, (uintptr_t)gt_nth( gt, 1 ) );
+    TEST_ASSERT_EQUAL( 4, (uintptr_t)gt_nth( gt, 2 ) );
+    TEST_ASSERT_EQUAL( 199, (uintptr_t)gt_nth( gt, -1 ) );
+    TEST_ASSERT_EQUAL( 131, (uintptr_t)gt_nth( gt, 87 ) );
+
+    TEST_ASSERT_EQUAL( 87, gt_live_pos( gt, 131 ) );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, gt_live_pos( gt, 132 ) );
+
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, gt_find( gt, (gr_d)66 ) );
+    TEST_ASSERT_EQUAL( 67, gt_find( gt, (gr_d)67 ) );
+    TEST_ASSERT_EQUAL( 68, gt_find_with( gt, gt_compare_fn, (gr_d)68 ) );
+    TEST_ASSERT_EQUAL( GR_NOT_INDEX, gt_find_with( gt, gt_compare_fn, (gr_d)69 ) );
+
+    gt_compact( gt );
+    TEST_ASSERT_EQUAL( 0, gt_dead( gt ) );
+    TEST_ASSERT_EQUAL( 133, gr_used( gt_gromer( gt ) ) );
+    TEST_ASSERT_EQUAL( 131, (uintptr_t)gt_nth( gt, 87 ) );
+    TEST_ASSERT_EQUAL( 87, gt_find( gt, (gr_d)131 ) );
+
+    gt_destroy( &gt );
+    TEST_ASSERT_NULL( gt );
+}
+
+
+void test_tomb_auto( void )
+{
+    gt_t gt;
+
+    gt = gt_new_sized( 8 );
+
+    for ( uintptr_t i = 1; i <= 100; i++ )
+        gt_push( gt, (gr_d)i );
+
+    /* 25% limit triggers compaction. */
+    for ( int i = 0; i < 24; i++ )
+        gt_delete_at( gt, i );
+    TEST_ASSERT_EQUAL( 24, gt_dead( gt ) );
+    gt_delete_at( gt, 24 );
+    TEST_ASSERT_EQUAL( 0, gt_dead( gt ) );
+    TEST_ASSERT_EQUAL( 75, gt_used( gt ) );
+    TEST_ASSERT_EQUAL( 26, (uintptr_t)gt_nth( gt, 0 ) );
+
+    /* Pop skips dead tail. */
+    gt_delete_at( gt, 73 );
+    TEST_ASSERT_EQUAL( 100, (uintptr_t)gt_pop( gt ) );
+    TEST_ASSERT_EQUAL( 98, (uintptr_t)gt_pop( gt ) );
+    TEST_ASSERT_EQUAL( 0, gt_dead( gt ) );
+    TEST_ASSERT_EQUAL( 72, gt_used( gt ) );
+
+    /* Deleting last item does not mark. */
+    TEST_ASSERT_EQUAL( 97, (uintptr_t)gt_delete_at( gt, 71 ) );
+    TEST_ASSERT_EQUAL( 0, gt_dead( gt ) );
+
+    while ( gt_used( gt ) > 0 )
+        gt_pop( gt );
+    TEST_ASSERT_NULL( gt_pop( gt ) );
+    TEST_ASSERT_NULL( gt_nth( gt, 0 ) );
+
+    gt_destroy( &gt );
+    gt_destroy( &gt );
+}